@@ -0,0 +1,678 @@
+/***********************************************************
+*  batch.c                                                 *
+*                                                          *
+*  Recordings through engine.c on every core, results in   *
+*  ping order                                              *
+*                                                          *
+************************************************************/
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "batch.h"
+#include "capture.h"
+
+#define BATCH_HISTORY (INTEGRATE_MAX-1)		// pings an integrating task may need before its first one
+
+typedef struct {
+	unsigned char *data;				// history records, then the bytes read
+	size_t used;
+	int file;
+	long first;							// record index in the file of record hist
+	long hist;							// records copied from the previous block (ENGINE_INTEGRATE)
+	long count;							// records, history included
+	long cap;							// of offset / res / has
+	size_t *offset;
+	engine_result_t *res;
+	char *has;							// res holds a result
+	long pending;						// tasks not done (batch lock)
+	int held;							// the reader still copies history / a cut record from it
+} batch_block_t;
+
+typedef struct {
+	batch_block_t *block;
+	long from;							// first record to process (integration), output from lo
+	long lo, hi;
+} batch_task_t;
+
+typedef struct {
+	pthread_mutex_t lock;
+	batch_task_t *task;					// ring of cap tasks
+	long cap;
+	long head;							// oldest: taken by the owner
+	long tail;							// behind the newest: dealt here, stolen from here
+} batch_deque_t;
+
+typedef struct batch batch_t;
+
+typedef struct {
+	batch_t *b;
+	int id;
+	int ok;								// engine allocated
+	pthread_t thread;
+	batch_deque_t dq;
+	engine_t e;
+	short *capture;
+	long pings, skipped, results, warmup, tasks, steals;
+	char pad[64];						// no false sharing of the counters
+} batch_worker_t;
+
+struct batch {
+	const engine_t *setup;
+	engine_cfg_t cfg;
+	short k;							// ENGINE_INTEGRATE: pings per sum, 0 otherwise
+	int threads;
+	batch_worker_t *w;
+	pthread_mutex_t lock;				// queued, started, pending, stop
+	pthread_cond_t work;				// tasks dealt, stop
+	pthread_cond_t done;				// a block finished, a worker started
+	long queued;						// tasks in all deques
+	int started;
+	int stop;
+};
+
+
+static double batch_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+
+static void *batch_alloc(size_t bytes)		// cache line aligned
+{
+	void *p;
+
+	return posix_memalign(&p, 64, bytes) == 0 ? p : NULL;
+}
+
+
+/*---------------- deque ----------------*/
+
+static int deque_push(batch_deque_t *dq, const batch_task_t *t)
+{
+	batch_task_t *grown;
+	long i, n;
+
+	pthread_mutex_lock(&dq->lock);
+	n = dq->tail - dq->head;
+	if(n == dq->cap)
+	{
+		grown = malloc(sizeof(batch_task_t)*(dq->cap ? 2*dq->cap : 64));
+		if(grown == NULL)
+		{
+			pthread_mutex_unlock(&dq->lock);
+			return -1;
+		}
+		for(i=0;i<n;i++)
+		{
+			grown[i] = dq->task[(dq->head + i) % dq->cap];
+		}
+		free(dq->task);
+		dq->task = grown;
+		dq->cap = dq->cap ? 2*dq->cap : 64;
+		dq->head = 0;
+		dq->tail = n;
+	}
+	dq->task[dq->tail % dq->cap] = *t;
+	dq->tail++;
+	pthread_mutex_unlock(&dq->lock);
+	return 0;
+}
+
+
+static int deque_take(batch_deque_t *dq, batch_task_t *t, int steal)	// owner: oldest, thief: newest
+{
+	int ok;
+
+	pthread_mutex_lock(&dq->lock);
+	ok = dq->head != dq->tail;
+	if(ok && steal)
+	{
+		dq->tail--;
+		*t = dq->task[dq->tail % dq->cap];
+	}
+	else if(ok)
+	{
+		*t = dq->task[dq->head % dq->cap];
+		dq->head++;
+	}
+	pthread_mutex_unlock(&dq->lock);
+	return ok;
+}
+
+
+/*---------------- workers ----------------*/
+
+static int batch_engine(engine_t *e, const engine_t *setup)	// own copy of every buffer of engine.c
+{
+	*e = *setup;							// sweeps and settings
+	e->tpl = batch_alloc(sizeof(mf_template_t)*WAVEFORMS);
+	e->stereo = batch_alloc(sizeof(mf_stereo_t)*WAVEFORMS);
+	e->pairs = batch_alloc(sizeof(xcorr_i16_t));
+	e->coarse = batch_alloc(sizeof(coarse_t));
+	e->integrator = batch_alloc(sizeof(integrate_t));
+	e->work = batch_alloc(sizeof(float)*CORR_WORK_LEN);
+	e->work_stereo = batch_alloc(sizeof(float)*STEREO_WORK_LEN);
+	e->twiddle = batch_alloc(sizeof(float)*FFT_TWIDDLE(FFT_N/2));
+	e->stage_end = NULL;
+	if(!e->tpl || !e->stereo || !e->pairs || !e->coarse || !e->integrator || !e->work || !e->work_stereo || !e->twiddle)
+	{
+		return -1;
+	}
+	return engine_init(e) ? 0 : -1;
+}
+
+
+static void batch_engine_free(engine_t *e)
+{
+	free(e->tpl);
+	free(e->stereo);
+	free(e->pairs);
+	free(e->coarse);
+	free(e->integrator);
+	free(e->work);
+	free(e->work_stereo);
+	free(e->twiddle);
+}
+
+
+static void batch_task(batch_worker_t *w, const batch_task_t *t)
+{
+	batch_t *b = w->b;
+	batch_block_t *blk = t->block;
+	const capture_rec_t *rec;
+	engine_result_t res;
+	long j;
+	short r;
+
+	if(b->k > 0)
+	{
+		integrate_init(w->e.integrator, b->k, b->cfg.integrate_mode);	// the sums of this task only
+	}
+	for(j=t->from;j<t->hi;j++)
+	{
+		rec = (const capture_rec_t *)(blk->data + blk->offset[j]);
+		if(!capture_rec_fits(rec) || rec->sweep_id >= WAVEFORMS)
+		{
+			w->skipped += j >= t->lo;
+			continue;
+		}
+		capture_rec_unpack((const short *)((const unsigned char *)rec + rec->header), w->capture);
+		if(j < t->lo)
+		{
+			engine_ping(&w->e, &b->cfg, w->capture, rec->sweep_id, &res);	// integration only, the output is another task's
+			w->warmup++;
+			continue;
+		}
+		r = engine_ping(&w->e, &b->cfg, w->capture, rec->sweep_id, &blk->res[j]);
+		blk->has[j] = r;
+		w->results += r;
+		w->pings++;
+	}
+}
+
+
+static int batch_take(batch_worker_t *w, batch_task_t *t)
+{
+	batch_t *b = w->b;
+	int i, ok;
+
+	ok = deque_take(&w->dq, t, 0);
+	for(i=1;!ok && i<b->threads;i++)
+	{
+		ok = deque_take(&b->w[(w->id + i) % b->threads].dq, t, 1);
+		w->steals += ok;
+	}
+	if(ok)
+	{
+		pthread_mutex_lock(&b->lock);
+		b->queued--;
+		pthread_mutex_unlock(&b->lock);
+	}
+	return ok;
+}
+
+
+static void *batch_worker(void *arg)
+{
+	batch_worker_t *w = arg;
+	batch_t *b = w->b;
+	batch_task_t t;
+
+	w->ok = batch_engine(&w->e, b->setup) == 0;	// allocated and written here: memory of this core
+	w->capture = batch_alloc(sizeof(short)*CAPTURE_LEN);
+	w->ok = w->ok && w->capture != NULL;
+	pthread_mutex_lock(&b->lock);
+	b->started++;
+	pthread_cond_broadcast(&b->done);
+	pthread_mutex_unlock(&b->lock);
+	if(!w->ok)
+	{
+		return NULL;
+	}
+
+	while(1)
+	{
+		if(batch_take(w, &t))
+		{
+			batch_task(w, &t);
+			w->tasks++;
+			pthread_mutex_lock(&b->lock);
+			if(--t.block->pending == 0)
+			{
+				pthread_cond_broadcast(&b->done);
+			}
+			pthread_mutex_unlock(&b->lock);
+			continue;
+		}
+		pthread_mutex_lock(&b->lock);
+		while(b->queued == 0 && !b->stop)
+		{
+			pthread_cond_wait(&b->work, &b->lock);
+		}
+		if(b->queued == 0)
+		{
+			pthread_mutex_unlock(&b->lock);
+			return NULL;						// stop and nothing left
+		}
+		pthread_mutex_unlock(&b->lock);
+	}
+}
+
+
+/*---------------- reader ----------------*/
+
+typedef struct {
+	batch_block_t *block;				// all of them
+	int blocks;
+	size_t size;						// bytes read per block
+	size_t room;						// bytes of history in front
+	batch_block_t **fifo;				// in flight, oldest first (ring of blocks)
+	int head, count;
+	int deal;							// worker of the next task
+} batch_pool_t;
+
+
+static int block_records(batch_block_t *blk, long n)	// room for n records
+{
+	size_t *offset;
+	engine_result_t *res;
+	char *has;
+
+	if(n <= blk->cap)
+	{
+		return 0;
+	}
+	n = n > 2*blk->cap ? n : 2*blk->cap;
+	offset = realloc(blk->offset, sizeof(size_t)*n);
+	blk->offset = offset ? offset : blk->offset;
+	res = realloc(blk->res, sizeof(engine_result_t)*n);
+	blk->res = res ? res : blk->res;
+	has = realloc(blk->has, n);
+	blk->has = has ? has : blk->has;
+	if(!offset || !res || !has)
+	{
+		return -1;
+	}
+	blk->cap = n;
+	return 0;
+}
+
+
+/* results of the finished blocks at the front to the sink, wait: until the oldest is finished */
+static void batch_emit(batch_t *b, batch_pool_t *pool, int wait, batch_sink_t sink, void *ctx)
+{
+	batch_block_t *blk;
+	long j;
+	int ready;
+
+	while(pool->count > 0)
+	{
+		blk = pool->fifo[pool->head];
+		pthread_mutex_lock(&b->lock);
+		while(wait && blk->pending > 0)
+		{
+			pthread_cond_wait(&b->done, &b->lock);
+		}
+		ready = blk->pending == 0 && !blk->held;
+		pthread_mutex_unlock(&b->lock);
+		if(!ready)
+		{
+			return;
+		}
+		for(j=blk->hist;j<blk->count && sink;j++)
+		{
+			if(blk->has[j])
+			{
+				sink(ctx, blk->file, blk->first + j - blk->hist, (const capture_rec_t *)(blk->data + blk->offset[j]), &blk->res[j]);
+			}
+		}
+		blk->used = 0;							// free again
+		pool->head = (pool->head + 1) % pool->blocks;
+		pool->count--;
+	}
+}
+
+
+static batch_block_t *batch_free_block(batch_t *b, batch_pool_t *pool, batch_sink_t sink, void *ctx)
+{
+	int i, j;
+
+	while(1)
+	{
+		for(i=0;i<pool->blocks;i++)
+		{
+			for(j=0;j<pool->count && pool->fifo[(pool->head + j) % pool->blocks] != &pool->block[i];j++)
+			{
+			}
+			if(j == pool->count)
+			{
+				return &pool->block[i];			// not in flight
+			}
+		}
+		batch_emit(b, pool, 1, sink, ctx);		// all in flight: the oldest has to finish first
+	}
+}
+
+
+/* copies the last records of prev (integration history) and its cut off record into blk */
+static void batch_carry(const batch_t *b, const batch_pool_t *pool, const batch_block_t *prev, size_t carry,
+                        batch_block_t *blk)
+{
+	size_t pos = 0, size;
+	long j, n;
+
+	blk->hist = 0;
+	blk->count = 0;
+	if(prev && b->k > 0)
+	{
+		for(n=0;n<BATCH_HISTORY && n<prev->count;n++)
+		{
+			size = capture_rec_size((const capture_rec_t *)(prev->data + prev->offset[prev->count-1-n]));
+			if(pos + size > pool->room)
+			{
+				break;
+			}
+			pos += size;
+		}
+		pos = 0;
+		for(j=prev->count-n;j<prev->count;j++)
+		{
+			size = capture_rec_size((const capture_rec_t *)(prev->data + prev->offset[j]));
+			memcpy(blk->data + pos, prev->data + prev->offset[j], size);
+			blk->offset[blk->count++] = pos;
+			pos += size;
+		}
+		blk->hist = n;
+	}
+	if(prev && carry > 0)
+	{
+		memcpy(blk->data + pos, prev->data + prev->used - carry, carry);
+	}
+	blk->used = pos + carry;
+}
+
+
+/* tasks of the records hist..count-1 of blk, cut at multiples of chunk of the record index in the file */
+static int batch_deal(batch_t *b, batch_pool_t *pool, batch_block_t *blk, long chunk)
+{
+	batch_task_t t;
+	long g;
+
+	t.block = blk;
+	pthread_mutex_lock(&b->lock);
+	blk->pending = 1;							// not finished while the tasks are dealt
+	pthread_mutex_unlock(&b->lock);
+	for(t.lo=blk->hist;t.lo<blk->count;t.lo=t.hi)
+	{
+		g = blk->first + t.lo - blk->hist;
+		t.hi = t.lo + chunk - g % chunk;
+		t.hi = t.hi < blk->count ? t.hi : blk->count;
+		t.from = t.lo;
+		if(b->k > 0)
+		{
+			t.from = b->cfg.integrate_mode == INTEGRATE_SLIDING ? t.lo - (b->k - 1) : t.lo - g % b->k;
+			t.from = t.from > 0 ? t.from : 0;	// start of the file (or history cut short)
+		}
+		if(deque_push(&b->w[pool->deal].dq, &t) != 0)
+		{
+			break;
+		}
+		pool->deal = (pool->deal + 1) % b->threads;
+		pthread_mutex_lock(&b->lock);
+		blk->pending++;							// may finish before: the 1 above keeps it from 0
+		b->queued++;
+		pthread_cond_signal(&b->work);
+		pthread_mutex_unlock(&b->lock);
+	}
+	pthread_mutex_lock(&b->lock);
+	blk->pending--;
+	pthread_mutex_unlock(&b->lock);
+	return t.lo < blk->count ? -1 : 0;			// no memory for a task
+}
+
+
+/* one file front to back, blocks dealt as soon as they are read */
+static int batch_file(batch_t *b, batch_pool_t *pool, long chunk, int file, const char *path,
+                      batch_sink_t sink, void *ctx, batch_stat_t *st)
+{
+	batch_block_t *blk, *prev = NULL;
+	const capture_rec_t *rec;
+	size_t pos, size, carry = 0, end;
+	ssize_t n;
+	long first = 0;
+	double t;
+	int fd, eof = 0, bad = 0;
+
+	fd = open(path, O_RDONLY);
+	if(fd < 0)
+	{
+		return -1;
+	}
+	posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);	// large read ahead
+	while(!eof && !bad)
+	{
+		blk = batch_free_block(b, pool, sink, ctx);
+		blk->file = file;
+		blk->first = first;
+		if(block_records(blk, BATCH_HISTORY) != 0)
+		{
+			bad = -1;
+			break;
+		}
+		batch_carry(b, pool, prev, carry, blk);
+		if(prev)
+		{
+			pthread_mutex_lock(&b->lock);
+			prev->held = 0;						// copied: may be emitted
+			pthread_mutex_unlock(&b->lock);
+		}
+
+		/* read up to the end of the block */
+		t = batch_now();
+		end = pool->room + pool->size;
+		while(blk->used < end)
+		{
+			n = read(fd, blk->data + blk->used, end - blk->used);
+			if(n <= 0)
+			{
+				eof = 1;
+				break;
+			}
+			blk->used += n;
+			st->bytes += n;
+		}
+		st->read_seconds += batch_now() - t;
+
+		/* complete records behind the history (and the cut record carried over) */
+		pos = blk->count > 0 ? blk->offset[blk->count-1] + capture_rec_size((const capture_rec_t *)(blk->data + blk->offset[blk->count-1])) : 0;
+		carry = 0;
+		while(pos + CAPTURE_REC_HEADER <= blk->used)
+		{
+			rec = (const capture_rec_t *)(blk->data + pos);
+			size = capture_rec_size(rec);
+			if(size == 0 || size > pool->size)
+			{
+				bad = 1;						// not a record (or larger than a block): end of the usable file
+				break;
+			}
+			if(pos + size > blk->used)
+			{
+				break;
+			}
+			if(block_records(blk, blk->count + 1) != 0)
+			{
+				bad = -1;
+				break;
+			}
+			blk->offset[blk->count++] = pos;
+			pos += size;
+		}
+		carry = blk->used - pos;
+		if(eof || bad)
+		{
+			st->tail += carry;					// cut off at the end of the file / not a record
+			carry = 0;
+		}
+		memset(blk->has, 0, blk->count);
+		first += blk->count - blk->hist;
+
+		pool->fifo[(pool->head + pool->count) % pool->blocks] = blk;
+		pool->count++;
+		blk->held = 1;
+		if(batch_deal(b, pool, blk, chunk) != 0)
+		{
+			bad = -1;
+		}
+		prev = blk;
+		batch_emit(b, pool, 0, sink, ctx);
+	}
+	if(prev)
+	{
+		pthread_mutex_lock(&b->lock);
+		prev->held = 0;
+		pthread_mutex_unlock(&b->lock);
+	}
+	close(fd);
+	return bad < 0 ? -1 : 0;
+}
+
+
+int batch_run(const batch_cfg_t *bc, const char *const *paths, int files, batch_sink_t sink, void *ctx, batch_stat_t *st)
+{
+	batch_t b;
+	batch_pool_t pool;
+	long chunk;
+	double t0;
+	int i, ok = 1, f;
+
+	memset(st, 0, sizeof(*st));
+	memset(&b, 0, sizeof(b));
+	memset(&pool, 0, sizeof(pool));
+	t0 = batch_now();
+
+	b.cfg = bc->cfg;
+	b.threads = bc->threads > 0 ? bc->threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+	b.threads = b.threads > 0 ? b.threads : 1;
+	if(b.cfg.engine == ENGINE_INTEGRATE)
+	{
+		b.k = b.cfg.integrate_k < 1 ? 1 : b.cfg.integrate_k > INTEGRATE_MAX ? INTEGRATE_MAX : b.cfg.integrate_k;
+		b.cfg.integrate_k = b.k;
+	}
+	chunk = bc->chunk > 0 ? bc->chunk : BATCH_CHUNK;
+	if(b.k > 0 && b.cfg.integrate_mode == INTEGRATE_BLOCK)
+	{
+		chunk = (chunk + b.k - 1)/b.k*b.k;		// whole sums: no pings twice
+	}
+
+	/* blocks: history room + the bytes of one read */
+	pool.size = bc->block > 0 ? bc->block : BATCH_BLOCK;
+	pool.size = pool.size > 2*CAPTURE_REC_BYTES ? pool.size : 2*CAPTURE_REC_BYTES;
+	pool.room = b.k > 0 ? BATCH_HISTORY*CAPTURE_REC_BYTES : 0;
+	pool.blocks = bc->blocks > 0 ? bc->blocks : 4 + b.threads/4;
+	pool.blocks = pool.blocks > 2 ? pool.blocks : 2;	// one is held while the next is read
+	pool.block = calloc(pool.blocks, sizeof(batch_block_t));
+	pool.fifo = calloc(pool.blocks, sizeof(batch_block_t *));
+	ok = pool.block && pool.fifo;
+	for(i=0;ok && i<pool.blocks;i++)
+	{
+		pool.block[i].data = batch_alloc(pool.room + pool.size);
+		ok = pool.block[i].data != NULL;
+	}
+
+	/* workers, each builds its own engine */
+	pthread_mutex_init(&b.lock, NULL);
+	pthread_cond_init(&b.work, NULL);
+	pthread_cond_init(&b.done, NULL);
+	b.setup = bc->setup;
+	b.w = ok ? calloc(b.threads, sizeof(batch_worker_t)) : NULL;
+	ok = b.w != NULL;
+	b.threads = ok ? b.threads : 0;
+	for(i=0;ok && i<b.threads;i++)
+	{
+		b.w[i].b = &b;
+		b.w[i].id = i;
+		pthread_mutex_init(&b.w[i].dq.lock, NULL);
+		if(pthread_create(&b.w[i].thread, NULL, batch_worker, &b.w[i]) != 0)
+		{
+			b.threads = i;
+			ok = 0;
+		}
+	}
+	pthread_mutex_lock(&b.lock);
+	while(b.started < b.threads)
+	{
+		pthread_cond_wait(&b.done, &b.lock);
+	}
+	pthread_mutex_unlock(&b.lock);
+	for(i=0;i<b.threads;i++)
+	{
+		ok = ok && b.w[i].ok;
+	}
+
+	for(f=0;ok && f<files;f++)
+	{
+		ok = batch_file(&b, &pool, chunk, f, paths[f], sink, ctx, st) == 0;
+	}
+	batch_emit(&b, &pool, 1, sink, ctx);
+
+	pthread_mutex_lock(&b.lock);
+	b.stop = 1;
+	pthread_cond_broadcast(&b.work);
+	pthread_mutex_unlock(&b.lock);
+	for(i=0;i<b.threads;i++)
+	{
+		pthread_join(b.w[i].thread, NULL);
+		st->pings += b.w[i].pings;
+		st->skipped += b.w[i].skipped;
+		st->results += b.w[i].results;
+		st->warmup += b.w[i].warmup;
+		st->tasks += b.w[i].tasks;
+		st->steals += b.w[i].steals;
+		batch_engine_free(&b.w[i].e);
+		free(b.w[i].capture);
+		free(b.w[i].dq.task);
+		pthread_mutex_destroy(&b.w[i].dq.lock);
+	}
+	st->threads = b.threads;
+	for(i=0;pool.block && i<pool.blocks;i++)
+	{
+		free(pool.block[i].data);
+		free(pool.block[i].offset);
+		free(pool.block[i].res);
+		free(pool.block[i].has);
+	}
+	free(pool.block);
+	free(pool.fifo);
+	free(b.w);
+	pthread_mutex_destroy(&b.lock);
+	pthread_cond_destroy(&b.work);
+	pthread_cond_destroy(&b.done);
+	st->seconds = batch_now() - t0;
+	return ok ? 0 : -1;
+}
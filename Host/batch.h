@@ -0,0 +1,75 @@
+/***********************************************************
+*  batch.h                                                 *
+*                                                          *
+*  Reprocessing of recordings (capture_rec.h) on every     *
+*  core of the host: the same engine_ping as capture_      *
+*  replay, the results handed out in ping order.           *
+*                                                          *
+*  The calling thread reads the files front to back in     *
+*  blocks of block bytes (plain read(), one system call    *
+*  per block), cuts each block into tasks of chunk pings   *
+*  and deals them out to the workers' deques. A worker     *
+*  takes its own tasks oldest first and, once they are     *
+*  gone, steals the newest task of another worker (work    *
+*  stealing: no central queue, one lock per deque). When   *
+*  the oldest block in flight is done, the calling thread  *
+*  passes its results to the sink and reuses the buffer    *
+*  => memory bounded by blocks x block bytes.              *
+*                                                          *
+*  Every worker owns a whole engine_t (templates with      *
+*  their FFT plans, its own twiddle table, correlation     *
+*  and integration buffers), allocated and initialised by  *
+*  the worker itself (first touch: its own NUMA node).     *
+*  Nothing is shared between them but the sweeps, read     *
+*  only; PROFILE builds share prof_stat (run 1 thread).    *
+*                                                          *
+*  ENGINE_INTEGRATE sums consecutive pings: a task first   *
+*  runs the pings its sums need before it (up to k-1,      *
+*  copied from the previous block) without output, so the  *
+*  results equal those of capture_replay. The integration  *
+*  restarts at the start of each file. Sums are aligned    *
+*  on the record index in the file (capture_replay: on     *
+*  the processed pings, the same unless records are        *
+*  skipped).                                               *
+*                                                          *
+************************************************************/
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include <stddef.h>
+#include "capture_rec.h"
+#include "engine.h"
+
+#define BATCH_CHUNK 32					// pings per task
+#define BATCH_BLOCK (8 << 20)			// bytes per read
+
+typedef struct {
+	int threads;						// workers, 0 = one per online CPU
+	long chunk;							// pings per task, 0 = BATCH_CHUNK (ENGINE_INTEGRATE block: rounded up to k)
+	size_t block;						// bytes per read, 0 = BATCH_BLOCK (2 records at least)
+	int blocks;							// buffers in flight, 0 = 4 + threads/4
+	const engine_t *setup;				// sweeps and settings (coarse_decim, auto_lags, cfar), buffers unused
+	engine_cfg_t cfg;
+} batch_cfg_t;
+
+/* results in ping order: file index in paths, record index in that file */
+typedef void (*batch_sink_t)(void *ctx, int file, long i, const capture_rec_t *rec, const engine_result_t *res);
+
+typedef struct {
+	long pings;							// records processed
+	long skipped;						// records of another sample rate / length (capture_rec_fits)
+	long results;						// engine_ping returned a result
+	long warmup;						// extra engine_ping of the integration before a task
+	long tasks;
+	long steals;						// tasks run by another worker than the one they were dealt to
+	int threads;
+	double bytes;						// read
+	double tail;						// bytes behind the last complete record of the files
+	double seconds;						// wall clock
+	double read_seconds;				// of it in read()
+} batch_stat_t;
+
+/* all files in the order given, 0 = ok, -1 = a file could not be read or no memory (st up to there) */
+int batch_run(const batch_cfg_t *bc, const char *const *paths, int files, batch_sink_t sink, void *ctx, batch_stat_t *st);
+
+#endif /*BATCH_H_*/
@@ -0,0 +1,151 @@
+/***********************************************************
+*  capture_file.c                                          *
+*                                                          *
+*  Recordings on the host: mapping, appending, replay      *
+*                                                          *
+************************************************************/
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "capture_file.h"
+#include "capture.h"
+
+
+int capture_file_open(capture_file_t *f, const char *path)
+{
+	struct stat st;
+	size_t pos, size;
+	long n;
+	int fd;
+
+	memset(f, 0, sizeof(*f));
+	fd = open(path, O_RDONLY);
+	if(fd < 0)
+	{
+		return -1;
+	}
+	if(fstat(fd, &st) != 0 || st.st_size < CAPTURE_REC_HEADER)
+	{
+		close(fd);
+		return -1;
+	}
+	f->size = st.st_size;
+	f->base = mmap(NULL, f->size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);									// the mapping stays
+	if(f->base == MAP_FAILED)
+	{
+		f->base = NULL;
+		return -1;
+	}
+	madvise((void *)f->base, f->size, MADV_SEQUENTIAL);	// replay reads front to back: large read ahead
+
+	/* index: walk the headers, at most one record per CAPTURE_REC_HEADER bytes */
+	f->offset = malloc(sizeof(size_t)*(f->size/CAPTURE_REC_HEADER));
+	if(f->offset == NULL)
+	{
+		capture_file_close(f);
+		return -1;
+	}
+	for(pos=0,n=0;pos + CAPTURE_REC_HEADER <= f->size;pos+=size,n++)
+	{
+		size = capture_rec_size((const capture_rec_t *)(f->base + pos));
+		if(size == 0 || pos + size > f->size)
+		{
+			break;
+		}
+		f->offset[n] = pos;
+	}
+	f->count = n;
+	f->tail = f->size - pos;
+	return 0;
+}
+
+
+void capture_file_close(capture_file_t *f)
+{
+	if(f->base)
+	{
+		munmap((void *)f->base, f->size);
+	}
+	free(f->offset);
+	memset(f, 0, sizeof(*f));
+}
+
+
+const capture_rec_t *capture_file_rec(const capture_file_t *f, long i)
+{
+	return (const capture_rec_t *)(f->base + f->offset[i]);
+}
+
+
+const short *capture_file_frames(const capture_file_t *f, long i)
+{
+	return (const short *)(f->base + f->offset[i] + capture_file_rec(f, i)->header);
+}
+
+
+int capture_file_append(const char *path, const capture_rec_t *rec, const short *frames)
+{
+	FILE *fp = fopen(path, "ab");
+	int ok;
+
+	if(fp == NULL)
+	{
+		return -1;
+	}
+	ok = fwrite(rec, CAPTURE_REC_HEADER, 1, fp) == 1
+	  && fwrite(frames, 4, rec->frames, fp) == rec->frames;
+	ok &= fclose(fp) == 0;
+	return ok ? 0 : -1;
+}
+
+
+static double capture_time(const capture_rec_t *rec)	// seconds
+{
+	return (rec->time_hi*4294967296.0 + rec->time_lo)*1e-6;
+}
+
+
+void capture_replay(const capture_file_t *f, engine_t *e, const engine_cfg_t *cfg,
+                    capture_sink_t sink, void *ctx, capture_replay_t *st)
+{
+	static short capture[CAPTURE_LEN];
+	const capture_rec_t *rec;
+	engine_result_t res;
+	struct timespec t0, t1;
+	long i;
+
+	memset(st, 0, sizeof(*st));
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	integrate_init(e->integrator, e->integrator->k, e->integrator->mode);	// no sum across recordings
+	for(i=0;i<f->count;i++)
+	{
+		rec = capture_file_rec(f, i);
+		if(!capture_rec_fits(rec) || rec->sweep_id >= WAVEFORMS)
+		{
+			st->skipped++;
+			continue;
+		}
+		capture_rec_unpack(capture_file_frames(f, i), capture);	// what the receive EDMA wrote
+		st->pings++;
+		if(engine_ping(e, cfg, capture, rec->sweep_id, &res))
+		{
+			st->results++;
+			if(sink)
+			{
+				sink(ctx, i, rec, &res);
+			}
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	st->seconds = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec)*1e-9;
+	if(f->count > 1)
+	{
+		st->recorded = capture_time(capture_file_rec(f, f->count-1)) - capture_time(capture_file_rec(f, 0));
+	}
+}
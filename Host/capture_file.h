@@ -0,0 +1,52 @@
+/***********************************************************
+*  capture_file.h                                          *
+*                                                          *
+*  Recordings (capture_rec.h) on the host: read only       *
+*  memory mapping with an index of the records, appending  *
+*  of new records, and the replay of every recorded ping   *
+*  through engine.c as fast as the CPU allows.             *
+*                                                          *
+*  A record cut off at the end of the file (target dump    *
+*  or copy still running) ends the index, the records      *
+*  before it stay usable.                                  *
+*                                                          *
+************************************************************/
+#ifndef CAPTURE_FILE_H_
+#define CAPTURE_FILE_H_
+
+#include <stddef.h>
+#include "capture_rec.h"
+#include "engine.h"
+
+typedef struct {
+	const unsigned char *base;		// mapping of the whole file
+	size_t size;					// bytes mapped
+	size_t tail;					// bytes behind the last complete record (cut off / not a record)
+	long count;						// complete records
+	size_t *offset;					// [count] start of each record
+} capture_file_t;
+
+int  capture_file_open(capture_file_t *f, const char *path);	// 0 = ok
+void capture_file_close(capture_file_t *f);
+
+const capture_rec_t *capture_file_rec(const capture_file_t *f, long i);	// header of record i
+const short *capture_file_frames(const capture_file_t *f, long i);		// its interleaved frames
+
+/* one record at the end of path (created if missing), 0 = ok */
+int capture_file_append(const char *path, const capture_rec_t *rec, const short *frames);
+
+/* replay: every record through engine_ping, results handed to sink (may be NULL) in file order */
+typedef void (*capture_sink_t)(void *ctx, long i, const capture_rec_t *rec, const engine_result_t *res);
+
+typedef struct {
+	long pings;						// records processed
+	long skipped;					// records of another sample rate / length (capture_rec_fits)
+	long results;					// engine_ping returned a result (ENGINE_INTEGRATE: every k-th)
+	double seconds;					// wall clock of the replay (unpacking included)
+	double recorded;				// seconds between the first and the last timestamp
+} capture_replay_t;
+
+void capture_replay(const capture_file_t *f, engine_t *e, const engine_cfg_t *cfg,
+                    capture_sink_t sink, void *ctx, capture_replay_t *st);
+
+#endif /*CAPTURE_FILE_H_*/
@@ -0,0 +1,169 @@
+/***********************************************************
+*  channel_sim.c                                           *
+*                                                          *
+*  Synthetic captures for the host build                   *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include "channel_sim.h"
+
+
+void channel_init(channel_t *ch, int delay, float attenuation, float noise, unsigned int seed)
+{
+	ch->delay = delay;
+	ch->frac = 0;
+	ch->skew = 0;
+	ch->attenuation = attenuation;
+	ch->noise = noise;
+	ch->seed = seed ? seed : 1;
+	ch->paths = 0;
+	ch->bits = 16;
+}
+
+
+int channel_add_path(channel_t *ch, int delay, float gain)
+{
+	if(ch->paths >= CHANNEL_PATHS)
+	{
+		return 0;
+	}
+	ch->path_delay[ch->paths] = delay;
+	ch->path_gain[ch->paths] = gain;
+	ch->paths++;
+	return 1;
+}
+
+
+static float channel_uniform(channel_t *ch)			// (0,1]
+{
+	ch->seed = ch->seed*1664525u + 1013904223u;
+	return ((ch->seed >> 8) + 1.0f)/16777216.0f;
+}
+
+
+static float channel_gauss(channel_t *ch)			// Box-Muller
+{
+	float u1 = channel_uniform(ch);
+	float u2 = channel_uniform(ch);
+	return sqrtf(-2.0f*logf(u1))*cosf(2.0f*3.14159265f*u2);
+}
+
+
+static short channel_saturate(float v)
+{
+	if(v > 32767.0f)
+	{
+		return 32767;
+	}
+	if(v < -32768.0f)
+	{
+		return -32768;
+	}
+	return (short)lrintf(v);
+}
+
+
+#define FRAC_HALF 16				// taps on each side of the fractional delay interpolator
+
+static float channel_sweep_at(const short *sweep, int sweep_len, float x)	// sweep at a non integer position
+{
+	int i, n = (int)floor(x);
+	float v = 0, t;
+
+	for(i=n-FRAC_HALF+1;i<=n+FRAC_HALF;i++)
+	{
+		if(i < 0 || i >= sweep_len)
+		{
+			continue;
+		}
+		t = x - i;
+		v += sweep[i] * (fabsf(t) < 1e-6f ? 1.0f : sinf(3.14159265f*t)/(3.14159265f*t))
+		     * 0.5f*(1 + cosf(3.14159265f*t/FRAC_HALF));
+	}
+	return v;
+}
+
+
+static float channel_path(const channel_t *ch, const short *sweep, int sweep_len, int period, long t,
+                          int delay, float shift)
+{											// noise free echo of one path at absolute sample t, shift = extra delay
+	long rel;
+	float d;
+
+	rel = t - delay;						// position inside the echo of the latest sweep
+	if(period > 0 && rel >= 0)
+	{
+		rel = rel % period;
+	}
+
+	d = ch->frac + shift;
+	if(d != 0)
+	{
+		if(rel >= -FRAC_HALF + d && rel < sweep_len + FRAC_HALF + d)
+		{
+			return channel_sweep_at(sweep, sweep_len, rel - d);
+		}
+	}
+	else if(rel >= 0 && rel < sweep_len)
+	{
+		return sweep[rel];
+	}
+	return 0;
+}
+
+
+static float channel_echo(const channel_t *ch, const short *sweep, int sweep_len, int period, long t, float shift)
+{											// direct echo + reflected paths
+	float v;
+	int k;
+
+	v = channel_path(ch, sweep, sweep_len, period, t, ch->delay, shift);
+	for(k=0;k<ch->paths;k++)
+	{
+		v += ch->path_gain[k]*channel_path(ch, sweep, sweep_len, period, t, ch->delay + ch->path_delay[k], shift);
+	}
+	return ch->attenuation*v;
+}
+
+
+static short channel_quantise(const channel_t *ch, float v)	// codec with bits of resolution
+{
+	float step;
+
+	if(ch->bits >= 16 || ch->bits < 1)
+	{
+		return channel_saturate(v);
+	}
+	step = (float)(1 << (16 - ch->bits));
+	return channel_saturate(step*floorf(v/step + 0.5f));
+}
+
+
+void channel_capture(channel_t *ch, const short *sweep, int sweep_len, int period,
+                     long t0, short *capture, int frames)
+{
+	int i;
+	float v;
+
+	for(i=0;i<frames;i++)
+	{
+		v = channel_echo(ch, sweep, sweep_len, period, t0 + i, 0);
+		if(ch->noise > 0)
+		{
+			v += ch->noise*channel_gauss(ch);
+		}
+		capture[2*i] = channel_quantise(ch, v);	// left: hydrophone
+
+		if(ch->skew == 0)
+		{
+			capture[2*i+1] = capture[2*i];		// right: same signal
+			continue;
+		}
+		v = channel_echo(ch, sweep, sweep_len, period, t0 + i, ch->skew);
+		if(ch->noise > 0)
+		{
+			v += ch->noise*channel_gauss(ch);	// second hydrophone, own noise
+		}
+		capture[2*i+1] = channel_quantise(ch, v);
+	}
+}
@@ -0,0 +1,38 @@
+/***********************************************************
+*  channel_sim.h                                           *
+*                                                          *
+*  Synthetic captures for the host build: the sent sweep   *
+*  delayed, attenuated, with multipath, noise and the      *
+*  resolution of the codec, laid out like the interleaved  *
+*  stereo data the EDMA writes to Buffer_in                *
+*                                                          *
+************************************************************/
+#ifndef CHANNEL_SIM_H_
+#define CHANNEL_SIM_H_
+
+#define CHANNEL_PATHS 4			// reflected paths besides the direct echo (surface, bottom ...)
+
+typedef struct {
+	int   delay;			// echo delay in samples (= array index the correlators should find)
+	float frac;				// + fractional delay in [0,1) (band limited interpolation of the sweep)
+	float skew;				// right channel: delay relative to the left one (samples, may be fractional and < 0)
+	float attenuation;		// echo amplitude relative to the sweep
+	float noise;			// standard deviation of the added white noise (in LSB)
+	unsigned int seed;		// noise generator state
+	int   paths;			// used entries of path_delay / path_gain (0 = direct echo only)
+	int   path_delay[CHANNEL_PATHS];	// samples behind the direct echo
+	float path_gain[CHANNEL_PATHS];		// amplitude relative to the direct echo (may be < 0: phase inversion at the surface)
+	short bits;				// codec resolution: the capture is rounded to 2^(16-bits) LSB (16 = full AIC23 resolution)
+} channel_t;
+
+void channel_init(channel_t *ch, int delay, float attenuation, float noise, unsigned int seed);	// direct echo, 16 bit
+
+/* one more reflected path, 0 when all CHANNEL_PATHS are in use */
+int channel_add_path(channel_t *ch, int delay, float gain);
+
+/* frames stereo frames starting at absolute sample t0 of an endless capture in which
+   a sweep is sent every period samples (period <= 0 => a single sweep at t = 0) */
+void channel_capture(channel_t *ch, const short *sweep, int sweep_len, int period,
+                     long t0, short *capture, int frames);
+
+#endif /*CHANNEL_SIM_H_*/
@@ -0,0 +1,75 @@
+/***********************************************************
+*  edma_model.c                                            *
+*                                                          *
+*  Host model of a C671x EDMA transfer                     *
+*                                                          *
+************************************************************/
+#include <string.h>
+#include "edma_model.h"
+
+
+int edma_model_check(const edma_model_t *p)
+{
+	if(p->esize != 1 && p->esize != 2 && p->esize != 4)
+	{
+		return 0;
+	}
+	if(p->elecnt < 1 || p->elecnt > 0xFFFF || p->frmcnt < 0 || p->frmcnt > 0xFFFF)
+	{
+		return 0;
+	}
+	if(p->eleidx < -32768 || p->eleidx > 32767 || p->frmidx < -32768 || p->frmidx > 32767)
+	{
+		return 0;
+	}
+	if(p->frmcnt > 0 && p->elerld != p->elecnt)	// element sync, several frames: count reloaded from ELERLD
+	{
+		return 0;
+	}
+	return 1;
+}
+
+
+long edma_model_run(const edma_model_t *p, const void *src, void *dst, long dst_size)
+{
+	const unsigned char *s = src;
+	unsigned char *d = dst;
+	long addr = 0, n = 0;
+	int frame, element, elecnt;
+
+	if(!edma_model_check(p))
+	{
+		return -1;
+	}
+
+	elecnt = p->elecnt;
+	for(frame=0;frame<=p->frmcnt;frame++)
+	{
+		for(element=0;element<elecnt;element++)
+		{
+			if(addr < 0 || addr + p->esize > dst_size || addr % p->esize)
+			{
+				return -1;
+			}
+			memcpy(d + addr, s + n*p->esize, p->esize);
+			n++;
+
+			switch(p->dum)
+			{
+			case EDMA_MODEL_INC:
+				addr += p->esize;
+				break;
+			case EDMA_MODEL_DEC:
+				addr -= p->esize;
+				break;
+			case EDMA_MODEL_IDX:
+				addr += element == elecnt-1 ? p->frmidx : p->eleidx;
+				break;
+			default:
+				break;
+			}
+		}
+		elecnt = p->elerld;
+	}
+	return n;
+}
@@ -0,0 +1,43 @@
+/***********************************************************
+*  edma_model.h                                            *
+*                                                          *
+*  Host model of a C671x EDMA transfer: the destination    *
+*  address sequence of one parameter set, element          *
+*  synchronised (FS = 0) from a fixed source (the McBSP    *
+*  data register), so the index values the target uses     *
+*  can be checked without the board.                       *
+*                                                          *
+*  Address update after each element (1D transfer):        *
+*    NONE : unchanged                                      *
+*    INC  : + ESIZE            DEC : - ESIZE               *
+*    IDX  : + ELEIDX inside a frame, + FRMIDX after the    *
+*           last element of a frame                        *
+*                                                          *
+************************************************************/
+#ifndef EDMA_MODEL_H_
+#define EDMA_MODEL_H_
+
+#define EDMA_MODEL_NONE 0
+#define EDMA_MODEL_INC  1
+#define EDMA_MODEL_DEC  2
+#define EDMA_MODEL_IDX  3
+
+typedef struct {
+	int esize;				// bytes per element (1, 2 or 4)
+	int elecnt;				// CNT.ELECNT: elements per frame
+	int frmcnt;				// CNT.FRMCNT: frames - 1
+	int dum;				// destination update mode
+	int eleidx;				// IDX.ELEIDX (bytes, signed 16 bit)
+	int frmidx;				// IDX.FRMIDX (bytes, signed 16 bit)
+	int elerld;				// RLD.ELERLD: element count reload between frames
+} edma_model_t;
+
+/* 0 if the fields do not fit the registers or the reload would not restart a frame */
+int  edma_model_check(const edma_model_t *p);
+
+/* runs the transfer: element i of the source stream goes to the destination address the
+   channel computes, dst_size bytes are writable behind dst. Returns the number of elements
+   written, -1 if an address leaves the buffer or is not aligned to ESIZE */
+long edma_model_run(const edma_model_t *p, const void *src, void *dst, long dst_size);
+
+#endif /*EDMA_MODEL_H_*/
@@ -0,0 +1,47 @@
+/***********************************************************
+*  meas_dump.c                                             *
+*                                                          *
+*  Measurement stream of the target (RTDX channel          *
+*  "meas_chan" logged to a file, or piped in) => CSV on    *
+*  stdout, one line per ping, counts on stderr.            *
+*                                                          *
+*  usage: meas_dump [<file>]        (stdin without file)   *
+*                                                          *
+************************************************************/
+#include <stdio.h>
+#include "meas_reader.h"
+
+
+static void dump(void *ctx, const meas_t *m)
+{
+	meas_print(stdout, m);
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned char buf[4096];
+	meas_reader_t r;
+	FILE *fp = stdin;
+	size_t n;
+
+	if(argc > 1 && (fp = fopen(argv[1], "rb")) == NULL)
+	{
+		perror(argv[1]);
+		return 1;
+	}
+	meas_reader_init(&r);
+	meas_print_header(stdout);
+	while((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+	{
+		meas_reader_push(&r, buf, n, dump, NULL);
+		fflush(stdout);						// live when reading a pipe
+	}
+	fprintf(stderr, "meas_dump: %lu records, %lu pings missing, %lu dropped by the target, %lu bytes skipped\n",
+	        r.records, r.gaps, r.lost, r.skipped);
+	if(fp != stdin)
+	{
+		fclose(fp);
+	}
+	return 0;
+}
@@ -0,0 +1,112 @@
+/***********************************************************
+*  meas_reader.c                                           *
+*                                                          *
+*  Host decoder of the measurement stream                  *
+*                                                          *
+************************************************************/
+#include <string.h>
+#include "meas_reader.h"
+
+
+void meas_reader_init(meas_reader_t *r)
+{
+	memset(r, 0, sizeof(*r));
+}
+
+
+static void meas_reader_record(meas_reader_t *r, const meas_t *m, meas_sink_t sink, void *ctx)
+{
+	if(m->engine != MEAS_STREAM)
+	{
+		if(r->have_seq && m->seq != r->next_seq)
+		{
+			r->gaps += m->seq - r->next_seq;	// unsigned: also right across the wrap of seq
+		}
+		r->next_seq = m->seq + 1;
+		r->have_seq = 1;
+	}
+	r->lost = m->lost;
+	r->records++;
+	if(sink)
+	{
+		sink(ctx, m);
+	}
+}
+
+
+long meas_reader_push(meas_reader_t *r, const void *data, size_t len, meas_sink_t sink, void *ctx)
+{
+	const unsigned char *p = data;
+	unsigned int sync;
+	meas_t m;
+	long count = 0;
+	size_t n, i;
+
+	while(len > 0)
+	{
+		n = sizeof(meas_t) - r->fill;
+		n = n < len ? n : len;
+		memcpy(r->buf + r->fill, p, n);
+		r->fill += n;
+		p += n;
+		len -= n;
+		if(r->fill < sizeof(meas_t))
+		{
+			break;
+		}
+
+		memcpy(&m, r->buf, sizeof(m));
+		if(meas_valid(&m))
+		{
+			meas_reader_record(r, &m, sink, ctx);
+			r->fill = 0;
+			count++;
+			continue;
+		}
+
+		/* damaged: drop bytes up to the next possible sync word and assemble again from there */
+		for(i=1;i+4<=sizeof(meas_t);i++)
+		{
+			memcpy(&sync, r->buf + i, 4);
+			if(sync == MEAS_SYNC)
+			{
+				break;
+			}
+		}
+		if(i + 4 > sizeof(meas_t))
+		{
+			i = sizeof(meas_t) - 3;				// a sync word may start in the last 3 bytes
+		}
+		memmove(r->buf, r->buf + i, sizeof(meas_t) - i);
+		r->fill = sizeof(meas_t) - i;
+		r->skipped += i;
+	}
+	return count;
+}
+
+
+void meas_print_header(FILE *fp)
+{
+	int i;
+
+	fprintf(fp, "seq,time_us,engine,waveform,cycles,lost,range_m,peak,bearing_deg,targets");
+	for(i=0;i<MEAS_TARGETS;i++)
+	{
+		fprintf(fp, ",target%d_m", i);
+	}
+	fprintf(fp, "\n");
+}
+
+
+void meas_print(FILE *fp, const meas_t *m)
+{
+	int i;
+
+	fprintf(fp, "%u,%.0f,%u,%u,%u,%u,%.4f,%.2f,%.2f,%u", m->seq, m->time_hi*4294967296.0 + m->time_lo,
+	        m->engine, m->waveform, m->cycles, m->lost, m->range, m->peak, m->bearing_deg, m->target_count);
+	for(i=0;i<MEAS_TARGETS;i++)
+	{
+		fprintf(fp, ",%.4f", m->target_range[i]);
+	}
+	fprintf(fp, "\n");
+}
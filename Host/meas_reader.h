@@ -0,0 +1,42 @@
+/***********************************************************
+*  meas_reader.h                                           *
+*                                                          *
+*  Host decoder of the measurement stream (meas_ring.h)    *
+*  as it arrives from the RTDX channel "meas_chan" or a    *
+*  log of it: bytes in chunks of any size, records out.    *
+*                                                          *
+*  Resynchronises on the sync word after damaged bytes,    *
+*  accepts only records with the right checksum and       *
+*  counts pings missing between two records (seq gaps)     *
+*  next to the losses the target reported itself (lost).   *
+*                                                          *
+************************************************************/
+#ifndef MEAS_READER_H_
+#define MEAS_READER_H_
+
+#include <stddef.h>
+#include <stdio.h>
+#include "meas_ring.h"
+
+typedef void (*meas_sink_t)(void *ctx, const meas_t *m);
+
+typedef struct {
+	unsigned char buf[sizeof(meas_t)];	// record being assembled
+	size_t fill;
+	unsigned long records;				// valid records passed to the sink
+	unsigned long skipped;				// bytes thrown away while searching the sync word
+	unsigned long gaps;					// records missing by seq (not counting MEAS_STREAM records)
+	unsigned long lost;					// target: records its ring dropped (lost of the last record)
+	unsigned int next_seq;
+	int have_seq;
+} meas_reader_t;
+
+void meas_reader_init(meas_reader_t *r);
+
+/* decodes len bytes, sink (may be NULL) is called for every complete valid record, returns their number */
+long meas_reader_push(meas_reader_t *r, const void *data, size_t len, meas_sink_t sink, void *ctx);
+
+void meas_print_header(FILE *fp);					// CSV column names
+void meas_print(FILE *fp, const meas_t *m);			// one CSV line
+
+#endif /*MEAS_READER_H_*/
@@ -0,0 +1,129 @@
+/***********************************************************
+*  sonar_batch.c                                           *
+*                                                          *
+*  Recordings (capture_rec.h) through engine.c on every    *
+*  core (batch.h) => CSV on stdout, one line per result    *
+*  in ping order, counts and speed on stderr.              *
+*                                                          *
+*  usage: sonar_batch [key=value ...] <file> ...           *
+*    threads=   workers (0: one per CPU)                   *
+*    engine=    ENGINE_... (engine.h), default 1 frequency *
+*    k= sliding=1   ENGINE_INTEGRATE pings per sum, mode   *
+*    min= max=  range gate in metres                       *
+*    alpha=     CFAR threshold factor                      *
+*    method=    sub-sample refinement (peak_interp.h)      *
+*    defaults: those of the target (ENGINE_DEFAULT_...)    *
+*    chunk=     pings per task                             *
+*    block=     MB per read                                *
+*                                                          *
+************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "batch.h"
+#include "sweep.h"
+
+#define CSV_TARGETS 4			// further echoes per line
+
+
+static const char *arg(int argc, char **argv, const char *key, const char *def)
+{
+	size_t len = strlen(key);
+	int i;
+
+	for(i=1;i<argc;i++)
+	{
+		if(strncmp(argv[i], key, len) == 0 && argv[i][len] == '=')
+		{
+			return argv[i]+len+1;
+		}
+	}
+	return def;
+}
+
+
+static double num(int argc, char **argv, const char *key, double def)
+{
+	const char *v = arg(argc, argv, key, NULL);
+	return v ? atof(v) : def;
+}
+
+
+static void csv(void *ctx, int file, long i, const capture_rec_t *rec, const engine_result_t *res)
+{
+	int t;
+
+	printf("%d,%ld,%u,%.0f,%u,%d,%.4f,%.2f,%.2f,%d", file, i, rec->seq, rec->time_hi*4294967296.0 + rec->time_lo,
+	       rec->sweep_id, res->used, res->range, res->peak, res->used == ENGINE_STEREO ? res->bearing_deg : 0,
+	       res->target_count);
+	for(t=0;t<CSV_TARGETS;t++)
+	{
+		printf(",%.4f", t < res->target_count ? res->target_range[t] : 0);
+	}
+	printf("\n");
+}
+
+
+int main(int argc, char **argv)
+{
+	static short bank[WAVEFORMS][SWEEP_LEN];
+	const char **paths;
+	batch_cfg_t bc;
+	batch_stat_t st;
+	engine_t setup;
+	int i, files = 0;
+
+	paths = malloc(sizeof(char *)*argc);
+	for(i=1;i<argc;i++)
+	{
+		if(strchr(argv[i], '=') == NULL)
+		{
+			paths[files++] = argv[i];
+		}
+	}
+	if(files == 0)
+	{
+		fprintf(stderr, "usage: sonar_batch [threads= engine= k= sliding=1 min= max= alpha= method= chunk= block=] <file> ...\n");
+		return 1;
+	}
+
+	/* engine settings of the target (engine_defaults), changed by the options given */
+	memset(&setup, 0, sizeof(setup));
+	memset(&bc, 0, sizeof(bc));
+	engine_defaults(&setup, &bc.cfg);
+	for(i=0;i<WAVEFORMS;i++)
+	{
+		waveform_init(bank[i], i);
+		setup.sweep[i] = bank[i];
+	}
+	setup.cfar.alpha = num(argc, argv, "alpha", setup.cfar.alpha);
+
+	bc.threads = num(argc, argv, "threads", 0);
+	bc.chunk = num(argc, argv, "chunk", 0);
+	bc.block = (size_t)(num(argc, argv, "block", 0)*1048576);
+	bc.setup = &setup;
+	bc.cfg.engine = num(argc, argv, "engine", bc.cfg.engine);
+	bc.cfg.method = num(argc, argv, "method", bc.cfg.method);
+	bc.cfg.integrate_k = num(argc, argv, "k", bc.cfg.integrate_k);
+	if(num(argc, argv, "sliding", 0))
+	{
+		bc.cfg.integrate_mode = INTEGRATE_SLIDING;
+	}
+	range_gate_set(&bc.cfg.gate, num(argc, argv, "min", ENGINE_DEFAULT_RANGE_MIN_M), num(argc, argv, "max", ENGINE_DEFAULT_RANGE_MAX_M));
+
+	printf("file,record,seq,time_us,sweep,engine,range_m,peak,bearing_deg,targets");
+	for(i=0;i<CSV_TARGETS;i++)
+	{
+		printf(",target%d_m", i);
+	}
+	printf("\n");
+	if(batch_run(&bc, paths, files, csv, NULL, &st) != 0)
+	{
+		fprintf(stderr, "sonar_batch: cannot read the files (or no memory), stopped after %ld pings\n", st.pings);
+		return 1;
+	}
+	fprintf(stderr, "sonar_batch: %d files, %ld pings, %ld results, %ld skipped, %.0f bytes cut off, %d threads: %.1f s (%.0f pings/s, %.1f s reading)\n",
+	        files, st.pings, st.results, st.skipped, st.tail, st.threads, st.seconds, st.pings/st.seconds, st.read_seconds);
+	free(paths);
+	return 0;
+}
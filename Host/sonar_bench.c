@@ -0,0 +1,2651 @@
+/***********************************************************
+*  sonar_bench.c                                           *
+*                                                          *
+*  Host driver for the portable processing modules:        *
+*  feeds synthetic captures through the same code that     *
+*  runs on the DSK6713 and reports results and timing.     *
+*                                                          *
+*  usage: sonar_bench <suite> [key=value ...]              *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "sonar_params.h"
+#include "sweep.h"
+#include "stream_corr.h"
+#include "mf_template.h"
+#include "correlation.h"
+#include "fft.h"
+#include "fft_r4.h"
+#include "channel_sim.h"
+#include "edma_model.h"
+#include "placement.h"
+#include "sweep_synth.h"
+#include "ping_sched.h"
+#include "integrate.h"
+#include "engine.h"
+#include "capture_rec.h"
+#include "capture_file.h"
+#include "profile.h"
+#include "meas_ring.h"
+#include "meas_reader.h"
+#include "tracker.h"
+#include "batch.h"
+
+
+static short sweep[SWEEP_LEN];
+
+
+/*######### HELPERS #########*/
+
+static double now(void)			// seconds, monotonic
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+
+static unsigned long long cycles(void)	// time stamp counter, 0 where there is none
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+
+static const char *arg_str(int argc, char **argv, const char *key, const char *def)
+{
+	int i;
+	size_t len = strlen(key);
+
+	for(i=0;i<argc;i++)
+	{
+		if(strncmp(argv[i], key, len) == 0 && argv[i][len] == '=')
+		{
+			return argv[i]+len+1;
+		}
+	}
+	return def;
+}
+
+
+static long arg_int(int argc, char **argv, const char *key, long def)
+{
+	const char *v = arg_str(argc, argv, key, NULL);
+	return v ? strtol(v, NULL, 0) : def;
+}
+
+
+static double arg_float(int argc, char **argv, const char *key, double def)
+{
+	const char *v = arg_str(argc, argv, key, NULL);
+	return v ? strtod(v, NULL) : def;
+}
+
+
+/* receive EDMA with the target's parameters (capture.h): interleaved McBSP stream of frames
+   stereo samples => [ left | right ] stride shorts apart. 0 if the transfer leaves the buffer */
+static int receive(const short *stream, short *capture, int frames, int stride)
+{
+	edma_model_t rcv = { 2, DEINTERLEAVE_ELECNT, frames-1, EDMA_MODEL_IDX,
+	                     DEINTERLEAVE_ELEIDX(stride), DEINTERLEAVE_FRMIDX(stride), DEINTERLEAVE_ELECNT };
+	return edma_model_run(&rcv, stream, capture, 2*(long)(stride + frames)) == 2*frames;
+}
+
+
+/* one ping through the channel and the receive EDMA, laid out like Buffer_in (zero tail kept) */
+static void capture_ping(channel_t *ch, short *capture)
+{
+	static short stream[RESPONSE_LEN];
+
+	channel_capture(ch, sweep, SWEEP_LEN, 0, 0, stream, RESPONSE_MONO);
+	receive(stream, capture, RESPONSE_MONO, CAPTURE_STRIDE);
+}
+
+
+/*######### SUITES #########*/
+
+/* stream: endless capture with a sweep every PING_PERIOD samples, cut into EDMA sized
+   blocks and pushed through stream_corr exactly like process_stream does on the target.
+   A second stream loses every drop-th block (overrun => stream_corr_skip): the pings
+   around the gaps must be dropped, never reported at a wrong lag */
+static int bench_stream(int argc, char **argv)
+{
+	static stream_corr_t stream, lossy;
+	static short stream_in[2*STREAM_BLOCK], block[2*STREAM_BLOCK];
+	stream_echo_t echo[STREAM_MAX_ECHO];
+	channel_t ch;
+	long pings = arg_int(argc, argv, "pings", 200);
+	int delay = arg_int(argc, argv, "delay", 1500);
+	float att = arg_float(argc, argv, "att", 0.3);
+	float noise = arg_float(argc, argv, "noise", 300);
+	long drop = arg_int(argc, argv, "drop", 7);
+	long blocks, b, t0, p, lo, found = 0, hits = 0, lossy_found = 0, lossy_hits = 0, skipped = 0, clean = 0;
+	double t, elapsed = 0;
+	int i, count;
+
+	channel_init(&ch, delay, att, noise, 1);
+	stream_corr_init(&stream, sweep, PING_PERIOD);
+	stream_corr_init(&lossy, sweep, PING_PERIOD);
+
+	blocks = (pings*PING_PERIOD + STREAM_KEEP)/STREAM_BLOCK + 1;
+	for(b=0;b<blocks;b++)
+	{
+		t0 = b*STREAM_BLOCK;
+		channel_capture(&ch, sweep, SWEEP_LEN, PING_PERIOD, t0, stream_in, STREAM_BLOCK);
+		receive(stream_in, block, STREAM_BLOCK, STREAM_BLOCK);		// [ left | right ] as Buffer_ping / pong
+
+		t = now();
+		count = stream_corr_push(&stream, block, 1, echo);
+		elapsed += now()-t;
+
+		for(i=0;i<count;i++)
+		{
+			found++;
+			if(abs(echo[i].lag - delay % PING_PERIOD) <= 1)
+			{
+				hits++;
+			}
+		}
+
+		if(drop > 0 && b % drop == drop-1)
+		{
+			stream_corr_skip(&lossy);
+			skipped++;
+			continue;
+		}
+		count = stream_corr_push(&lossy, block, 1, echo);
+		for(i=0;i<count;i++)
+		{
+			lossy_found++;
+			if(abs(echo[i].lag - delay % PING_PERIOD) <= 1)
+			{
+				lossy_hits++;
+			}
+		}
+	}
+
+	/* pings to report despite the losses: span complete and clear of every lost block
+	   and of the STREAM_KEEP outputs after it (correlated against the zeroed overlap).
+	   Push b yields the outputs of sample positions b*STREAM_BLOCK - STREAM_KEEP + 0..STREAM_BLOCK-1 */
+	for(p=0;(p+1)*PING_PERIOD <= blocks*STREAM_BLOCK - STREAM_KEEP;p++)
+	{
+		lo = p*PING_PERIOD;
+		for(b=drop-1;drop > 0 && b<blocks;b+=drop)
+		{
+			if(lo < (b+1)*STREAM_BLOCK && lo + PING_PERIOD > b*STREAM_BLOCK - STREAM_KEEP)
+			{
+				break;
+			}
+		}
+		clean += drop <= 0 || b >= blocks;
+	}
+
+	printf("stream: %ld blocks of %d samples, %ld pings reported, %ld at the true lag %d\n",
+	       blocks, STREAM_BLOCK, found, hits, delay % PING_PERIOD);
+	printf("stream: %ld blocks lost (every %ld.): %ld pings reported (%ld clear of the gaps), %ld at the true lag\n",
+	       skipped, drop, lossy_found, clean, lossy_hits);
+	printf("stream: %.1f us per block, %.1f x real time (block = %.1f ms)\n",
+	       1e6*elapsed/blocks, (double)blocks*STREAM_BLOCK/SAMPLE_RATE/elapsed,
+	       1e3*STREAM_BLOCK/SAMPLE_RATE);
+	return hits == found && found > 0 && lossy_hits == lossy_found && lossy_found == clean ? 0 : 1;
+}
+
+
+/* per ping path as it was before the template: twiddles, bit reversal and the sweep FFT
+   redone every ping, plain (not conjugated) product => peak at lag + SWEEP_LEN - 1 */
+#define FFT_LEN 32768			// fixed size of that version (complex array)
+
+static short legacy_cross_correlation_frequency(const short *capture)
+{
+	static float sweep_freq[FFT_LEN], fft_coeff[FFT_LEN/2], response_freq[FFT_LEN], cross_corr_freq[FFT_LEN];
+	short max_index, k, N;
+	int i, j;
+	float max_value;
+
+	for(i=0;i<FFT_LEN/2;i++)
+	{
+		sweep_freq[2*i] = i < SWEEP_LEN ? (float)sweep[i]/25000 : 0;
+		sweep_freq[2*i+1] = 0;
+		response_freq[2*i] = i < RESPONSE_MONO ? (float)capture[i]/25000 : 0;
+		response_freq[2*i+1] = 0;
+	}
+	N = FFT_LEN/2;
+	tw_genr2fft(fft_coeff, N);
+	bit_rev(fft_coeff, N>>1);
+	cfftr2_dit(sweep_freq, fft_coeff, N);
+	cfftr2_dit(response_freq, fft_coeff, N);
+	for(j=0;j<FFT_LEN;j=j+2)
+	{
+		cross_corr_freq[j] = sweep_freq[j]*response_freq[j] - sweep_freq[j+1]*response_freq[j+1];
+		cross_corr_freq[j+1] = sweep_freq[j+1]*response_freq[j]+sweep_freq[j]*response_freq[j+1];
+	}
+	icfftr2_dif(cross_corr_freq, fft_coeff, N);
+
+	max_value = 0;
+	max_index = 0;
+	for(k=0;k<RESPONSE_LEN;k++)
+	{
+		if(cross_corr_freq[2*k] > max_value)
+		{
+			max_value = cross_corr_freq[2*k];
+			max_index = k;
+		}
+	}
+	return max_index;
+}
+
+
+/* template: per ping time of the frequency domain correlator before and after the
+   matched filter template (three FFTs + twiddle generation vs. two FFTs) */
+static int bench_template(int argc, char **argv)
+{
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN];
+	static short capture[CAPTURE_LEN];
+	channel_t ch;
+	long pings = arg_int(argc, argv, "pings", 50);
+	int delay = arg_int(argc, argv, "delay", 1200);
+	float noise = arg_float(argc, argv, "noise", 300);
+	double t, t_init, t_old = 0, t_new = 0;
+	long p, ok_old = 0, ok_new = 0;
+
+	channel_init(&ch, delay, 0.3, noise, 7);
+
+	t = now();
+	mf_template_init(&tpl, sweep, work);
+	t_init = now()-t;
+
+	for(p=0;p<pings;p++)
+	{
+		capture_ping(&ch, capture);
+
+		t = now();
+		ok_old += legacy_cross_correlation_frequency(capture) == delay + SWEEP_LEN - 1;
+		t_old += now()-t;
+
+		t = now();
+		ok_new += cross_correlation_frequency(capture, &tpl, work, 0, PEAK_SPAN-1) == delay;
+		t_new += now()-t;
+	}
+
+	printf("template: init (once)       %8.3f ms\n", 1e3*t_init);
+	printf("template: per ping before   %8.3f ms  (%ld/%ld peaks correct)\n", 1e3*t_old/pings, ok_old, pings);
+	printf("template: per ping after    %8.3f ms  (%ld/%ld peaks correct)\n", 1e3*t_new/pings, ok_new, pings);
+	printf("template: speed-up          %8.2f x\n", t_old/t_new);
+	return ok_old == pings && ok_new == pings ? 0 : 1;
+}
+
+
+/* complex path the real transform replaced: response with zero imaginary parts through a
+   REF_N point complex FFT, product with the conjugated sweep spectrum, complex IFFT */
+#define REF_N FFT_POW2
+
+static void complex_correlation(const short *capture, float *corr)
+{
+	static float spectrum[2*REF_N], twiddle[REF_N], x[2*REF_N];
+	static int ready = 0;
+	float re, im;
+	int i;
+
+	if(!ready)
+	{
+		tw_genr2fft(twiddle, REF_N);
+		bit_rev(twiddle, REF_N>>1);
+		for(i=0;i<REF_N;i++)
+		{
+			spectrum[2*i] = i < SWEEP_LEN ? (float)sweep[i]/SWEEP_AMPLITUDE : 0;
+			spectrum[2*i+1] = 0;
+		}
+		cfftr2_dit(spectrum, twiddle, REF_N);
+		for(i=0;i<REF_N;i++)
+		{
+			spectrum[2*i] /= REF_N;
+			spectrum[2*i+1] /= -REF_N;
+		}
+		ready = 1;
+	}
+
+	for(i=0;i<REF_N;i++)
+	{
+		x[2*i] = i < RESPONSE_MONO ? (float)capture[i]/SWEEP_AMPLITUDE : 0;
+		x[2*i+1] = 0;
+	}
+	cfftr2_dit(x, twiddle, REF_N);
+	for(i=0;i<2*REF_N;i=i+2)
+	{
+		re = spectrum[i]*x[i] - spectrum[i+1]*x[i+1];
+		im = spectrum[i+1]*x[i] + spectrum[i]*x[i+1];
+		x[i] = re;
+		x[i+1] = im;
+	}
+	icfftr2_dif(x, twiddle, REF_N);
+	for(i=0;i<RESPONSE_MONO;i++)
+	{
+		corr[i] = x[2*i];
+	}
+}
+
+
+static int argmax(const float *x, int n)
+{
+	int i, k = 0;
+	for(i=1;i<n;i++)
+	{
+		if(x[i] > x[k])
+		{
+			k = i;
+		}
+	}
+	return k;
+}
+
+
+/* rfft: real input transform vs. the complex path, same echoes, whole correlation compared */
+static int bench_rfft(int argc, char **argv)
+{
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN], ref[RESPONSE_MONO];
+	static short capture[CAPTURE_LEN];
+	channel_t ch;
+	long pings = arg_int(argc, argv, "pings", 50);
+	float noise = arg_float(argc, argv, "noise", 300);
+	double t, t_cplx = 0, t_real = 0, err, max_err = 0;
+	long p, same = 0;
+	int i, delay, k_ref, k_real;
+	float peak;
+
+	mf_template_init(&tpl, sweep, work);
+
+	for(p=0;p<pings;p++)
+	{
+		delay = 37 + (p*997) % (RESPONSE_MONO - SWEEP_LEN);
+		channel_init(&ch, delay, 0.05 + 0.9*(p%10)/10, noise, 11+p);
+		capture_ping(&ch, capture);
+
+		t = now();
+		complex_correlation(capture, ref);
+		t_cplx += now()-t;
+
+		t = now();
+		k_real = cross_correlation_frequency(capture, &tpl, work, 0, PEAK_SPAN-1);
+		t_real += now()-t;
+
+		k_ref = argmax(ref, RESPONSE_MONO);
+		peak = ref[k_ref];
+		for(i=0;i<RESPONSE_MONO;i++)
+		{
+			err = fabs(work[i]-ref[i])/peak;
+			if(err > max_err)
+			{
+				max_err = err;
+			}
+		}
+		same += k_ref == k_real && k_real == delay;
+	}
+
+	printf("rfft: complex path  %8.3f ms per ping, %6lu bytes of float buffers\n", 1e3*t_cplx/pings,
+	       (unsigned long)(3*2*REF_N*sizeof(float)));
+	printf("rfft: real path     %8.3f ms per ping, %6lu bytes (work + template)\n", 1e3*t_real/pings,
+	       (unsigned long)(sizeof(work) + sizeof(tpl)));
+	printf("rfft: speed-up %.2f x, %ld/%ld peaks identical and at the true lag, max deviation %.2e of the peak\n",
+	       t_cplx/t_real, same, pings, max_err);
+	return same == pings && max_err < 1e-3 ? 0 : 1;
+}
+
+
+/* sizes: transform size derived from sonar_params.h and the per ping cost it gives */
+static int bench_sizes(int argc, char **argv)
+{
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN];
+	static short capture[CAPTURE_LEN];
+	channel_t ch;
+	long pings = arg_int(argc, argv, "pings", 50);
+	int delay = arg_int(argc, argv, "delay", 900);
+	long p, ok = 0;
+	double t, elapsed = 0;
+	int i;
+
+	mf_template_init(&tpl, sweep, work);
+	channel_init(&ch, delay, 0.3, 300, 3);
+
+	printf("sizes: SWEEP_LEN %d, RESPONSE_MONO %d => linear correlation %d points\n", SWEEP_LEN, RESPONSE_MONO, CORR_LEN);
+#ifdef FFT_MIXED_RADIX
+	printf("sizes: FFT_N %d (mixed radix, next power of 2 would be %d), radices", FFT_N, FFT_POW2);
+	for(i=0;i<tpl.plan.nfactors;i++)
+	{
+		printf(" %d", tpl.plan.factor[i]);
+	}
+	printf("\n");
+#else
+	printf("sizes: FFT_N %d (power of 2, smallest 2/3/5 size would be %d)\n", FFT_N, FFT_SMOOTH_CEIL);
+	(void)i;
+#endif
+	printf("sizes: work %lu bytes, template %lu bytes, peak span %d lags\n",
+	       (unsigned long)sizeof(work), (unsigned long)sizeof(tpl), PEAK_SPAN);
+
+	for(p=0;p<pings;p++)
+	{
+		capture_ping(&ch, capture);
+		t = now();
+		ok += cross_correlation_frequency(capture, &tpl, work, 0, PEAK_SPAN-1) == delay;
+		elapsed += now()-t;
+	}
+	printf("sizes: %.3f ms per ping, %ld/%ld peaks correct\n", 1e3*elapsed/pings, ok, pings);
+	return ok == pings ? 0 : 1;
+}
+
+
+/* radix4: fused radix 2^2 kernels against cfftr2_dit / icfftr2_dif on one forward + inverse */
+/* e2e: the whole processing of engine.c (as process_SWI runs it) on random echoes with multipath,
+   noise and a coarser codec, per engine: pings/s, time of each stage (stage_end hook) and range error */
+typedef struct {
+	double last;
+	double stage[STAGES];
+} e2e_clock_t;
+
+static void e2e_stage_end(void *ctx, short stage)
+{
+	e2e_clock_t *c = ctx;
+	double t = now();
+
+	c->stage[stage] += t - c->last;
+	c->last = t;
+}
+
+
+static const char *engine_name[ENGINES] = { "time", "frequency", "auto", "coarse", "envelope", "stereo", "integrate" };
+
+static engine_t *bench_engine(void)		// engine.c with its buffers and engine_defaults as in sonar.c, built once
+{
+	static short bank[WAVEFORMS][SWEEP_LEN];
+	static mf_template_t tpl[WAVEFORMS];
+	static mf_stereo_t stereo[WAVEFORMS];
+	static xcorr_i16_t pairs;
+	static coarse_t coarse;
+	static integrate_t integrator;
+	static float work[CORR_WORK_LEN], work_stereo[STEREO_WORK_LEN], twiddle[FFT_TWIDDLE(FFT_N/2)];
+	static engine_t e;
+	engine_cfg_t cfg;
+	int w;
+
+	if(e.tpl)
+	{
+		return &e;
+	}
+	for(w=0;w<WAVEFORMS;w++)
+	{
+		waveform_init(bank[w], w);
+		e.sweep[w] = bank[w];
+	}
+	e.tpl = tpl;
+	e.stereo = stereo;
+	e.pairs = &pairs;
+	e.coarse = &coarse;
+	e.integrator = &integrator;
+	e.work = work;
+	e.work_stereo = work_stereo;
+	e.twiddle = twiddle;
+	engine_defaults(&e, &cfg);
+	engine_init(&e);
+	return &e;
+}
+
+
+static void bench_engine_cfg(engine_cfg_t *cfg, int argc, char **argv)	// engine_defaults, gate from min= max=
+{
+	engine_t e;
+
+	engine_defaults(&e, cfg);
+	range_gate_set(&cfg->gate, arg_float(argc, argv, "min", ENGINE_DEFAULT_RANGE_MIN_M),
+	               arg_float(argc, argv, "max", ENGINE_DEFAULT_RANGE_MAX_M));
+}
+
+
+/* echo of sweep w at delay + frac with up to 3 reflected paths, noise and a bits codec, as Buffer_in */
+static void multipath_ping(const engine_t *e, short w, int delay, float frac, float att, float noise, int bits,
+                           int paths, unsigned int seed, short *capture)
+{
+	static short stream[RESPONSE_LEN];
+	channel_t ch;
+
+	channel_init(&ch, delay, att, noise, seed);
+	ch.frac = frac;
+	ch.bits = bits;
+	if(paths > 0) channel_add_path(&ch, 41, -0.5);		// surface: phase inverted
+	if(paths > 1) channel_add_path(&ch, 97, 0.35);		// bottom
+	if(paths > 2) channel_add_path(&ch, 173, 0.2);
+	channel_capture(&ch, e->sweep[w], SWEEP_LEN, 0, 0, stream, RESPONSE_MONO);
+	receive(stream, capture, RESPONSE_MONO, CAPTURE_STRIDE);
+}
+
+
+static int bench_e2e(int argc, char **argv)
+{
+	static short capture[CAPTURE_LEN];
+	engine_t *e = bench_engine();
+	engine_cfg_t cfg;
+	engine_result_t res;
+	e2e_clock_t clk;
+	long pings = arg_int(argc, argv, "pings", 100);
+	float noise = arg_float(argc, argv, "noise", 200);
+	float att = arg_float(argc, argv, "att", 0.3);
+	int bits = arg_int(argc, argv, "bits", 14);
+	int paths = arg_int(argc, argv, "paths", 2);
+	double tol = arg_float(argc, argv, "tol", 10);		// mm, worse counts as a miss
+	double total, stage[STAGES], err, err_sum, err_max, expect;
+	long p, hits, results;
+	unsigned int rnd = 12345;
+	int g, s, w, delay = 0, fail = 0;
+	float frac = 0;
+
+	e->stage_end = e2e_stage_end;
+	e->stage_ctx = &clk;
+	bench_engine_cfg(&cfg, argc, argv);
+
+	printf("e2e: %ld pings per engine, gate %d..%d lags, echo %.2f, noise rms %.0f, %d bit codec, %d extra paths\n",
+	       pings, cfg.gate.lag_lo, cfg.gate.lag_hi, att, noise, bits, paths);
+	printf("e2e: engine      pings/s   correlate   detect   refine  convert [us]   range error mean / max [mm]   hits\n");
+	for(g=0;g<ENGINES;g++)
+	{
+		cfg.engine = g;
+		total = 0;
+		memset(stage, 0, sizeof(stage));
+		err_sum = err_max = 0;
+		hits = results = 0;
+		for(p=0;p<pings;p++)
+		{
+			if(g != ENGINE_INTEGRATE || p % cfg.integrate_k == 0)	// the integrator needs the echo to stand still
+			{
+				rnd = rnd*1664525u + 1013904223u;
+				delay = cfg.gate.lag_lo + 8 + (int)((rnd >> 8) % (unsigned)(cfg.gate.lag_hi - cfg.gate.lag_lo - 16));
+				frac = (float)((rnd >> 4) & 15)/16;
+			}
+			w = p % WAVEFORMS;
+			multipath_ping(e, w, delay, frac, att, noise, bits, paths, 1000*g + p + 1, capture);
+
+			memset(&clk, 0, sizeof(clk));
+			clk.last = now();
+			if(!engine_ping(e, &cfg, capture, w, &res))
+			{
+				total += now() - clk.last;						// summing only
+				continue;
+			}
+			for(s=0;s<STAGES;s++)
+			{
+				stage[s] += clk.stage[s];
+				total += clk.stage[s];
+			}
+			results++;
+			expect = convert_step_distance(delay + frac);
+			err = 1e3*fabs(res.range - expect);
+			if(err <= tol)
+			{
+				hits++;
+				err_sum += err;
+				err_max = fmax(err_max, err);
+			}
+		}
+		printf("e2e: %-10s %8.0f   %9.1f %8.1f %8.1f %8.2f        %8.3f / %7.3f          %5.1f%%\n", engine_name[g],
+		       pings/total, 1e6*stage[STAGE_CORRELATE]/results, 1e6*stage[STAGE_DETECT]/results,
+		       1e6*stage[STAGE_REFINE]/results, 1e6*stage[STAGE_CONVERT]/results,
+		       hits ? err_sum/hits : 0, err_max, 100.0*hits/results);
+		fail |= hits < results*9/10;
+	}
+	e->stage_end = NULL;
+	return fail;
+}
+
+
+/* replay: a recording (capture_rec.h) through engine.c as fast as the CPU allows. Without file= a
+   recording of simulated multipath pings is written first (make= keeps it), so the range error is known */
+typedef struct {
+	const int *delay;			// simulated recording: true lag of each record, NULL = unknown
+	const float *frac;
+	double tol, err_sum, err_max;
+	long hits;
+} replay_score_t;
+
+static void replay_sink(void *ctx, long i, const capture_rec_t *rec, const engine_result_t *res)
+{
+	replay_score_t *sc = ctx;
+	double err;
+
+	if(sc->delay == NULL)
+	{
+		return;
+	}
+	err = 1e3*fabs(res->range - convert_step_distance(sc->delay[i] + sc->frac[i]));
+	if(err <= sc->tol)
+	{
+		sc->hits++;
+		sc->err_sum += err;
+		sc->err_max = fmax(sc->err_max, err);
+	}
+}
+
+
+static int bench_replay(int argc, char **argv)
+{
+	static short capture[CAPTURE_LEN], frames[RESPONSE_LEN];
+	engine_t *e = bench_engine();
+	engine_cfg_t cfg;
+	capture_file_t f;
+	capture_replay_t st;
+	capture_rec_t rec;
+	replay_score_t sc;
+	FILE *fp;
+	const char *file = arg_str(argc, argv, "file", NULL);
+	const char *keep = arg_str(argc, argv, "make", NULL);
+	long pings = arg_int(argc, argv, "pings", 1000);
+	int only = arg_int(argc, argv, "engine", -1);
+	char tmp[] = "/tmp/sonar_replay_XXXXXX";
+	int *delay = NULL;
+	float *frac = NULL;
+	unsigned int rnd = 4711;
+	double real;
+	long p;
+	int g, fd, fail = 0;
+
+	bench_engine_cfg(&cfg, argc, argv);
+	memset(&sc, 0, sizeof(sc));
+	sc.tol = arg_float(argc, argv, "tol", 10);
+	if(file == NULL)
+	{
+		/* simulated field recording, one record appended per ping */
+		if(keep)
+		{
+			file = keep;
+			remove(file);
+		}
+		else
+		{
+			fd = mkstemp(tmp);
+			if(fd < 0)
+			{
+				printf("replay: no temporary file\n");
+				return 1;
+			}
+			close(fd);
+			remove(tmp);
+			file = tmp;
+		}
+		delay = malloc(sizeof(int)*pings);
+		frac = malloc(sizeof(float)*pings);
+		for(p=0;p<pings;p++)
+		{
+			rnd = p % cfg.integrate_k ? rnd : rnd*1664525u + 1013904223u;	// target still for integrate_k pings
+			delay[p] = cfg.gate.lag_lo + 8 + (int)((rnd >> 8) % (unsigned)(cfg.gate.lag_hi - cfg.gate.lag_lo - 16));
+			frac[p] = (float)((rnd >> 4) & 15)/16;
+			multipath_ping(e, p % WAVEFORMS, delay[p], frac[p], arg_float(argc, argv, "att", 0.3),
+			               arg_float(argc, argv, "noise", 200), 14, 2, p + 1, capture);
+			capture_rec_header(&rec, p % WAVEFORMS, NULL, p, 0, (unsigned int)(p*PING_INTERVAL_MS*1000L));
+			capture_rec_pack(capture, frames);
+			if(capture_file_append(file, &rec, frames) != 0)
+			{
+				printf("replay: cannot append to %s\n", file);
+				return 1;
+			}
+		}
+		fp = fopen(file, "ab");				// dump stopped in the middle of a record: must be ignored
+		fwrite(&rec, CAPTURE_REC_HEADER, 1, fp);
+		fwrite(frames, 2, RESPONSE_MONO, fp);
+		fclose(fp);
+		sc.delay = delay;
+		sc.frac = frac;
+	}
+
+	if(capture_file_open(&f, file) != 0)
+	{
+		printf("replay: cannot map %s\n", file);
+		return 1;
+	}
+	printf("replay: %s, %ld records, %.1f MB mapped, %lu bytes cut off at the end\n", file, f.count,
+	       f.size/1048576.0, (unsigned long)f.tail);
+	if(f.count > 0)
+	{
+		printf("replay: first record: %u Hz, %u frames, sweep %u, seq %u, line in gain 0x%03x / 0x%03x\n",
+		       capture_file_rec(&f, 0)->sample_rate, capture_file_rec(&f, 0)->frames, capture_file_rec(&f, 0)->sweep_id,
+		       capture_file_rec(&f, 0)->seq, capture_file_rec(&f, 0)->aic23[0], capture_file_rec(&f, 0)->aic23[1]);
+	}
+	printf("replay: engine      pings/s   x real time   results   range error mean / max [mm]   hits\n");
+	for(g=0;g<ENGINES;g++)
+	{
+		if(only >= 0 && g != only)
+		{
+			continue;
+		}
+		cfg.engine = g;
+		sc.hits = 0;
+		sc.err_sum = sc.err_max = 0;
+		capture_replay(&f, e, &cfg, replay_sink, &sc, &st);
+		real = st.recorded + PING_INTERVAL_MS*1e-3;		// the last ping lasts one interval
+		printf("replay: %-10s %8.0f   %11.1f   %7ld", engine_name[g], st.pings/st.seconds, real/st.seconds, st.results);
+		if(sc.delay)
+		{
+			printf("        %8.3f / %7.3f          %5.1f%%", sc.hits ? sc.err_sum/sc.hits : 0, sc.err_max,
+			       100.0*sc.hits/st.results);
+			fail |= sc.hits < st.results*9/10;
+		}
+		printf("\n");
+		fail |= st.skipped > 0 && sc.delay != NULL;
+	}
+	fail |= sc.delay != NULL && (f.count != pings || f.tail != CAPTURE_REC_HEADER + 2*RESPONSE_MONO);
+	capture_file_close(&f);
+	if(sc.delay && keep == NULL)
+	{
+		remove(file);
+	}
+	free(delay);
+	free(frac);
+	return fail;
+}
+
+
+/* profile: cycles of every stage from the probes of profile.h (make PROFILE=1), per engine,
+   min / avg / max, the most frequent histogram bin, and the stages against the whole ping */
+static int bench_profile(int argc, char **argv)
+{
+#ifdef PROFILE
+	static short capture[CAPTURE_LEN];
+	engine_t *e;
+	engine_cfg_t cfg;
+	engine_result_t res;
+	long pings = arg_int(argc, argv, "pings", 50);
+	int only = arg_int(argc, argv, "engine", -1);
+	double parts, whole, probe;
+	prof_time_t t;
+	long p;
+	int g, s, b, mode, fail = 0;
+
+	bench_engine_cfg(&cfg, argc, argv);
+	prof_reset();
+	e = bench_engine();								// boot: one template per waveform
+	printf("profile: template (boot, per waveform) %.0f cycles\n", prof_stat[PROF_TEMPLATE].sum/prof_stat[PROF_TEMPLATE].count);
+	prof_reset();
+	for(p=0;p<1000;p++)								// cost of one probe (PROF_MARK right after PROF_START)
+	{
+		PROF_START(t);
+		PROF_MARK(t, PROF_CONVERT);
+	}
+	probe = prof_stat[PROF_CONVERT].sum/prof_stat[PROF_CONVERT].count;
+	printf("profile: %ld pings per engine, empty probe %.0f cycles (%s clock)\n", pings, probe,
+#if defined(__x86_64__) || defined(__i386__)
+	       "time stamp counter"
+#else
+	       "ns"
+#endif
+	       );
+	for(g=0;g<ENGINES;g++)
+	{
+		if(only >= 0 && g != only)
+		{
+			continue;
+		}
+		cfg.engine = g;
+		prof_reset();
+		for(p=0;p<pings;p++)
+		{
+			multipath_ping(e, p % WAVEFORMS, 1200, 0.25f, 0.3f, 200, 14, 2, p + 1, capture);
+			engine_ping(e, &cfg, capture, p % WAVEFORMS, &res);
+		}
+		printf("profile: %s\n", engine_name[g]);
+		printf("profile:   stage         count        min        avg        max   mode bin [cycles]\n");
+		parts = 0;
+		for(s=0;s<PROF_STAGES;s++)
+		{
+			if(prof_stat[s].count == 0)
+			{
+				continue;
+			}
+			for(mode=0,b=1;b<PROF_BINS;b++)
+			{
+				mode = prof_stat[s].hist[b] > prof_stat[s].hist[mode] ? b : mode;
+			}
+			printf("profile:   %-10s %8lu %10llu %10.0f %10llu   >= %llu\n", prof_name[s], prof_stat[s].count,
+			       (unsigned long long)prof_stat[s].min, prof_stat[s].sum/prof_stat[s].count,
+			       (unsigned long long)prof_stat[s].max, mode ? 1ULL << (mode + PROF_BIN0) : 0ULL);
+			parts += s != PROF_PING ? prof_stat[s].sum : 0;
+		}
+		whole = prof_stat[PROF_PING].sum;
+		printf("profile:   stages %.1f%% of the ping cycles\n", 100*parts/whole);
+		fail |= prof_stat[PROF_PING].count != pings || parts > whole || parts < 0.8*whole;
+	}
+	return fail;
+#else
+	printf("profile: built without PROFILE, probes compiled out (make clean && make PROFILE=1)\n");
+	return 0;
+#endif
+}
+
+
+/* meas: the measurement ring between process_SWI and the RTDX task. First both ends in their own
+   thread (lock free, in order, no torn record), then the target on a simulated clock: a ping every
+   interval ms, the drain task into an RTDX buffer of rtdx bytes, the host reading bw bytes/s but not
+   at all for stall ms every 20 s, decoded from arbitrary chunks with a few damaged bytes */
+
+static meas_ring_t meas_test;
+
+static void *meas_producer(void *arg)
+{
+	long i, n = *(long *)arg;
+	meas_t m;
+
+	memset(&m, 0, sizeof(m));
+	for(i=0;i<n;i++)
+	{
+		while(meas_fill(&meas_test) >= MEAS_RING)
+		{
+			sched_yield();						// one core: let the consumer run
+		}
+		m.seq = i;
+		m.range = i*0.001f;
+		m.cycles = (unsigned int)(i*2654435761u);	// every word changes
+		meas_put(&meas_test, &m);
+	}
+	return NULL;
+}
+
+
+typedef struct {
+	unsigned char *data;
+	long size, head, tail;
+} byte_fifo_t;
+
+static long fifo_fill(const byte_fifo_t *f)
+{
+	return f->head - f->tail;
+}
+
+static void fifo_write(byte_fifo_t *f, const void *src, long n)
+{
+	const unsigned char *p = src;
+	long i;
+
+	for(i=0;i<n;i++)
+	{
+		f->data[(f->head + i) % f->size] = p[i];
+	}
+	f->head += n;
+}
+
+static long fifo_read(byte_fifo_t *f, unsigned char *dst, long n)
+{
+	long i;
+
+	n = n < fifo_fill(f) ? n : fifo_fill(f);
+	for(i=0;i<n;i++)
+	{
+		dst[i] = f->data[(f->tail + i) % f->size];
+	}
+	f->tail += n;
+	return n;
+}
+
+
+static void meas_run(double seconds, double interval, long rtdx, double bw, long stall, meas_reader_t *r,
+                     unsigned int *max_fill, unsigned long *pings)
+{
+	static unsigned char chunk[1 << 16];
+	byte_fifo_t fifo;
+	const meas_t *mp;
+	meas_t m;
+	double next_ping = 0, credit = 0;
+	long ms, n;
+	unsigned int seed = 99;
+
+	fifo.data = malloc(rtdx);
+	fifo.size = rtdx;
+	fifo.head = fifo.tail = 0;
+	meas_ring_init(&meas_test);
+	meas_reader_init(r);
+	memset(&m, 0, sizeof(m));
+	*max_fill = 0;
+	*pings = 0;
+	for(ms=0;ms<seconds*1000;ms++)
+	{
+		if(ms >= next_ping)						// process_SWI
+		{
+			m.seq = (*pings)++;
+			m.time_lo = ms*1000;
+			m.range = 1 + (m.seq % 100)*0.05f;
+			meas_put(&meas_test, &m);
+			next_ping += interval;
+			*max_fill = meas_fill(&meas_test) > *max_fill ? meas_fill(&meas_test) : *max_fill;
+		}
+		while((mp = meas_peek(&meas_test)) != NULL && fifo.size - fifo_fill(&fifo) >= (long)sizeof(meas_t))
+		{												// tsk_meas_drain: RTDX_write succeeds while it fits
+			fifo_write(&fifo, mp, sizeof(meas_t));
+			meas_pop(&meas_test);
+		}
+		if(ms % 20000 >= stall)					// host
+		{
+			credit += bw/1000;
+			seed = seed*1664525u + 1013904223u;
+			n = fifo_read(&fifo, chunk, (long)credit < (long)(seed >> 20) % 200 + 1 ? (long)credit : (long)(seed >> 20) % 200 + 1);
+			credit -= n;
+			credit = credit > bw ? bw : credit;
+			if(ms == 5000)
+			{
+				meas_reader_push(r, "\x13\x37\x00\xff\x4d", 5, NULL, NULL);	// line glitch between two reads
+			}
+			meas_reader_push(r, chunk, n, NULL, NULL);
+		}
+	}
+	free(fifo.data);
+}
+
+
+static int bench_meas(int argc, char **argv)
+{
+	long n = arg_int(argc, argv, "records", 1000000);
+	double interval = arg_float(argc, argv, "interval", PING_INTERVAL_MS);
+	long rtdx = arg_int(argc, argv, "rtdx", 1024);
+	double bw = arg_float(argc, argv, "bw", 10000);
+	long stall = arg_int(argc, argv, "stall", 3000);
+	double seconds = arg_float(argc, argv, "seconds", 120);
+	pthread_t prod;
+	meas_reader_t r;
+	meas_t m;
+	unsigned int max_fill;
+	unsigned long pings;
+	long got = 0, bad = 0, order = 0, p;
+	double t;
+	unsigned long long c;
+	int fail = 0;
+
+	/* lock free: both ends at full speed in two threads */
+	meas_ring_init(&meas_test);
+	t = now();
+	pthread_create(&prod, NULL, meas_producer, &n);
+	while(got < n)
+	{
+		if(!meas_get(&meas_test, &m))
+		{
+			sched_yield();
+			continue;
+		}
+		bad += !meas_valid(&m) || m.range != m.seq*0.001f || m.cycles != (unsigned int)(m.seq*2654435761u);
+		order += m.seq != (unsigned int)got;
+		got++;
+	}
+	pthread_join(prod, NULL);
+	t = now() - t;
+	printf("meas: two threads: %ld records in %.2f s (%.1f M/s), %ld out of order, %ld torn, %u lost\n",
+	       got, t, got/t*1e-6, order, bad, meas_test.lost);
+	fail |= order || bad || meas_test.lost;
+
+	meas_ring_init(&meas_test);
+	memset(&m, 0, sizeof(m));
+	c = cycles();
+	for(p=0;p<1000;p++)
+	{
+		meas_put(&meas_test, &m);
+		meas_pop(&meas_test);
+	}
+	printf("meas: meas_put + meas_pop %.0f cycles\n", (double)(cycles() - c)/1000);
+
+	/* target: ping rate vs. RTDX and a host that looks away */
+	printf("meas: %.0f s of pings every %.0f ms, RTDX buffer %ld bytes, host %.0f bytes/s, ring %d records (%.1f s)\n",
+	       seconds, interval, rtdx, bw, MEAS_RING, MEAS_RING*interval*1e-3);
+	meas_run(seconds, interval, rtdx, bw, stall, &r, &max_fill, &pings);
+	printf("meas: host away %5ld ms: %lu of %lu pings decoded, %lu missing, %lu dropped by the target, ring up to %u, %lu bytes skipped\n",
+	       stall, r.records, pings, r.gaps, r.lost, max_fill, r.skipped);
+	fail |= r.gaps != 0 || r.lost != 0 || r.skipped != 5 || (unsigned long)r.records + MEAS_RING < pings;
+	meas_run(seconds, interval, rtdx, bw, 10000, &r, &max_fill, &pings);
+	printf("meas: host away %5d ms: %lu of %lu pings decoded, %lu missing, %lu dropped by the target, ring up to %u\n",
+	       10000, r.records, pings, r.gaps, r.lost, max_fill);
+	fail |= r.gaps != r.lost || r.lost == 0;				// losses beyond the ring: counted on both sides alike
+	return fail;
+}
+
+
+/* track: a target swinging through the gate, one dropout longer than max_misses and a jump, with
+   the full gate every ping vs. the gate predicted by tracker.h (settings of sonar.c) */
+static void track_settings(tracker_t *tr)
+{
+	tr->alpha = 0.5;
+	tr->beta = 0.167;
+	tr->sigmas = 4.0;
+	tr->min_half_m = 0.05;
+	tr->max_speed = 2.0;
+	tr->min_peak = 0.3;
+	tr->max_misses = 3;
+	tracker_reset(tr);
+}
+
+static int bench_track(int argc, char **argv)
+{
+	static const short engines[] = { ENGINE_TIME, ENGINE_COARSE, ENGINE_AUTO, ENGINE_FREQUENCY };
+	static short capture[CAPTURE_LEN];
+	engine_t *e = bench_engine();
+	engine_cfg_t cfg;
+	engine_result_t res;
+	range_gate_t full;
+	tracker_t tr;
+	long pings = arg_int(argc, argv, "pings", 600);
+	double interval = arg_float(argc, argv, "interval", PING_INTERVAL_MS)*1e-3;
+	double speed = arg_float(argc, argv, "speed", 0.6);		// m/s at the middle of the swing
+	float noise = arg_float(argc, argv, "noise", 200);
+	float att = arg_float(argc, argv, "att", 0.3);
+	double tol = arg_float(argc, argv, "tol", 10);				// mm
+	double period = 20, t, range, lag, secs[2], c;
+	long p, hits[2], echoes;
+	int g, on, w, fail = 0;
+
+	bench_engine_cfg(&cfg, argc, argv);
+	full = cfg.gate;
+	printf("track: %ld pings every %.0f ms, target %.1f..%.1f m at up to %.1f m/s, no echo for pings %ld..%ld, jump of 2 m at ping %ld\n",
+	       pings, interval*1e3, 4 - speed*period/(2*PI), 4 + speed*period/(2*PI), speed, pings/4, pings/4 + 5, pings*3/4);
+	printf("track: engine      full gate [us/ping]  tracked [us/ping]  speed-up   gate hit rate  lags searched  acq/lost  cycles saved   hits full / tracked\n");
+	for(g=0;g<(int)(sizeof(engines)/sizeof(engines[0]));g++)
+	{
+		cfg.engine = engines[g];
+		for(on=0;on<2;on++)
+		{
+			track_settings(&tr);
+			secs[on] = 0;
+			hits[on] = echoes = 0;
+			for(p=0;p<pings;p++)
+			{
+				t = p*interval;
+				range = 4 + speed*period/(2*PI)*sin(2*PI*t/period) + (p >= pings*3/4 ? 2 : 0);
+				lag = range*2*SAMPLE_RATE/SPEED_OF_SOUND;
+				w = p % WAVEFORMS;
+				multipath_ping(e, w, (int)lag, (float)(lag - (int)lag), p >= pings/4 && p < pings/4 + 6 ? 0 : att,
+				               noise, 14, 2, p + 1, capture);
+				if(on)
+				{
+					tracker_gate(&tr, t, &full, &cfg.gate);
+				}
+				c = cycles();
+				secs[on] -= now();
+				engine_ping(e, &cfg, capture, w, &res);
+				secs[on] += now();
+				if(on)
+				{
+					tracker_update(&tr, t, &cfg.gate, &res);
+					tracker_cycles(&tr, (float)(cycles() - c));
+				}
+				if(p < pings/4 || p >= pings/4 + 6)
+				{
+					echoes++;
+					hits[on] += 1e3*fabs(res.range - convert_step_distance(lag)) <= tol;
+				}
+			}
+			cfg.gate = full;
+		}
+		printf("track: %-10s %12.1f %18.1f %12.1fx %11.1f%% %10.1f%%     %3lu/%-3lu %10.3g     %5.1f%% / %5.1f%%\n",
+		       engine_name[engines[g]], 1e6*secs[0]/pings, 1e6*secs[1]/pings, secs[0]/secs[1],
+		       100.0*tr.stat.hits/tr.stat.gated, 100.0*tr.stat.lags/tr.stat.lags_full, tr.stat.acquisitions, tr.stat.losses,
+		       tr.stat.cycles_saved, 100.0*hits[0]/echoes, 100.0*hits[1]/echoes);
+		fail |= hits[1] < hits[0] - echoes/50 || tr.stat.hits < tr.stat.gated*9/10 || tr.stat.losses != 2;
+		if(engines[g] == ENGINE_TIME)
+		{
+			fail |= secs[0] < 5*secs[1];				// cost proportional to the lags
+		}
+		if(engines[g] == ENGINE_AUTO)
+		{
+			fail |= secs[0] < 1.5*secs[1];				// full gate: the FFT, tracked: the time domain
+		}
+	}
+	return fail;
+}
+
+
+/* batch: two recordings (the first cut off in a record) through batch.h with 1..threads= workers, every
+   result checked against capture_replay of the same file and for ping order. Small blocks (block= KB)
+   so that many tasks integrate across the end of a block */
+typedef struct {
+	const long *base;			// global index of record 0 of each file
+	const float *range;			// capture_replay
+	const short *used;
+	const char *has;
+	long last, results, order, wrong;
+	double diff;
+} batch_check_t;
+
+static void batch_ref_sink(void *ctx, long i, const capture_rec_t *rec, const engine_result_t *res)
+{
+	batch_check_t *bc = ctx;
+	long g = bc->last + i;
+
+	((float *)bc->range)[g] = res->range;
+	((short *)bc->used)[g] = res->used;
+	((char *)bc->has)[g] = 1;
+}
+
+static void batch_check_sink(void *ctx, int file, long i, const capture_rec_t *rec, const engine_result_t *res)
+{
+	batch_check_t *bc = ctx;
+	long g = bc->base[file] + i;
+
+	bc->order += g <= bc->last;
+	bc->last = g;
+	bc->results++;
+	bc->wrong += !bc->has[g] || bc->used[g] != res->used || rec->seq != (unsigned int)g;
+	if(bc->has[g])
+	{
+		bc->diff = fmax(bc->diff, fabs(res->range - bc->range[g]));
+	}
+}
+
+static int bench_batch(int argc, char **argv)
+{
+	static const short engines[][2] = {		// engine, integrate mode
+		{ ENGINE_FREQUENCY, 0 }, { ENGINE_TIME, 0 }, { ENGINE_INTEGRATE, INTEGRATE_BLOCK }, { ENGINE_INTEGRATE, INTEGRATE_SLIDING }
+	};
+	static short capture[CAPTURE_LEN], frames[RESPONSE_LEN];
+	engine_t *e = bench_engine();
+	batch_cfg_t bc;
+	batch_stat_t st;
+	batch_check_t ck;
+	capture_file_t f;
+	capture_replay_t rs;
+	capture_rec_t rec;
+	long pings = arg_int(argc, argv, "pings", 600);
+	int max_threads = arg_int(argc, argv, "threads", 2*sysconf(_SC_NPROCESSORS_ONLN) > 8 ? 2*sysconf(_SC_NPROCESSORS_ONLN) : 8);
+	char path[2][32] = { "/tmp/sonar_batch_XXXXXX", "/tmp/sonar_batch_XXXXXX" };
+	const char *paths[2] = { path[0], path[1] };
+	long base[2], p, n[2];
+	float *range;
+	short *used;
+	char *has;
+	unsigned int rnd = 815;
+	double serial, one = 0;
+	int fd, g, i, file, threads, fail = 0;
+
+	/* recordings: pings/3 and the rest, targets still for 4 pings */
+	n[0] = pings/3;
+	n[1] = pings - n[0];
+	base[0] = 0;
+	base[1] = n[0];
+	bench_engine_cfg(&bc.cfg, argc, argv);
+	for(file=0;file<2;file++)
+	{
+		fd = mkstemp(path[file]);
+		if(fd < 0)
+		{
+			printf("batch: no temporary file\n");
+			return 1;
+		}
+		close(fd);
+		remove(path[file]);
+		for(p=base[file];p<base[file]+n[file];p++)
+		{
+			rnd = p % 4 ? rnd : rnd*1664525u + 1013904223u;
+			multipath_ping(e, p % WAVEFORMS, bc.cfg.gate.lag_lo + 8 + (int)((rnd >> 8) % 2000u), (float)((rnd >> 4) & 15)/16,
+			               0.3, 200, 14, 2, p + 1, capture);
+			capture_rec_header(&rec, p % WAVEFORMS, NULL, p, 0, (unsigned int)(p*PING_INTERVAL_MS*1000L));
+			capture_rec_pack(capture, frames);
+			capture_file_append(path[file], &rec, frames);
+		}
+	}
+	capture_file_append(path[0], &rec, frames);		// cut off in the frames of the last record
+	truncate(path[0], (long)n[0]*CAPTURE_REC_BYTES + CAPTURE_REC_BYTES/2);
+
+	range = malloc(sizeof(float)*pings);
+	used = malloc(sizeof(short)*pings);
+	has = malloc(pings);
+	printf("batch: %ld pings in 2 files (%.1f MB), %ld online CPUs, blocks of %ld KB, tasks of %ld pings\n", pings,
+	       pings*CAPTURE_REC_BYTES/1048576.0, sysconf(_SC_NPROCESSORS_ONLN), arg_int(argc, argv, "block", 1024),
+	       arg_int(argc, argv, "chunk", BATCH_CHUNK));
+	printf("batch: engine         threads  pings/s  speed-up  efficiency  steals  warm-up   results  max diff [mm]  order\n");
+	for(g=0;g<(int)(sizeof(engines)/sizeof(engines[0]));g++)
+	{
+		bc.cfg.engine = engines[g][0];
+		bc.cfg.integrate_mode = engines[g][1];
+
+		/* reference: one engine, file after file */
+		memset(has, 0, pings);
+		memset(&ck, 0, sizeof(ck));
+		ck.range = range;
+		ck.used = used;
+		ck.has = has;
+		serial = 0;
+		for(file=0;file<2;file++)
+		{
+			capture_file_open(&f, path[file]);
+			ck.last = base[file];
+			capture_replay(&f, e, &bc.cfg, batch_ref_sink, &ck, &rs);
+			serial += rs.seconds;
+			capture_file_close(&f);
+		}
+		printf("batch: %-9s %-5s  serial %8.0f\n", engine_name[engines[g][0]],
+		       engines[g][0] != ENGINE_INTEGRATE ? "" : engines[g][1] == INTEGRATE_SLIDING ? "slide" : "block", pings/serial);
+
+		for(threads=1;threads<=max_threads;threads*=2)
+		{
+			bc.threads = threads;
+			bc.chunk = arg_int(argc, argv, "chunk", 0);
+			bc.block = arg_int(argc, argv, "block", 1024)*1024;
+			bc.blocks = 0;
+			bc.setup = e;
+			memset(&ck, 0, sizeof(ck));
+			ck.base = base;
+			ck.range = range;
+			ck.used = used;
+			ck.has = has;
+			ck.last = -1;
+			i = batch_run(&bc, paths, 2, batch_check_sink, &ck, &st);
+			one = threads == 1 ? st.seconds : one;
+			for(p=0,rs.results=0;p<pings;p++)
+			{
+				rs.results += has[p];
+			}
+			printf("batch: %15s %7d %8.0f %8.2fx %10.0f%% %7ld %8ld %9ld %14.6f  %s\n", "", threads, st.pings/st.seconds,
+			       one/st.seconds, 100*one/st.seconds/(threads < sysconf(_SC_NPROCESSORS_ONLN) ? threads : sysconf(_SC_NPROCESSORS_ONLN)),
+			       st.steals, st.warmup, ck.results, 1e3*ck.diff, ck.order ? "WRONG" : "ok");
+			fail |= i != 0 || ck.order || ck.wrong || ck.results != rs.results || st.pings != pings
+			        || st.tail != CAPTURE_REC_BYTES/2 || ck.diff > 1e-5;
+		}
+	}
+	remove(path[0]);
+	remove(path[1]);
+	free(range);
+	free(used);
+	free(has);
+	return fail;
+}
+
+
+typedef struct {
+	const char *name;
+	void (*dit)(float *x, const float *w, short n);
+	void (*dif)(float *x, const float *w, short n);
+	int passes;
+} fft_kernel_t;
+
+static void rescale(float *x, int n, float g)
+{
+	int i;
+
+	for(i=0;i<n;i++)
+	{
+		x[i] *= g;
+	}
+}
+
+static int bench_radix4(int argc, char **argv)
+{
+	static float w[2*16384], in[2*16384], ref[2*16384], x[2*16384];
+	int n = arg_int(argc, argv, "n", FFT_POW2/2);
+	long reps = arg_int(argc, argv, "reps", 2000);
+	int stages = 0, k, i, fail = 0;
+	long r;
+	double base_t, t_r2 = 0;
+	unsigned long long base_c;
+	fft_kernel_t kernel[4];
+	int nkernel = 0;
+
+	for(k=n; k > 1; k >>= 1)
+	{
+		stages++;
+	}
+	if(n < 4 || (n & (n-1)) || n > 16384)
+	{
+		fprintf(stderr, "radix4: n must be a power of 2 in [4, 16384]\n");
+		return 2;
+	}
+
+	kernel[nkernel++] = (fft_kernel_t){ "radix 2    ", cfftr2_dit, icfftr2_dif, stages };
+	kernel[nkernel++] = (fft_kernel_t){ "r2^2 C     ", cfftr4_dit, icfftr4_dif, (stages+1)/2 };
+	kernel[nkernel++] = (fft_kernel_t){ "r2^2 C67x  ", cfftr4_dit_c67, icfftr4_dif_c67, (stages+1)/2 };
+#ifdef __AVX2__
+	kernel[nkernel++] = (fft_kernel_t){ "r2^2 AVX2  ", cfftr4_dit_avx2, icfftr4_dif_avx2, (stages+1)/2 };
+#endif
+
+	tw_genr2fft(w, n);
+	bit_rev(w, n>>1);
+	srand(5);
+	for(i=0;i<2*n;i++)
+	{
+		in[i] = (float)rand()/RAND_MAX - 0.5f;
+	}
+	memcpy(ref, in, 2*n*sizeof(float));
+	cfftr2_dit(ref, w, n);
+
+	/* the 1/n rescale that keeps the data bounded between reps is timed apart and removed */
+	base_t = now();
+	base_c = cycles();
+	for(r=0;r<reps;r++)
+	{
+		rescale(x, 2*n, 1.0f/n);
+	}
+	base_c = cycles()-base_c;
+	base_t = now()-base_t;
+
+	printf("radix4: %d point complex FFT, %d stages, forward + inverse, %ld reps\n", n, stages, reps);
+	for(k=0;k<nkernel;k++)
+	{
+		double t, err = 0, rt = 0;
+		unsigned long long c;
+
+		memcpy(x, in, 2*n*sizeof(float));
+		kernel[k].dit(x, w, n);
+		for(i=0;i<2*n;i++)
+		{
+			err = fmax(err, fabs(x[i]-ref[i]));
+		}
+		kernel[k].dif(x, w, n);
+		for(i=0;i<2*n;i++)
+		{
+			rt = fmax(rt, fabs(x[i]/n-in[i]));
+		}
+
+		t = now();
+		c = cycles();
+		for(r=0;r<reps;r++)
+		{
+			kernel[k].dit(x, w, n);
+			kernel[k].dif(x, w, n);
+			rescale(x, 2*n, 1.0f/n);
+		}
+		c = cycles()-c-base_c;
+		t = now()-t-base_t;
+		if(k == 0)
+		{
+			t_r2 = t;
+		}
+		/* every pass reads and writes the whole vector once */
+		printf("radix4: %s %8.2f us %9.0f cycles %5.2f x  %2d passes %7lu bytes moved  |X-X_r2| %.1e  round trip %.1e\n",
+		       kernel[k].name, 1e6*t/reps, (double)c/reps, t_r2/t, 2*kernel[k].passes,
+		       (unsigned long)(2*kernel[k].passes*2*2*n*sizeof(float)), err, rt);
+		fail |= err > 1e-3 || rt > 1e-4;
+	}
+	return fail;
+}
+
+
+/* xcorr: 16 bit time domain correlator (scalar short accumulator of the baseline vs. packed pairs) */
+static short legacy_cross_correlation_time(const short *sweep, const short *mono)
+{
+	short k,m,r_new,r_max;
+	short max_index = 0;
+
+	r_max=0;
+	for(k=0;k<SWEEP_LEN;k++)
+	{
+		r_new=0;
+		for(m=k;m<RESPONSE_MONO;m++)
+		{
+			r_new = r_new + sweep[m-k]*mono[m];
+		}
+		if (r_new > r_max)
+		{
+			r_max = r_new;
+			max_index=k;
+		}
+	}
+	return max_index;
+}
+
+static int bench_xcorr(int argc, char **argv)
+{
+	static xcorr_i16_t xc;
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN];
+	static short capture[CAPTURE_LEN];
+	static short sweep_padded[RESPONSE_MONO];		// the baseline reads sweep[m-k] up to RESPONSE_MONO-1
+	channel_t ch;
+	long pings = arg_int(argc, argv, "pings", 10);
+	int delay = arg_int(argc, argv, "delay", 700);
+	float att = arg_float(argc, argv, "att", 0.9);
+	int lags = arg_int(argc, argv, "lags", SWEEP_LEN);
+	double t, t_old = 0, t_c = 0, t_simd = 0, t_freq = 0;
+	long p, ok_old = 0, ok_c = 0, ok_simd = 0, ok_freq = 0, diff = 0;
+	int k;
+
+	if(lags < 1 || lags > RESPONSE_MONO)
+	{
+		fprintf(stderr, "xcorr: lags must be in [1, %d]\n", RESPONSE_MONO);
+		return 2;
+	}
+	xcorr_i16_init(&xc, sweep);
+	mf_template_init(&tpl, sweep, work);
+	channel_init(&ch, delay, att, 300, 11);
+	memcpy(sweep_padded, sweep, sizeof(sweep));
+
+	for(p=0;p<pings;p++)
+	{
+		capture_ping(&ch, capture);
+
+		t = now();
+		ok_old += legacy_cross_correlation_time(sweep_padded, capture) == delay;
+		t_old += now()-t;
+
+		t = now();
+		{
+			xcorr_acc_t r, r_max = 0;
+			short best = 0;
+			for(k=0;k<lags;k++)
+			{
+				r = xcorr_i16_dot_c(xc.tpl[k & 1], capture + (k & ~1), XCORR_TPL_LEN/2);
+				if(r > r_max)
+				{
+					r_max = r;
+					best = k;
+				}
+			}
+			ok_c += best == delay;
+		}
+		t_c += now()-t;
+
+		t = now();
+		ok_simd += cross_correlation_time(&xc, capture, 0, lags-1) == delay;
+		t_simd += now()-t;
+
+		t = now();
+		ok_freq += cross_correlation_frequency(capture, &tpl, work, 0, PEAK_SPAN-1) == delay;
+		t_freq += now()-t;
+
+		for(k=0;k<lags;k++)										// every lag bit identical
+		{
+			diff += xcorr_i16_dot_c(xc.tpl[k & 1], capture + (k & ~1), XCORR_TPL_LEN/2) !=
+			        xcorr_i16_dot(xc.tpl[k & 1], capture + (k & ~1), XCORR_TPL_LEN/2);
+		}
+	}
+
+	printf("xcorr: echo at lag %d, attenuation %.2f, %d lags (%.2f m)\n", delay, att, lags, convert_step_distance(lags-1));
+	printf("xcorr: baseline short accumulator %8.3f ms per ping  %ld/%ld peaks correct (lags 0..%d)\n",
+	       1e3*t_old/pings, ok_old, pings, SWEEP_LEN-1);
+	printf("xcorr: packed pairs, C            %8.3f ms per ping  %ld/%ld\n", 1e3*t_c/pings, ok_c, pings);
+	printf("xcorr: packed pairs, %-12s %8.3f ms per ping  %ld/%ld  (%.1f x baseline)\n",
+#if defined(__AVX2__)
+	       "AVX2",
+#elif defined(__SSE2__)
+	       "SSE2",
+#else
+	       "C",
+#endif
+	       1e3*t_simd/pings, ok_simd, pings, t_old/t_simd);
+	printf("xcorr: frequency domain           %8.3f ms per ping  %ld/%ld  (all %d lags)\n", 1e3*t_freq/pings, ok_freq, pings, PEAK_SPAN);
+	printf("xcorr: %ld lags differ between the C and the vector dot product\n", diff);
+	return ok_c == pings && ok_simd == pings && diff == 0 ? 0 : 1;
+}
+
+
+/* gate: range gate in metres, strong near clutter outside the gate + weaker target inside */
+static int bench_gate(int argc, char **argv)
+{
+	static xcorr_i16_t xc;
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN];
+	static short capture[CAPTURE_LEN], clutter[CAPTURE_LEN];
+	static const float width[] = { 0.1, 0.25, 0.5, 1, 2, 3.7, 8 };
+	channel_t ch_target, ch_clutter;
+	long pings = arg_int(argc, argv, "pings", 20);
+	float min_m = arg_float(argc, argv, "min", 0.3);
+	float max_m = arg_float(argc, argv, "max", 4);
+	float target_m = arg_float(argc, argv, "target", 2);
+	int target = convert_distance_step(target_m);
+	range_gate_t gate, all = { 0, PEAK_SPAN-1 };
+	long p, ok_time = 0, ok_freq = 0, ok_open = 0;
+	double t;
+	int i, w;
+
+	xcorr_i16_init(&xc, sweep);
+	mf_template_init(&tpl, sweep, work);
+	channel_init(&ch_target, target, 0.25, 300, 13);
+	channel_init(&ch_clutter, convert_distance_step(0.1), 0.7, 0, 17);
+	range_gate_set(&gate, min_m, max_m);
+
+	printf("gate: %.2f..%.2f m => lags %d..%d, target at %.2f m (lag %d), clutter at 0.10 m 3x stronger\n",
+	       min_m, max_m, gate.lag_lo, gate.lag_hi, target_m, target);
+	for(p=0;p<pings;p++)
+	{
+		capture_ping(&ch_target, capture);
+		capture_ping(&ch_clutter, clutter);
+		for(i=0;i<CAPTURE_LEN;i++)
+		{
+			int v = capture[i] + clutter[i];
+			capture[i] = v > 32767 ? 32767 : v < -32768 ? -32768 : v;
+		}
+		ok_time += abs(cross_correlation_time(&xc, capture, gate.lag_lo, gate.lag_hi) - target) <= 1;
+		ok_freq += abs(cross_correlation_frequency(capture, &tpl, work, gate.lag_lo, gate.lag_hi) - target) <= 1;
+		ok_open += abs(cross_correlation_frequency(capture, &tpl, work, all.lag_lo, all.lag_hi) - target) <= 1;
+	}
+	printf("gate: target found  time %ld/%ld  frequency %ld/%ld  without gate %ld/%ld\n",
+	       ok_time, pings, ok_freq, pings, ok_open, pings);
+
+	printf("gate: width [m]  lags   time [ms]  frequency [ms]\n");
+	for(w=0;w<(int)(sizeof(width)/sizeof(width[0]));w++)
+	{
+		range_gate_t g;
+		double t_time, t_freq;
+
+		range_gate_set(&g, 0.3, 0.3 + width[w]);
+		t = now();
+		for(p=0;p<pings;p++)
+		{
+			cross_correlation_time(&xc, capture, g.lag_lo, g.lag_hi);
+		}
+		t_time = (now()-t)/pings;
+		t = now();
+		for(p=0;p<pings;p++)
+		{
+			cross_correlation_frequency(capture, &tpl, work, g.lag_lo, g.lag_hi);
+		}
+		t_freq = (now()-t)/pings;
+		printf("gate: %9.2f  %5d  %10.3f  %14.3f\n", width[w], g.lag_hi-g.lag_lo+1, 1e3*t_time, 1e3*t_freq);
+	}
+	return ok_time == pings && ok_freq == pings ? 0 : 1;
+}
+
+
+/* coarse: two stage correlator vs. full time domain and frequency path on noisy random echoes */
+static int bench_coarse(int argc, char **argv)
+{
+	static xcorr_i16_t xc;
+	static coarse_t coarse[2];
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN];
+	static short capture[CAPTURE_LEN];
+	long pings = arg_int(argc, argv, "pings", 200);
+	float noise = arg_float(argc, argv, "noise", 2000);
+	float att = arg_float(argc, argv, "att", 0.1);
+	int lag_hi = arg_int(argc, argv, "lags", PEAK_SPAN) - 1;
+	double t, t_time = 0, t_freq = 0, t_coarse[2] = { 0, 0 };
+	long p, miss_time = 0, miss_freq = 0, miss_coarse[2] = { 0, 0 };
+	unsigned seed = 1;
+	int d, delay;
+	channel_t ch;
+
+	if(lag_hi < 0 || lag_hi >= PEAK_SPAN)
+	{
+		fprintf(stderr, "coarse: lags must be in [1, %d]\n", PEAK_SPAN);
+		return 2;
+	}
+	xcorr_i16_init(&xc, sweep);
+	coarse_init(&coarse[0], sweep, 4);
+	coarse_init(&coarse[1], sweep, 8);
+	mf_template_init(&tpl, sweep, work);
+
+	for(p=0;p<pings;p++)
+	{
+		seed = seed*1103515245 + 12345;
+		delay = (seed >> 8) % (lag_hi+1);
+		channel_init(&ch, delay, att, noise, seed);
+		capture_ping(&ch, capture);
+
+		t = now();
+		miss_time += cross_correlation_time(&xc, capture, 0, lag_hi) != delay;
+		t_time += now()-t;
+
+		t = now();
+		miss_freq += cross_correlation_frequency(capture, &tpl, work, 0, lag_hi) != delay;
+		t_freq += now()-t;
+
+		for(d=0;d<2;d++)
+		{
+			t = now();
+			miss_coarse[d] += cross_correlation_coarse(&coarse[d], &xc, capture, 0, lag_hi) != delay;
+			t_coarse[d] += now()-t;
+		}
+	}
+
+	printf("coarse: %ld pings, random lag 0..%d, attenuation %.2f, noise rms %.0f (SNR %.1f dB per sample)\n",
+	       pings, lag_hi, att, noise, 20*log10(att*SWEEP_AMPLITUDE/sqrt(2)/noise));
+	printf("coarse: time domain, all lags  %8.3f ms per ping  miss %5.1f %%\n", 1e3*t_time/pings, 100.0*miss_time/pings);
+	printf("coarse: frequency domain       %8.3f ms per ping  miss %5.1f %%\n", 1e3*t_freq/pings, 100.0*miss_freq/pings);
+	for(d=0;d<2;d++)
+	{
+		printf("coarse: coarse/fine, decim %d   %8.3f ms per ping  miss %5.1f %%  (%.1f x time domain)\n",
+		       coarse[d].decim, 1e3*t_coarse[d]/pings, 100.0*miss_coarse[d]/pings, t_time/t_coarse[d]);
+	}
+	return miss_coarse[0] > miss_time + pings/100 ? 1 : 0;
+}
+
+
+/* interp: sub-sample peak refinement on echoes at known fractional delays */
+static int bench_interp(int argc, char **argv)
+{
+	static const char *name[] = { "none", "parabolic", "gaussian", "sinc" };
+	static xcorr_i16_t xc;
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN], corr[PEAK_SPAN];
+	static short capture[CAPTURE_LEN];
+	long pings = arg_int(argc, argv, "pings", 40);
+	float noise = arg_float(argc, argv, "noise", 300);
+	int delay = arg_int(argc, argv, "delay", 1000);
+	double err_f[4] = { 0 }, err_t[4] = { 0 }, max_f[4] = { 0 }, t_f[4] = { 0 }, t_t[4] = { 0 }, t, e;
+	short k_f, k_t;
+	long p;
+	int m, fail = 0;
+	channel_t ch;
+
+	xcorr_i16_init(&xc, sweep);
+	mf_template_init(&tpl, sweep, work);
+	for(p=0;p<pings;p++)
+	{
+		channel_init(&ch, delay, 0.3, noise, 100+p);
+		ch.frac = (float)p/pings;							// 0 .. 1 sample in pings steps
+		capture_ping(&ch, capture);
+
+		k_f = cross_correlation_frequency(capture, &tpl, work, 0, PEAK_SPAN-1);
+		memcpy(corr, work, sizeof(corr));
+		k_t = cross_correlation_time(&xc, capture, delay-50, delay+50);
+
+		for(m=PEAK_NONE;m<=PEAK_SINC;m++)
+		{
+			t = now();
+			e = refine_lag_frequency(corr, k_f, m) - (delay + ch.frac);
+			t_f[m] += now()-t;
+			err_f[m] += e*e;
+			max_f[m] = fmax(max_f[m], fabs(e));
+
+			t = now();
+			e = refine_lag_time(&xc, capture, k_t, m) - (delay + ch.frac);
+			t_t[m] += now()-t;
+			err_t[m] += e*e;
+		}
+	}
+
+	printf("interp: echo at %d + 0..1 samples, noise rms %.0f, %ld pings, 1 sample = %.2f mm\n",
+	       delay, noise, pings, 1e3*convert_step_distance(1));
+	printf("interp: method      frequency rms / max [mm]   time rms [mm]   refine cost freq / time [us]\n");
+	for(m=PEAK_NONE;m<=PEAK_SINC;m++)
+	{
+		printf("interp: %-10s  %10.3f / %6.3f         %10.3f       %8.2f / %8.2f\n", name[m],
+		       1e3*convert_step_distance(sqrt(err_f[m]/pings)), 1e3*convert_step_distance(max_f[m]),
+		       1e3*convert_step_distance(sqrt(err_t[m]/pings)), 1e6*t_f[m]/pings, 1e6*t_t[m]/pings);
+	}
+	fail = !(err_f[PEAK_SINC] < err_f[PEAK_NONE] && err_t[PEAK_SINC] < err_t[PEAK_NONE]);
+	return fail;
+}
+
+
+/* cfar: several echoes in one ping, CFAR top-K against the single maximum scan */
+static int bench_cfar(int argc, char **argv)
+{
+	static const int lag[] = { 600, 1500, 2600 };
+	static const float att[] = { 0.3, 0.1, 0.05 };
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN];
+	static short capture[CAPTURE_LEN], echo[CAPTURE_LEN];
+	cfar_t cfg = { 16, 64, 6.0, CFAR_GO, CFAR_MAX_TARGETS };	// defaults of sonar.c
+	cfar_target_t target[CFAR_MAX_TARGETS];
+	long pings = arg_int(argc, argv, "pings", 50);
+	float noise = arg_float(argc, argv, "noise", 1000);
+	long reps = arg_int(argc, argv, "reps", 2000);
+	long p, r, all_found = 0, false_alarms = 0, found[3] = { 0, 0, 0 };
+	double t, t_scan, t_cfar;
+	volatile short sink;
+	int e, i, n, hit;
+	channel_t ch;
+
+	cfg.mode = strcmp(arg_str(argc, argv, "mode", "go"), "ca") ? CFAR_GO : CFAR_CA;
+	cfg.alpha = arg_float(argc, argv, "alpha", cfg.alpha);
+	mf_template_init(&tpl, sweep, work);
+
+	for(p=0;p<pings;p++)
+	{
+		for(e=0;e<3;e++)
+		{
+			channel_init(&ch, lag[e], att[e], e == 0 ? noise : 0, 31+p);
+			capture_ping(&ch, e == 0 ? capture : echo);
+			for(i=0;e && i<CAPTURE_LEN;i++)
+			{
+				int v = capture[i] + echo[i];
+				capture[i] = v > 32767 ? 32767 : v < -32768 ? -32768 : v;
+			}
+		}
+		correlate_frequency(capture, &tpl, work);
+		n = cfar_detect(&cfg, work, PEAK_SPAN, 0, PEAK_SPAN-1, target);
+
+		hit = 0;
+		for(i=0;i<n;i++)
+		{
+			int matched = 0;
+			for(e=0;e<3;e++)
+			{
+				if(abs(target[i].lag - lag[e]) <= 2)
+				{
+					matched = 1;
+					hit |= 1 << e;
+				}
+			}
+			false_alarms += !matched;
+		}
+		for(e=0;e<3;e++)
+		{
+			found[e] += (hit >> e) & 1;
+		}
+		all_found += hit == 7;
+		if(p == 0)
+		{
+			for(i=0;i<n;i++)
+			{
+				printf("cfar: ping 0 target %d: lag %4d (%.3f m) amplitude %8.4f SNR %5.1f dB\n", i, target[i].lag,
+				       convert_step_distance(target[i].lag), target[i].amplitude, 20*log10(target[i].snr));
+			}
+		}
+	}
+
+	/* cost on the last correlation: plain maximum scan of cross_correlation_frequency vs. CFAR */
+	t = now();
+	for(r=0;r<reps;r++)
+	{
+		float max_value = 0;
+		short k, max_index = 0;
+		for(k=0;k<PEAK_SPAN;k++)
+		{
+			if(work[k] > max_value)
+			{
+				max_value = work[k];
+				max_index = k;
+			}
+		}
+		sink = max_index;
+	}
+	t_scan = (now()-t)/reps;
+	t = now();
+	for(r=0;r<reps;r++)
+	{
+		sink = cfar_detect(&cfg, work, PEAK_SPAN, 0, PEAK_SPAN-1, target);
+	}
+	t_cfar = (now()-t)/reps;
+	(void)sink;
+
+	printf("cfar: %s, alpha %.1f, guard %d, train %d, echoes at lags %d/%d/%d (att %.2f/%.2f/%.2f), noise rms %.0f\n",
+	       cfg.mode == CFAR_GO ? "greatest of" : "cell averaging", cfg.alpha, cfg.guard, cfg.train,
+	       lag[0], lag[1], lag[2], att[0], att[1], att[2], noise);
+	printf("cfar: found %ld/%ld/%ld of %ld, all three in %ld pings, %ld false alarms (%.2f per ping)\n",
+	       found[0], found[1], found[2], pings, all_found, false_alarms, (double)false_alarms/pings);
+	printf("cfar: maximum scan %.2f us, CFAR %.2f us per ping (%.1f x) over %d lags\n",
+	       1e6*t_scan, 1e6*t_cfar, t_cfar/t_scan, PEAK_SPAN);
+	return found[0] == pings && found[1] == pings ? 0 : 1;
+}
+
+
+/* envelope: analytic signal from the one sided product spectrum vs. a reference Hilbert envelope */
+static int bench_envelope(int argc, char **argv)
+{
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN], corr[FFT_N];
+	static double cs[2*FFT_N], ref[FFT_N+2], hilb[PEAK_SPAN/2+1];
+	static short capture[CAPTURE_LEN];
+	long pings = arg_int(argc, argv, "pings", 200);
+	float noise = arg_float(argc, argv, "noise", 6000);
+	double err_env = 0, err_re = 0, err_approx = 0, peak, e, t, t_real = 0, t_env = 0;
+	long p, slip_real = 0, slip_env = 0, gross_real = 0, gross_env = 0, n_real = 0, n_env = 0;
+	double sq_real = 0, sq_env = 0;
+	int i, j, k, m, delay;
+	unsigned seed = 3;
+	channel_t ch;
+
+	mf_template_init(&tpl, sweep, work);
+
+	/*------ 1: one ping against the Hilbert envelope of the real correlation ------*/
+	channel_init(&ch, 1234, 0.3, 300, 5);
+	ch.frac = 0.37f;
+	capture_ping(&ch, capture);
+	correlate_frequency(capture, &tpl, work);
+	memcpy(corr, work, sizeof(corr));
+	for(k=0;k<FFT_N;k++)								// reference in double, plain DFT (any FFT_N)
+	{
+		cs[2*k] = cos(2*PI*k/FFT_N);
+		cs[2*k+1] = sin(2*PI*k/FFT_N);
+	}
+	for(k=0;k<=FFT_N/2;k++)								// X[k] of the real correlation, k = 0..N/2
+	{
+		double re = 0, im = 0;
+		for(i=0, j=0; i<FFT_N; i++, j = (j + k) % FFT_N)
+		{
+			re += corr[i]*cs[2*j];
+			im -= corr[i]*cs[2*j+1];
+		}
+		ref[2*k] = re*(k == 0 || k == FFT_N/2 ? 1 : 2)/FFT_N;	// one sided: negative frequencies zeroed
+		ref[2*k+1] = im*(k == 0 || k == FFT_N/2 ? 1 : 2)/FFT_N;
+	}
+	for(m=0;2*m<PEAK_SPAN;m++)							// analytic signal at lag 2m
+	{
+		double re = 0, im = 0;
+		for(k=0, j=0; k<=FFT_N/2; k++, j = (j + 2*m) % FFT_N)
+		{
+			re += ref[2*k]*cs[2*j] - ref[2*k+1]*cs[2*j+1];
+			im += ref[2*k]*cs[2*j+1] + ref[2*k+1]*cs[2*j];
+		}
+		hilb[m] = hypot(re, im);
+	}
+
+	correlate_envelope(capture, &tpl, work);
+	peak = 0;
+	for(m=0;2*m<PEAK_SPAN;m++)
+	{
+		peak = fmax(peak, hilb[m]);
+	}
+	for(m=0;2*m<PEAK_SPAN;m++)
+	{
+		double re = work[2*m], im = work[2*m+1], mag = hypot(re, im);
+		double a = fabs(re), b = fabs(im);
+		double approx = a > b ? 0.96043387*a + 0.39782473*b : 0.96043387*b + 0.39782473*a;
+		err_env = fmax(err_env, fabs(mag - hilb[m])/peak);
+		err_re = fmax(err_re, fabs(re - corr[2*m])/peak);
+		err_approx = fmax(err_approx, mag > 0.05*peak ? fabs(approx - mag)/mag : 0);
+	}
+	printf("envelope: vs. Hilbert reference (DFT of the %d point correlation): max |env - ref| %.1e, max |re - corr| %.1e of the peak\n",
+	       FFT_N, err_env, err_re);
+	printf("envelope: alpha max + beta min magnitude within %.1f %% of |z|\n", 100*err_approx);
+
+	/*------ 2: peak stability on weak noisy echoes ------*/
+	for(p=0;p<pings;p++)
+	{
+		float target;
+		short k_real, k_env;
+
+		seed = seed*1103515245 + 12345;
+		delay = 200 + (seed >> 8) % 3000;
+		channel_init(&ch, delay, (seed >> 20) & 1 ? 0.05 : -0.05, noise, seed);	// half of them inverted (soft reflector)
+		ch.frac = ((seed >> 4) & 255)/256.0f;
+		capture_ping(&ch, capture);
+		target = delay + ((seed >> 4) & 255)/256.0f;
+
+		t = now();
+		k_real = cross_correlation_frequency(capture, &tpl, work, 0, PEAK_SPAN-1);
+		t_real += now()-t;
+		e = fabs(refine_lag_frequency(work, k_real, PEAK_PARABOLIC) - target);
+		gross_real += e > 30;							// noise peak elsewhere
+		slip_real += e > 3 && e <= 30;					// neighbour carrier cycle
+		if(e <= 30)
+		{
+			sq_real += e*e;
+			n_real++;
+		}
+
+		t = now();
+		k_env = cross_correlation_envelope(capture, &tpl, work, 0, PEAK_SPAN-1);
+		t_env += now()-t;
+		e = fabs(refine_lag_envelope(work, k_env, PEAK_PARABOLIC) - target);
+		gross_env += e > 30;
+		slip_env += e > 3 && e <= 30;
+		if(e <= 30)
+		{
+			sq_env += e*e;
+			n_env++;
+		}
+	}
+	printf("envelope: %ld pings, echo att +/-0.05 at random fractional lags, noise rms %.0f\n", pings, noise);
+	printf("envelope:                  time/ping   cycle slips (3..30)  lost (> 30)  rms error of the rest\n");
+	printf("envelope: real part peak   %6.3f ms   %8ld           %8ld     %6.2f samples\n",
+	       1e3*t_real/pings, slip_real, gross_real, n_real ? sqrt(sq_real/n_real) : 0);
+	printf("envelope: envelope peak    %6.3f ms   %8ld           %8ld     %6.2f samples\n",
+	       1e3*t_env/pings, slip_env, gross_env, n_env ? sqrt(sq_env/n_env) : 0);
+	return err_env < 1e-3 && err_approx < 0.041 ? 0 : 1;
+}
+
+
+/* stereo: both channels through one complex transform vs. two real input correlations */
+static int bench_stereo(int argc, char **argv)
+{
+	static mf_template_t tpl;
+	static mf_stereo_t st;
+	static float work[STEREO_WORK_LEN], left[FFT_N], right[FFT_N];
+	static short capture[CAPTURE_LEN], swapped[CAPTURE_LEN];
+	long pings = arg_int(argc, argv, "pings", 200);
+	float noise = arg_float(argc, argv, "noise", 300);
+	float att = arg_float(argc, argv, "att", 0.3);
+	double t, t_two = 0, t_stereo = 0, err_corr = 0, peak = 0, e, sq_range = 0, sq_delay = 0, sq_bearing = 0;
+	double max_skew = RX_SPACING*SAMPLE_RATE/SPEED_OF_SOUND, target, bearing;
+	long p, lost = 0;
+	int i, k, delay;
+	unsigned seed = 11;
+	channel_t ch;
+	stereo_echo_t echo;
+	short k0, k1;
+
+	mf_template_init(&tpl, sweep, work);
+	mf_stereo_init(&st, &tpl);
+
+	/*------ 1: same correlations as the real input path, channel by channel ------*/
+	channel_init(&ch, 1500, att, noise, 7);
+	ch.frac = 0.25f;
+	ch.skew = -6.5f;
+	capture_ping(&ch, capture);
+	for(i=0;i<RESPONSE_MONO;i++)						// right channel on the left for correlate_frequency
+	{
+		swapped[i] = capture[CAPTURE_STRIDE+i];
+	}
+	correlate_frequency(capture, &tpl, work);
+	memcpy(left, work, sizeof(left));
+	correlate_frequency(swapped, &tpl, work);
+	memcpy(right, work, sizeof(right));
+	correlate_stereo(capture, &st, work);
+	for(k=0;k<PEAK_SPAN;k++)
+	{
+		peak = fmax(peak, fmax(fabs(left[k]), fabs(right[k])));
+	}
+	for(k=0;k<PEAK_SPAN;k++)
+	{
+		err_corr = fmax(err_corr, fmax(fabs(work[2*k] - left[k]), fabs(work[2*k+1] - right[k]))/peak);
+	}
+	printf("stereo: max |stereo - real input| %.1e of the peak over %d lags (both channels)\n", err_corr, PEAK_SPAN);
+
+	/*------ 2: ranges, inter-channel delay and bearing ------*/
+	for(p=0;p<pings;p++)
+	{
+		seed = seed*1103515245 + 12345;
+		delay = 200 + (seed >> 8) % 3000;
+		bearing = ((seed >> 4) & 1023)/1023.0*2.6 - 1.3;		// about +/- 75 degrees
+		channel_init(&ch, delay, att, noise, seed);
+		ch.frac = ((seed >> 20) & 255)/256.0f;
+		ch.skew = max_skew*sin(bearing);
+		capture_ping(&ch, capture);
+		target = delay + ch.frac;
+
+		t = now();
+		k0 = cross_correlation_frequency(capture, &tpl, work, 0, PEAK_SPAN-1);
+		refine_lag_frequency(work, k0, PEAK_SINC);
+		for(i=0;i<RESPONSE_MONO;i++)
+		{
+			swapped[i] = capture[CAPTURE_STRIDE+i];
+		}
+		k1 = cross_correlation_frequency(swapped, &tpl, work, 0, PEAK_SPAN-1);
+		refine_lag_frequency(work, k1, PEAK_SINC);
+		t_two += now()-t;
+
+		t = now();
+		cross_correlation_stereo(capture, &st, work, 0, PEAK_SPAN-1, PEAK_SINC, &echo);
+		t_stereo += now()-t;
+
+		e = fmax(fabs(echo.lag[0] - target), fabs(echo.lag[1] - target - ch.skew));
+		if(e > 3)
+		{
+			lost++;
+			continue;
+		}
+		sq_range += 0.5*((echo.lag[0] - target)*(echo.lag[0] - target) +
+		                 (echo.lag[1] - target - ch.skew)*(echo.lag[1] - target - ch.skew));
+		sq_delay += (echo.delay - ch.skew)*(echo.delay - ch.skew);
+		sq_bearing += (echo.bearing - bearing)*(echo.bearing - bearing);
+	}
+	p = pings - lost;
+	printf("stereo: %ld pings, att %.2f, noise rms %.0f per channel, hydrophones %.2f m apart (+/- %.1f samples)\n",
+	       pings, att, noise, RX_SPACING, max_skew);
+	printf("stereo: two real input correlations %.3f ms, one complex transform %.3f ms per ping (%.2f x)\n",
+	       1e3*t_two/pings, 1e3*t_stereo/pings, t_two/t_stereo);
+	printf("stereo: lost %ld, rms range error %.3f mm, rms delay error %.4f samples, rms bearing error %.3f deg\n",
+	       lost, p ? 1e3*convert_step_distance(sqrt(sq_range/p)) : 0, p ? sqrt(sq_delay/p) : 0,
+	       p ? sqrt(sq_bearing/p)*180/PI : 0);
+	return err_corr < 1e-4 && lost == 0 ? 0 : 1;
+}
+
+
+/* edma: receive transfer layout through the EDMA model, for the one shot and the streaming buffers */
+static int edma_layout(const char *name, int frames, int stride, long size)
+{
+	static short stream[2*STREAM_BLOCK > RESPONSE_LEN ? 2*STREAM_BLOCK : RESPONSE_LEN];
+	static short dst[2*STREAM_BLOCK > CAPTURE_LEN ? 2*STREAM_BLOCK : CAPTURE_LEN];
+	long i, wrong = 0, touched = 0;
+
+	for(i=0;i<frames;i++)
+	{
+		stream[2*i] = (short)(i & 0x3FFF);				// left: 0 .. 0x3FFF
+		stream[2*i+1] = (short)(0x4000 | (i & 0x3FFF));	// right: 0x4000 ..
+	}
+	for(i=0;i<size;i++)
+	{
+		dst[i] = -1;									// never written by a sample
+	}
+	if(!receive(stream, dst, frames, stride))
+	{
+		printf("edma: %-8s transfer leaves the %ld byte buffer\n", name, 2*size);
+		return 1;
+	}
+	for(i=0;i<size;i++)
+	{
+		if(i < frames)
+		{
+			wrong += dst[i] != stream[2*i];
+		}
+		else if(i >= stride && i < stride + frames)
+		{
+			wrong += dst[i] != stream[2*(i-stride)+1];
+		}
+		else
+		{
+			touched += dst[i] != -1;
+		}
+	}
+	printf("edma: %-8s %5d frames, ELEIDX %6d, FRMIDX %6d bytes: %ld samples misplaced, %ld gap entries written\n",
+	       name, frames, DEINTERLEAVE_ELEIDX(stride), DEINTERLEAVE_FRMIDX(stride), wrong, touched);
+	return wrong || touched;
+}
+
+
+static int bench_edma(int argc, char **argv)
+{
+	static short stream[RESPONSE_LEN], capture[CAPTURE_LEN], mono[XCORR_MONO_LEN];
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN];
+	edma_model_t no_reload = { 2, DEINTERLEAVE_ELECNT, RESPONSE_MONO-1, EDMA_MODEL_IDX,
+	                           DEINTERLEAVE_ELEIDX(CAPTURE_STRIDE), DEINTERLEAVE_FRMIDX(CAPTURE_STRIDE), 0 };
+	long reps = arg_int(argc, argv, "reps", 2000);
+	long r;
+	double t, t_copy;
+	int i, fail = 0;
+	channel_t ch;
+
+	fail |= edma_layout("one shot", RESPONSE_MONO, CAPTURE_STRIDE, CAPTURE_LEN);
+	fail |= edma_layout("stream", STREAM_BLOCK, STREAM_BLOCK, 2*STREAM_BLOCK);
+	printf("edma: parameter set without ELERLD rejected: %s\n", edma_model_check(&no_reload) ? "no" : "yes");
+	fail |= edma_model_check(&no_reload);
+
+	/*------ same lag from the sorted capture ------*/
+	mf_template_init(&tpl, sweep, work);
+	channel_init(&ch, 2222, 0.3, 300, 3);
+	capture_ping(&ch, capture);
+	i = cross_correlation_frequency(capture, &tpl, work, 0, PEAK_SPAN-1);
+	printf("edma: correlation of the sorted capture peaks at lag %d (echo at 2222)\n", i);
+	fail |= i != 2222;
+
+	/*------ what the CPU no longer does ------*/
+	channel_capture(&ch, sweep, SWEEP_LEN, 0, 0, stream, RESPONSE_MONO);
+	t = now();
+	for(r=0;r<reps;r++)
+	{
+		for(i=0;i<RESPONSE_MONO;i++)					// stereo_to_mono as it was
+		{
+			mono[i] = stream[2*i];
+		}
+		__asm__ volatile("" : : "r"(mono) : "memory");
+	}
+	t_copy = (now()-t)/reps;
+	printf("edma: mono copy removed: %.2f us and %d bytes of SDRAM traffic per ping (read %d, write %d)\n",
+	       1e6*t_copy, 2*RESPONSE_LEN + 2*RESPONSE_MONO, 2*RESPONSE_LEN, 2*RESPONSE_MONO);
+	printf("edma: frequency path formatting reads %d contiguous bytes instead of every second short of %d\n",
+	       2*RESPONSE_MONO, 2*RESPONSE_LEN);
+	return fail;
+}
+
+
+/* format: int16 => float conversion fused into the first FFT pass vs. the separate format loop */
+static int bench_format(int argc, char **argv)
+{
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN], ref[CORR_WORK_LEN];
+	static short capture[CAPTURE_LEN];
+	long reps = arg_int(argc, argv, "reps", 2000);
+	long r, fmt_old, fmt_new, passes;
+	double t, t_old, t_new, err = 0, peak = 0;
+	int i, exact = 1;
+	channel_t ch;
+
+	mf_template_init(&tpl, sweep, work);
+	channel_init(&ch, 1800, 0.3, 300, 21);
+	capture_ping(&ch, capture);
+
+	/*------ same spectrum as converting first ------*/
+	for(i=0;i<FFT_N;i++)
+	{
+		ref[i] = i < RESPONSE_MONO ? (float)capture[i] : 0;
+	}
+	fft_forward(&tpl.plan, ref, ref+FFT_N);
+	fft_forward_i16(&tpl.plan, capture, capture+1, 2, RESPONSE_MONO/2, work, work+FFT_N);
+	for(i=0;i<FFT_N;i++)
+	{
+		exact &= work[i] == ref[i];
+	}
+
+	/*------ old format stage (scaled, padding rewritten) + transform ------*/
+	t = now();
+	for(r=0;r<reps;r++)
+	{
+		for(i=0;i<FFT_N;i++)
+		{
+			if(i < RESPONSE_MONO)
+			{
+				work[i] = (float)capture[i]/SWEEP_AMPLITUDE;
+			}
+			else
+			{
+				work[i] = 0;
+			}
+		}
+		fft_forward(&tpl.plan, work, work+FFT_N);
+	}
+	t_old = (now()-t)/reps;
+	memcpy(ref, work, sizeof(float)*FFT_N);
+
+	t = now();
+	for(r=0;r<reps;r++)
+	{
+		fft_forward_i16(&tpl.plan, capture, capture+1, 2, RESPONSE_MONO/2, work, work+FFT_N);
+	}
+	t_new = (now()-t)/reps;
+	for(i=0;i<FFT_N;i++)
+	{
+		peak = fmax(peak, fabs(ref[i]));
+		err = fmax(err, fabs(work[i]/SWEEP_AMPLITUDE - ref[i]));
+	}
+
+	/*------ bytes stored per ping (format + forward transform) ------*/
+#ifdef FFT_MIXED_RADIX
+	passes = tpl.plan.nfactors;
+	fmt_old = 4*FFT_N;								// live region + padding
+	fmt_new = 4*FFT_N;								// same stores, no division (Stockham needs its input)
+#else
+	for(passes=0, r=FFT_N/2; r > 1; r >>= 2, passes++);
+	fmt_old = 4*FFT_N;
+	fmt_new = 0;									// the first pass writes the converted points
+#endif
+	printf("format: %d real samples of %d, %s\n", RESPONSE_MONO, FFT_N,
+	       exact ? "fused spectrum bit identical to convert + transform" : "fused spectrum DIFFERS");
+	printf("format: scale folded into the template: max deviation %.1e of the peak, %d divisions less per ping\n",
+	       err/peak, RESPONSE_MONO);
+	printf("format: stores per ping: format %ld -> %ld bytes (padding %d bytes), transform %ld passes x %d bytes\n",
+	       fmt_old, fmt_new, 4*(FFT_N-RESPONSE_MONO), passes, 4*FFT_N);
+	printf("format: format + forward FFT %.2f us -> %.2f us per ping (%.2f x)\n", 1e6*t_old, 1e6*t_new, t_old/t_new);
+	return exact && err/peak < 1e-6 ? 0 : 1;
+}
+
+
+/* sweep: linked table against the generator defaults, boot cost, and what the windows do to the sidelobes */
+static double sweep_sidelobes(const short *s, int guard)	// highest autocorrelation sidelobe, dB below the peak
+{
+	double r, r0 = 0, side = 0;
+	int k, lag;
+
+	for(lag=0;lag<SWEEP_LEN;lag++)
+	{
+		r = 0;
+		for(k=lag;k<SWEEP_LEN;k++)
+		{
+			r += (double)s[k]*s[k-lag];
+		}
+		if(lag == 0)
+			r0 = r;
+		else if(lag >= guard && fabs(r) > side)
+			side = fabs(r);
+	}
+	return 20*log10(r0/side);
+}
+
+
+static int bench_sweep(int argc, char **argv)
+{
+	static const char *name[] = { "none", "hann", "tukey" };
+	static short synth[SWEEP_LEN], copy[SWEEP_LEN];
+	sweep_param_t p;
+	long reps = arg_int(argc, argv, "reps", 200);
+	int guard = arg_int(argc, argv, "guard", 16);
+	int i, w, diff = 0;
+	long r;
+	double t, t_synth, t_copy;
+
+	sweep_param_default(&p);
+	sweep_synth(&p, synth);
+	for(i=0;i<SWEEP_LEN;i++)
+	{
+		diff += synth[i] != sweep_bank[0][i];
+	}
+	printf("sweep: sweep_table.c vs. generator defaults: %s (%d samples differ)\n",
+	       diff ? "DIFFERS, run make table" : "bit identical", diff);
+
+	t = now();
+	for(r=0;r<reps;r++)
+	{
+		sweep_synth(&p, synth);
+	}
+	t_synth = (now()-t)/reps;
+	t = now();
+	for(r=0;r<reps;r++)
+	{
+		frequency_sweep_init(copy);
+	}
+	t_copy = (now()-t)/reps;
+	printf("sweep: boot %.1f us (recursion, sin/cos/sqrt per sample) -> %.1f us (table copy)\n",
+	       1e6*t_synth, 1e6*t_copy);
+
+	for(w=SWEEP_WINDOW_NONE;w<=SWEEP_WINDOW_TUKEY;w++)
+	{
+		p.window = w;
+		sweep_synth(&p, synth);
+		printf("sweep: window %-5s  peak sidelobe %.1f dB below the peak (lags >= %d)\n",
+		       name[w], sweep_sidelobes(synth, guard), guard);
+	}
+	return diff ? 1 : 0;
+}
+
+
+/* waveform: pings every RESPONSE_MONO samples with a far target whose echo of the previous ping still
+   arrives in the current window (ghost). Same sweep every ping vs. the bank in rotation, each capture
+   correlated with the template of its own waveform */
+static void waveform_capture(const short *wave, const short *prev, int delay, float att, int ghost, float ghost_att,
+                             float noise, unsigned int seed, short *capture)
+{
+	static short stream[RESPONSE_LEN], far[RESPONSE_LEN];
+	channel_t ch;
+	int i, v;
+
+	channel_init(&ch, delay, att, noise, seed);
+	channel_capture(&ch, wave, SWEEP_LEN, 0, 0, stream, RESPONSE_MONO);
+	channel_init(&ch, ghost, ghost_att, 0, seed);
+	channel_capture(&ch, prev, SWEEP_LEN, 0, 0, far, RESPONSE_MONO);
+	for(i=0;i<RESPONSE_LEN;i++)
+	{
+		v = stream[i] + far[i];
+		stream[i] = v > 32767 ? 32767 : v < -32768 ? -32768 : v;
+	}
+	receive(stream, capture, RESPONSE_MONO, CAPTURE_STRIDE);
+}
+
+
+static int bench_waveform(int argc, char **argv)
+{
+	static mf_template_t tpl[WAVEFORMS];
+	static float work[CORR_WORK_LEN];
+	static short bank[WAVEFORMS][SWEEP_LEN], capture[CAPTURE_LEN];
+	cfar_t cfg = { 16, 64, 6.0, CFAR_GO, CFAR_MAX_TARGETS };	// defaults of sonar.c
+	cfar_target_t target[CFAR_MAX_TARGETS];
+	long pings = arg_int(argc, argv, "pings", 100);
+	int delay = arg_int(argc, argv, "delay", 1400);
+	int ghost = arg_int(argc, argv, "ghost", 600);			// far echo of the previous ping, lag in this window
+	float att = arg_float(argc, argv, "att", 0.2);
+	float ghost_att = arg_float(argc, argv, "gatt", 0.3);
+	float noise = arg_float(argc, argv, "noise", 300);
+	long p, right[2] = { 0, 0 }, ghosts[2] = { 0, 0 };
+	double t, elapsed[2] = { 0, 0 }, r, r0, e[WAVEFORMS], cross = 0;
+	int rot, w, prev, i, k, l, n;
+
+	for(w=0;w<WAVEFORMS;w++)
+	{
+		waveform_init(bank[w], w);
+		mf_template_init(&tpl[w], bank[w], work);		// cached once, as at boot
+		for(e[w]=0,i=0;i<SWEEP_LEN;i++)
+		{
+			e[w] += (double)bank[w][i]*bank[w][i];
+		}
+	}
+	for(w=1;w<WAVEFORMS;w++)					// highest cross correlation of waveform 0 with the others
+	{
+		for(l=-SWEEP_LEN+1;l<SWEEP_LEN;l++)
+		{
+			for(r=0,i=0;i<SWEEP_LEN;i++)
+			{
+				k = i+l;
+				r += k >= 0 && k < SWEEP_LEN ? (double)bank[0][i]*bank[w][k] : 0;
+			}
+			r0 = fabs(r)/sqrt(e[0]*e[w]);
+			cross = r0 > cross ? r0 : cross;
+		}
+	}
+	printf("waveform: %d waveforms, cross correlation at most %.1f dB below the peaks\n", WAVEFORMS, -20*log10(cross));
+	printf("waveform: echo lag %d, far echo of the previous ping at lag %d (%.2f vs. %.2f)\n", delay, ghost, ghost_att, att);
+
+	for(rot=0;rot<2;rot++)
+	{
+		for(p=0;p<pings;p++)
+		{
+			w = rot ? p % WAVEFORMS : 0;
+			prev = rot ? (p + WAVEFORMS - 1) % WAVEFORMS : 0;
+			waveform_capture(bank[w], bank[prev], delay, att, ghost, ghost_att, noise, 77+p, capture);
+			t = now();
+			correlate_frequency(capture, &tpl[w], work);
+			n = cfar_detect(&cfg, work, PEAK_SPAN, 0, PEAK_SPAN-1, target);
+			elapsed[rot] += now()-t;
+			right[rot] += n > 0 && abs(target[0].lag - delay) <= 2;	// strongest = the real echo
+			for(i=0;i<n;i++)
+			{
+				ghosts[rot] += abs(target[i].lag - ghost) <= 2;
+			}
+		}
+		printf("waveform: %-22s range right %5.1f%%, ghost detected %5.1f%%, %.1f us/ping\n",
+		       rot ? "bank in rotation" : "same sweep every ping", 100.0*right[rot]/pings, 100.0*ghosts[rot]/pings,
+		       1e6*elapsed[rot]/pings);
+	}
+	printf("waveform: ping period %.1f ms instead of %.1f ms until the far echo has died out (%.2f x the ping rate)\n",
+	       1e3*RESPONSE_MONO/SAMPLE_RATE, 1e3*(RESPONSE_MONO + ghost + SWEEP_LEN)/SAMPLE_RATE,
+	       (double)(RESPONSE_MONO + ghost + SWEEP_LEN)/RESPONSE_MONO);
+	return right[1] == pings && ghosts[1] == 0 && ghosts[0] > 0 ? 0 : 1;
+}
+
+
+/* integrate: coherent sum of K product spectra on a stream of weak echoes at a fixed delay,
+   each ping with its own noise. Detection = |r| maximum within 2 lags of the echo,
+   SNR = peak^2 over the mean r^2 of the lags away from it */
+static void integrate_score(const float *r, int delay, long *hit, double *snr)
+{
+	double noise = 0;
+	int i, n = 0, max = 0;
+
+	for(i=0;i<PEAK_SPAN;i++)
+	{
+		if(fabsf(r[i]) > fabsf(r[max]))
+		{
+			max = i;
+		}
+		if(abs(i - delay) > 100)
+		{
+			noise += (double)r[i]*r[i];
+			n++;
+		}
+	}
+	*hit += abs(max - delay) <= 2;
+	*snr += 10*log10((double)r[delay]*r[delay]/(noise/n));
+}
+
+
+static int bench_integrate(int argc, char **argv)
+{
+	static const struct { const char *name; short k; short mode; } cfg[] = {
+		{ "single ping   ", 1, INTEGRATE_BLOCK },
+		{ "block    K = 4", 4, INTEGRATE_BLOCK },
+		{ "block    K =16", 16, INTEGRATE_BLOCK },
+		{ "sliding  K = 4", 4, INTEGRATE_SLIDING },
+		{ "sliding  K =16", 16, INTEGRATE_SLIDING },
+	};
+	static mf_template_t tpl;
+	static integrate_t in;
+	static float work[CORR_WORK_LEN], sum[FFT_N];
+	static short capture[CAPTURE_LEN];
+	long pings = arg_int(argc, argv, "pings", 256);
+	int delay = arg_int(argc, argv, "delay", 1500);
+	float att = arg_float(argc, argv, "att", 0.01);
+	float noise = arg_float(argc, argv, "noise", 3000);
+	double snr, snr1 = 0, t, t_ping, gain16 = 0, t_naive, rate1 = 0, rate16 = 0;
+	long p, hit, outs;
+	channel_t ch;
+	int c, i;
+
+	mf_template_init(&tpl, sweep, work);
+	printf("integrate: echo at lag %d, attenuation %.3f, noise %.0f LSB, %ld pings\n", delay, att, noise, pings);
+	printf("integrate: %-14s %9s %9s %11s %12s %10s\n", "", "results", "detected", "SNR dB", "gain (ideal)", "us/ping");
+	for(c=0;c<(int)(sizeof(cfg)/sizeof(cfg[0]));c++)
+	{
+		integrate_init(&in, cfg[c].k, cfg[c].mode);
+		hit = outs = 0;
+		snr = 0;
+		t_ping = 0;
+		for(p=0;p<pings;p++)
+		{
+			channel_init(&ch, delay, att, noise, 1000+p);
+			capture_ping(&ch, capture);
+			t = now();
+			i = integrate_ping(&in, capture, &tpl, work);
+			t_ping += now()-t;
+			if(i)
+			{
+				integrate_score(work, delay, &hit, &snr);
+				outs++;
+			}
+		}
+		snr /= outs;
+		if(c == 0)
+		{
+			snr1 = snr;
+			rate1 = (double)hit/outs;
+		}
+		if(cfg[c].k == 16 && cfg[c].mode == INTEGRATE_BLOCK)
+		{
+			gain16 = snr - snr1;
+			rate16 = (double)hit/outs;
+		}
+		printf("integrate: %s %9ld %8.1f%% %11.1f %6.1f (%4.1f) %10.1f\n", cfg[c].name, outs, 100.0*hit/outs,
+		       snr, snr - snr1, 10*log10(cfg[c].k), 1e6*t_ping/pings);
+	}
+
+	/* the same sum done after K inverse transforms, for the cost */
+	t_naive = 0;
+	for(p=0;p<pings;p++)
+	{
+		channel_init(&ch, delay, att, noise, 1000+p);
+		capture_ping(&ch, capture);
+		t = now();
+		correlate_frequency(capture, &tpl, work);
+		for(i=0;i<FFT_N;i++)
+		{
+			sum[i] = (p % 16 ? sum[i] : 0) + work[i];
+		}
+		t_naive += now()-t;
+	}
+	printf("integrate: K = 16 after the IFFT (one inverse per ping): %.1f us/ping\n", 1e6*t_naive/pings);
+	return gain16 > 10*log10(16) - 3 && rate16 >= rate1 ? 0 : 1;
+}
+
+
+/* sched: ping scheduler on a simulated timer and EDMA (times in ms). Every launched ping gets its own
+   echo delay, written to its buffer at the launch (the EDMA starts at once) and correlated at the end
+   of the compute time => a buffer reused too early shows up as a wrong delay */
+typedef struct {
+	unsigned long launched, processed, overruns, dropped, wrong;
+	double rate;						// processed pings per second
+	double latency;						// ms from the launch to the result, mean
+} sched_result_t;
+
+#define SCHED_DELAY(seq) (200 + (int)((seq)*97 % 2000))
+
+
+static void sched_run(int pipelined, double interval, double capture, double compute, double duration,
+                      const mf_template_t *tpl, sched_result_t *r)
+{
+	static short buffer[PING_BUFFERS][CAPTURE_LEN];
+	static float work[CORR_WORK_LEN];
+	ping_sched_t s;
+	channel_t ch;
+	double t = 0, t_tick = 0, t_cap = HUGE_VAL, t_cpu = HUGE_VAL, launch[PING_BUFFERS], lat = 0;
+	short b;
+
+	ping_sched_init(&s, pipelined ? PING_BUFFERS : 1);
+	r->wrong = 0;
+	if(!pipelined)
+	{
+		t_tick = HUGE_VAL;							// serial: the next ping is armed after the processing
+		b = ping_sched_launch(&s);
+		launch[b] = 0;
+		t_cap = capture;
+	}
+	for(;;)
+	{
+		t = t_tick < t_cap ? t_tick : t_cap;
+		t = t < t_cpu ? t : t_cpu;
+		if(t > duration)
+		{
+			break;
+		}
+		if(t == t_cpu)								// SWI done
+		{
+			if(tpl != NULL)
+			{
+				b = s.processing;
+				r->wrong += cross_correlation_frequency(buffer[b], tpl, work, 0, PEAK_SPAN-1) != SCHED_DELAY(s.seq[b]);
+			}
+			lat += t - launch[s.processing];
+			ping_sched_end(&s);
+			t_cpu = HUGE_VAL;
+			if(!pipelined)
+			{
+				b = ping_sched_launch(&s);
+				launch[b] = t;
+				t_cap = t + capture;
+			}
+		}
+		else if(t == t_cap)							// EDMA interrupt, receive and transmit done
+		{
+			ping_sched_captured(&s);
+			t_cap = HUGE_VAL;
+		}
+		else										// PRD_ping
+		{
+			b = ping_sched_launch(&s);
+			if(b != PING_NONE)
+			{
+				launch[b] = t;
+				t_cap = t + capture;
+				if(tpl != NULL)
+				{
+					channel_init(&ch, SCHED_DELAY(s.seq[b]), 0.3, 200, s.seq[b]+1);
+					capture_ping(&ch, buffer[b]);
+				}
+			}
+			t_tick += interval;
+		}
+		if(t_cpu == HUGE_VAL && ping_sched_begin(&s) != PING_NONE)
+		{
+			t_cpu = t + compute;
+			if(!pipelined && tpl != NULL)			// serial: the one buffer is filled at its launch above
+			{
+				b = s.processing;
+				channel_init(&ch, SCHED_DELAY(s.seq[b]), 0.3, 200, s.seq[b]+1);
+				capture_ping(&ch, buffer[b]);
+			}
+		}
+	}
+	r->launched = s.launched;
+	r->processed = s.processed;
+	r->overruns = s.overruns;
+	r->dropped = s.dropped;
+	r->rate = 1e3*s.processed/duration;
+	r->latency = s.processed ? lat/s.processed : 0;
+}
+
+
+static int bench_sched(int argc, char **argv)
+{
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN];
+	double interval = arg_float(argc, argv, "interval", PING_INTERVAL_MS);
+	double capture = 1e3*RESPONSE_MONO/SAMPLE_RATE;
+	double duration = arg_float(argc, argv, "seconds", 20)*1e3;
+	double compute[] = { 5, 30, 60, 90, 120, 200 };
+	sched_result_t ser, pip;
+	unsigned long wrong = 0;
+	int i, slower = 0;
+
+	mf_template_init(&tpl, sweep, work);
+	compute[0] = arg_float(argc, argv, "compute", compute[0]);
+	printf("sched: capture %.0f ms, PRD_ping every %.0f ms, %.0f s simulated, echoes checked every ping\n",
+	       capture, interval, duration/1e3);
+	printf("sched: compute   serial pings/s   pipelined pings/s  overruns  dropped  latency ms  wrong\n");
+	for(i=0;i<(int)(sizeof(compute)/sizeof(compute[0]));i++)
+	{
+		sched_run(0, interval, capture, compute[i], duration, &tpl, &ser);
+		sched_run(1, interval, capture, compute[i], duration, &tpl, &pip);
+		printf("sched: %4.0f ms  %10.2f  %16.2f  %12lu %8lu %10.1f %8lu\n", compute[i], ser.rate, pip.rate,
+		       pip.overruns, pip.dropped, pip.latency, ser.wrong + pip.wrong);
+		wrong += ser.wrong + pip.wrong;
+		slower += pip.rate < 0.98*(ser.rate < 1e3/interval ? ser.rate : 1e3/interval);	// at most one ping per tick
+	}
+	return wrong == 0 && slower == 0 ? 0 : 1;
+}
+
+
+/* memory: hot set of the target (.databuffer) against the on-chip budget, and the relocated twiddles */
+static int bench_memory(int argc, char **argv)
+{
+	static mf_template_t tpl;
+	static float work[CORR_WORK_LEN], ref[CORR_WORK_LEN];
+	static float twiddle[FFT_TWIDDLE(FFT_N/2)];
+	static short capture[CAPTURE_LEN];
+	channel_t ch;
+	int delay = arg_int(argc, argv, "delay", 900);
+	int i, same = 1;
+	const struct { const char *name; unsigned long bytes; } hot[] = {
+		{ "FFT work array", HOT_WORK_BYTES },
+		{ "twiddle factors", HOT_TWIDDLE_BYTES },
+		{ "sweep pairs (time)", HOT_PAIRS_BYTES },
+		{ "coarse stage", HOT_COARSE_BYTES },
+		{ "alignment", ONCHIP_SLACK },
+	};
+
+	printf("memory: on-chip hot set (.databuffer -> Buffers, %d bytes)\n", ONCHIP_BYTES);
+	for(i=0;i<(int)(sizeof(hot)/sizeof(hot[0]));i++)
+	{
+		printf("memory:   %-20s %7lu bytes\n", hot[i].name, hot[i].bytes);
+	}
+	printf("memory:   %-20s %7lu bytes, %ld bytes left\n", "total", (unsigned long)HOT_BYTES,
+	       (long)ONCHIP_BYTES - (long)HOT_BYTES);
+	printf("memory: SDRAM (.processbuffer): capture %lu, sweep %lu, template %lu, stereo template %lu + work %lu bytes\n",
+	       (unsigned long)(2*L2_ROUND_SHORTS(CAPTURE_LEN)), (unsigned long)(2*L2_ROUND_SHORTS(SWEEP_LEN)),
+	       (unsigned long)sizeof(mf_template_t), (unsigned long)sizeof(mf_stereo_t),
+	       (unsigned long)(sizeof(float)*STEREO_WORK_LEN));
+
+	/* the plan reads its twiddles through the pointer only: same result after the move */
+	mf_template_init(&tpl, sweep, work);
+	channel_init(&ch, delay, 0.3, 300, 3);
+	capture_ping(&ch, capture);
+	correlate_frequency(capture, &tpl, ref);
+	fft_plan_relocate(&tpl.plan, twiddle);
+	memset(tpl.plan.twiddle_store, 0, sizeof(tpl.plan.twiddle_store));	// stale copy must not be used
+	correlate_frequency(capture, &tpl, work);
+	for(i=0;i<FFT_N;i++)
+	{
+		same &= work[i] == ref[i];
+	}
+	printf("memory: relocated twiddles: correlation %s\n", same ? "bit identical" : "DIFFERS");
+	return same && HOT_BYTES <= ONCHIP_BYTES ? 0 : 1;
+}
+
+
+typedef struct {
+	const char *name;
+	int (*run)(int argc, char **argv);
+	const char *help;
+} suite_t;
+
+static const suite_t suites[] = {
+	{ "stream",   bench_stream,   "overlap-save streaming correlation  [pings= delay= att= noise=]" },
+	{ "template", bench_template, "per ping time before/after the matched filter template  [pings= delay= noise=]" },
+	{ "rfft",     bench_rfft,     "real input transform vs. complex path on simulated echoes  [pings= noise=]" },
+	{ "radix4",   bench_radix4,   "fused radix 2^2 kernels vs. radix 2: time, cycles, passes and bytes moved  [n= reps=]" },
+	{ "xcorr",    bench_xcorr,    "16 bit time domain correlator vs. baseline and frequency path  [pings= delay= att= lags=]" },
+	{ "gate",     bench_gate,     "range gate in metres: clutter rejection and cost vs. gate width  [pings= min= max= target=]" },
+	{ "coarse",   bench_coarse,   "coarse to fine correlator: speed-up and miss rate on noisy echoes  [pings= noise= att= lags=]" },
+	{ "interp",   bench_interp,   "sub-sample peak refinement on fractional delays: error in mm and cost  [pings= noise= delay=]" },
+	{ "cfar",     bench_cfar,     "CFAR top-K detection of 3 echoes vs. the maximum scan  [pings= noise= mode=ca|go alpha= reps=]" },
+	{ "envelope", bench_envelope, "analytic signal envelope vs. Hilbert reference, peak stability vs. real part  [pings= noise=]" },
+	{ "stereo",   bench_stereo,   "both channels in one complex FFT: ranges, inter-channel delay, bearing  [pings= noise= att=]" },
+	{ "edma",     bench_edma,     "de-interleaving receive EDMA (ELEIDX/FRMIDX) checked on the transfer model  [reps=]" },
+	{ "format",   bench_format,   "int16 conversion fused into the first FFT pass: exactness, stores and time per ping  [reps=]" },
+	{ "waveform", bench_waveform, "alternating waveform bank vs. one sweep with the far echo of the last ping  [pings= delay= ghost= att= gatt= noise=]" },
+	{ "integrate",bench_integrate,"coherent sum of K product spectra: detection, SNR gain vs. sqrt(K), cost  [pings= delay= att= noise=]" },
+	{ "sched",    bench_sched,    "pipelined ping scheduler vs. serial loop on a simulated timer + EDMA  [interval= compute= seconds=]" },
+	{ "sweep",    bench_sweep,    "generated sweep table vs. generator defaults, boot cost, window sidelobes  [reps= guard=]" },
+	{ "e2e",      bench_e2e,      "engine.c end to end on multipath, noise and codec steps: pings/s, stage times, range error  [pings= noise= att= bits= paths= min= max= tol=]" },
+	{ "replay",   bench_replay,   "recorded pings (file=, else simulated) through every engine, as fast as possible  [file= make= pings= engine= min= max= tol=]" },
+	{ "profile",  bench_profile,  "cycles per stage from the profile.h probes (make PROFILE=1): min/avg/max, histogram  [pings= engine=]" },
+	{ "meas",     bench_meas,     "measurement ring: two threads lock free, then ping rate vs. RTDX with host stalls  [records= interval= rtdx= bw= stall= seconds=]" },
+	{ "track",    bench_track,    "alpha-beta tracker: predicted gate vs. full gate per engine, hit rate, lags and cycles saved  [pings= interval= speed= noise= att= tol= min= max=]" },
+	{ "batch",    bench_batch,    "recordings on every core (batch.h): results vs. capture_replay, ping order, pings/s per thread count  [pings= threads= block= chunk=]" },
+	{ "memory",   bench_memory,   "on-chip hot set vs. its budget, result with the twiddles moved out of the plan  [delay=]" },
+	{ "sizes",    bench_sizes,    "derived transform size and its per ping time (make MIXED=1 for 2/3/5 sizes)  [pings= delay=]" },
+};
+
+
+int main(int argc, char **argv)
+{
+	unsigned int i;
+
+	frequency_sweep_init(sweep);
+
+	if(argc >= 2)
+	{
+		for(i=0;i<sizeof(suites)/sizeof(suites[0]);i++)
+		{
+			if(strcmp(argv[1], suites[i].name) == 0)
+			{
+				return suites[i].run(argc-2, argv+2);
+			}
+		}
+	}
+
+	printf("usage: sonar_bench <suite> [key=value ...]\n");
+	for(i=0;i<sizeof(suites)/sizeof(suites[0]);i++)
+	{
+		printf("  %-10s %s\n", suites[i].name, suites[i].help);
+	}
+	return argc >= 2 ? 1 : 0;
+}
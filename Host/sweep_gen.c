@@ -0,0 +1,155 @@
+/***********************************************************
+*  sweep_gen.c                                             *
+*                                                          *
+*  Writes the sent sweeps as a const table for the target  *
+*  (../Sonar/sweep_table.c), one waveform of the bank per  *
+*  parameter file, with one "key = value" per line and #   *
+*  comments (see sweep.params). Keys not in the file keep  *
+*  the defaults of sweep_synth.h, an empty file gives the  *
+*  sweep of the first release.                             *
+*                                                          *
+*  usage: sweep_gen <params> [<params> ...]                *
+*         > ../Sonar/sweep_table.c                         *
+*                                                          *
+************************************************************/
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sweep_synth.h"
+
+#define LINE_MAX_LEN 256
+#define PER_LINE 12				// values per line of the table
+#define WAVEFORMS_MAX 8
+
+
+static char *trim(char *s)
+{
+	char *end;
+
+	while(isspace((unsigned char)*s))
+	{
+		s++;
+	}
+	end = s + strlen(s);
+	while(end > s && isspace((unsigned char)end[-1]))
+	{
+		*--end = '\0';
+	}
+	return s;
+}
+
+
+static int read_params(const char *path, sweep_param_t *p)
+{
+	FILE *f;
+	char line[LINE_MAX_LEN], *eq, *hash;
+	int n = 0, ok = 1;
+
+	f = fopen(path, "r");
+	if(f == NULL)
+	{
+		fprintf(stderr, "sweep_gen: cannot open %s\n", path);
+		return 0;
+	}
+	while(fgets(line, sizeof(line), f) != NULL)
+	{
+		n++;
+		hash = strchr(line, '#');
+		if(hash != NULL)
+		{
+			*hash = '\0';
+		}
+		if(*trim(line) == '\0')
+		{
+			continue;
+		}
+		eq = strchr(line, '=');
+		if(eq == NULL)
+		{
+			fprintf(stderr, "sweep_gen: %s:%d: expected key = value\n", path, n);
+			ok = 0;
+			continue;
+		}
+		*eq = '\0';
+		if(!sweep_param_set(p, trim(line), trim(eq+1)))
+		{
+			fprintf(stderr, "sweep_gen: %s:%d: bad key or value '%s'\n", path, n, trim(line));
+			ok = 0;
+		}
+	}
+	fclose(f);
+	return ok;
+}
+
+
+int main(int argc, char **argv)
+{
+	static const char *window[] = { "none", "hann", "tukey" };
+	sweep_param_t p[WAVEFORMS_MAX];
+	short *sweep[WAVEFORMS_MAX];
+	int k, w, n = argc-1;
+
+	if(n < 1 || n > WAVEFORMS_MAX)
+	{
+		fprintf(stderr, "usage: sweep_gen <params> [<params> ...] > ../Sonar/sweep_table.c  (up to %d)\n", WAVEFORMS_MAX);
+		return 1;
+	}
+	for(w=0;w<n;w++)
+	{
+		sweep_param_default(&p[w]);
+		if(!read_params(argv[w+1], &p[w]))
+		{
+			return 1;
+		}
+		if(p[w].length != p[0].length || p[w].sample_rate != p[0].sample_rate || p[w].amplitude != p[0].amplitude)
+		{
+			fprintf(stderr, "sweep_gen: %s: length, sample_rate and amplitude must be the same for all waveforms\n", argv[w+1]);
+			return 1;
+		}
+		sweep[w] = malloc(p[w].length*sizeof(short));
+		if(sweep[w] == NULL || !sweep_synth(&p[w], sweep[w]))
+		{
+			fprintf(stderr, "sweep_gen: %s: parameters give no sweep\n", argv[w+1]);
+			return 1;
+		}
+	}
+
+	printf("/***********************************************************\n");
+	printf("*  sweep_table.c                                           *\n");
+	printf("*                                                          *\n");
+	printf("*  GENERATED by Host/sweep_gen, do not edit:               *\n");
+	printf("*    make -C Host table [PARAMS=<files>]                   *\n");
+	printf("*                                                          *\n");
+	printf("************************************************************/\n");
+	for(w=0;w<n;w++)
+	{
+		printf("/* %d: sample_rate %g, f_start %g, f_step %g, amplitude %g, length %d, mirror %d, window %s",
+		       w, p[w].sample_rate, p[w].f_start, p[w].f_step, p[w].amplitude, p[w].length, p[w].mirror, window[p[w].window]);
+		if(p[w].window == SWEEP_WINDOW_TUKEY)
+		{
+			printf(", taper %g", p[w].taper);
+		}
+		printf(" */\n");
+	}
+	printf("#include \"sonar_params.h\"\n");
+	printf("#include \"sweep.h\"\n\n");
+	printf("#if WAVEFORMS != %d || SWEEP_LEN != %d || SAMPLE_RATE != %g || SWEEP_AMPLITUDE != %g\n",
+	       n, p[0].length, p[0].sample_rate, p[0].amplitude);
+	printf("#error \"sweep_table.c was generated for another WAVEFORMS / SWEEP_LEN / SAMPLE_RATE / SWEEP_AMPLITUDE, run sweep_gen again\"\n");
+	printf("#endif\n\n");
+	printf("#pragma DATA_SECTION(sweep_bank, \".processbuffer\");\t\t// read once at boot (placement.h)\n");
+	printf("const short sweep_bank[WAVEFORMS][SWEEP_LEN] = {");
+	for(w=0;w<n;w++)
+	{
+		printf("\n{");
+		for(k=0;k<p[w].length;k++)
+		{
+			printf("%s%d%s", k % PER_LINE ? " " : "\n\t", sweep[w][k], k < p[w].length-1 ? "," : "");
+		}
+		printf("\n}%s", w < n-1 ? "," : "");
+		free(sweep[w]);
+	}
+	printf("\n};\n");
+	return 0;
+}
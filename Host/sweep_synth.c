@@ -0,0 +1,139 @@
+/***********************************************************
+*  sweep_synth.c                                           *
+*                                                          *
+*  Sweep recursion of frequency_sweep_init (first release) *
+*  with its constants as parameters. The expressions and   *
+*  their float / double types are kept as they were, any   *
+*  change there moves the default table by an LSB.         *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sonar_params.h"
+#include "sweep_synth.h"
+
+
+void sweep_param_default(sweep_param_t *p)
+{
+	p->sample_rate = SAMPLE_RATE;
+	p->f_start = 1000;
+	p->f_step = 6.25;
+	p->amplitude = SWEEP_AMPLITUDE;
+	p->length = SWEEP_LEN;
+	p->mirror = 1;
+	p->window = SWEEP_WINDOW_NONE;
+	p->taper = 0.1;
+}
+
+
+int sweep_param_set(sweep_param_t *p, const char *key, const char *value)
+{
+	char *end;
+	double v;
+
+	if(strcmp(key, "window") == 0)
+	{
+		if(strcmp(value, "none") == 0)
+			p->window = SWEEP_WINDOW_NONE;
+		else if(strcmp(value, "hann") == 0)
+			p->window = SWEEP_WINDOW_HANN;
+		else if(strcmp(value, "tukey") == 0)
+			p->window = SWEEP_WINDOW_TUKEY;
+		else
+			return 0;
+		return 1;
+	}
+
+	v = strtod(value, &end);
+	if(end == value || *end != '\0')
+	{
+		return 0;
+	}
+	if(strcmp(key, "sample_rate") == 0)
+		p->sample_rate = v;
+	else if(strcmp(key, "f_start") == 0)
+		p->f_start = v;
+	else if(strcmp(key, "f_step") == 0)
+		p->f_step = v;
+	else if(strcmp(key, "amplitude") == 0)
+		p->amplitude = v;
+	else if(strcmp(key, "length") == 0)
+		p->length = (int)v;
+	else if(strcmp(key, "mirror") == 0)
+		p->mirror = v != 0;
+	else if(strcmp(key, "taper") == 0)
+		p->taper = v;
+	else
+		return 0;
+	return 1;
+}
+
+
+static float sweep_window(const sweep_param_t *p, int k)		// symmetric over the whole length
+{
+	double m = p->length - 1;
+	double r = p->taper*m/2;					// tukey: samples of each ramp
+
+	if(p->window == SWEEP_WINDOW_HANN)
+	{
+		return 0.5 - 0.5*cos(2*PI*k/m);
+	}
+	if(k > m/2)
+	{
+		k = p->length-1-k;
+	}
+	if(k < r)
+	{
+		return 0.5 - 0.5*cos(PI*k/r);
+	}
+	return 1;
+}
+
+
+int sweep_synth(const sweep_param_t *p, short *sweep)
+{
+	int k, half;
+	float factor;
+	float omega;
+	float value[3];
+	float buf;
+	float amplitude = p->amplitude;			// SWEEP_AMPLITUDE*value was an int * float product
+
+	if(p->length < 4 || p->sample_rate <= 0 || p->amplitude <= 0 || p->amplitude > 32767
+	   || p->taper < 0 || p->taper > 1 || (p->mirror && (p->length & 1)))
+	{
+		return 0;
+	}
+	half = p->mirror ? p->length/2 : p->length;
+
+	value[0]=1;
+	value[1]=2*cos(2*PI*(p->f_start+p->f_step)/p->sample_rate)*sin(2*PI*(p->f_start+p->f_step)/p->sample_rate);
+	for(k=0;k<p->length;k++)
+	{
+		if(k>1 && k<half)
+		{
+			omega = 2*PI*(p->f_start+k*p->f_step)/p->sample_rate;
+			factor = sin(omega)/sqrt(value[1]*value[1]+value[0]*value[0]-2*value[0]*value[1]*cos(omega));
+			value[2] = factor*(2*cos(omega)*value[1]-value[0]);
+			buf=amplitude*value[2];
+			value[0] = value[1];
+			value[1] = value[2];
+		}
+		else if(k<2)
+		{
+			buf=amplitude*value[k];
+		}
+		else
+		{
+			sweep[k] = sweep[p->length-k-1];
+			continue;
+		}
+		if(p->window != SWEEP_WINDOW_NONE)
+		{
+			buf *= sweep_window(p, k);
+		}
+		sweep[k]=(short)buf;
+	}
+	return 1;
+}
@@ -0,0 +1,37 @@
+/***********************************************************
+*  sweep_synth.h                                           *
+*                                                          *
+*  Parametrised version of the sweep recursion of the      *
+*  first release (see freq_sweep.html), used by sweep_gen  *
+*  to write ../Sonar/sweep_table.c. The defaults give the  *
+*  original sweep bit for bit.                             *
+*                                                          *
+************************************************************/
+#ifndef SWEEP_SYNTH_H_
+#define SWEEP_SYNTH_H_
+
+#define SWEEP_WINDOW_NONE 0
+#define SWEEP_WINDOW_HANN 1
+#define SWEEP_WINDOW_TUKEY 2
+
+typedef struct {
+	double sample_rate;		// Hz
+	double f_start;			// Hz, frequency of sample 0
+	double f_step;			// Hz per sample
+	double amplitude;		// peak value before the window
+	int    length;			// samples
+	int    mirror;			// 1: second half = first half backwards (up + down sweep)
+	int    window;			// SWEEP_WINDOW_...
+	double taper;			// tukey: tapered fraction of the length (both ends together, 0..1)
+} sweep_param_t;
+
+void sweep_param_default(sweep_param_t *p);		// the sweep of sonar_params.h
+
+/* key = value (sample_rate, f_start, f_step, amplitude, length, mirror, window, taper),
+   returns 0 for an unknown key or value */
+int sweep_param_set(sweep_param_t *p, const char *key, const char *value);
+
+/* p->length samples, returns 0 if the parameters make no sweep */
+int sweep_synth(const sweep_param_t *p, short *sweep);
+
+#endif /*SWEEP_SYNTH_H_*/
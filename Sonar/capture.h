@@ -0,0 +1,39 @@
+/***********************************************************
+*  capture.h                                               *
+*                                                          *
+*  Layout of the received samples after the EDMA: the      *
+*  McBSP delivers left, right, left, right ... and the     *
+*  receive channel sorts them into one contiguous block    *
+*  per channel with its destination indexes, so no CPU     *
+*  copy is needed and the correlators read unit stride.    *
+*                                                          *
+*  Frames of 2 elements (left, right), destination in      *
+*  index mode (DUM = IDX):                                 *
+*    ELEIDX : left sample  => right sample of the frame    *
+*    FRMIDX : right sample => next left sample             *
+*  both in bytes, signed 16 bit.                           *
+*                                                          *
+************************************************************/
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+#include "sonar_params.h"
+#include "xcorr_i16.h"
+
+/* Buffer_in: [ left RESPONSE_MONO | zeros | right RESPONSE_MONO ]
+   the zeros behind the left channel are the tail the time domain correlator reads (XCORR_MONO_LEN),
+   written once at init, the EDMA never touches them */
+#define CAPTURE_STRIDE XCORR_MONO_LEN					// shorts from a left sample to its right sample
+#define CAPTURE_LEN (CAPTURE_STRIDE + RESPONSE_MONO)
+#define CAPTURE_RIGHT(capture) ((capture) + CAPTURE_STRIDE)
+
+/* index values for channels stride shorts apart */
+#define DEINTERLEAVE_ELECNT 2							// elements per frame (one stereo sample)
+#define DEINTERLEAVE_ELEIDX(stride) (2*(stride))		// bytes
+#define DEINTERLEAVE_FRMIDX(stride) (2 - 2*(stride))	// bytes, back to the left channel, one sample further
+
+#if DEINTERLEAVE_ELEIDX(CAPTURE_STRIDE) > 32767 || DEINTERLEAVE_ELEIDX(STREAM_BLOCK) > 32767
+#error "channel stride too large for the 16 bit EDMA indexes"
+#endif
+
+#endif /*CAPTURE_H_*/
@@ -0,0 +1,81 @@
+/***********************************************************
+*  capture_rec.c                                           *
+*                                                          *
+*  Recording format of raw captures (portable C)           *
+*                                                          *
+************************************************************/
+#include "capture_rec.h"
+#include "capture.h"
+
+
+void capture_rec_header(capture_rec_t *rec, short sweep_id, const unsigned short *aic23,
+                        unsigned int seq, unsigned int time_hi, unsigned int time_lo)
+{
+	int i;
+
+	rec->magic = CAPTURE_REC_MAGIC;
+	rec->version = CAPTURE_REC_VERSION;
+	rec->header = CAPTURE_REC_HEADER;
+	rec->sample_rate = SAMPLE_RATE;
+	rec->frames = RESPONSE_MONO;
+	rec->sweep_id = sweep_id;
+	rec->channels = 2;
+	for(i=0;i<CAPTURE_REC_AIC23;i++)
+	{
+		rec->aic23[i] = aic23 ? aic23[i] : 0;
+	}
+	rec->seq = seq;
+	rec->time_hi = time_hi;
+	rec->time_lo = time_lo;
+	for(i=0;i<6;i++)
+	{
+		rec->reserved[i] = 0;
+	}
+}
+
+
+unsigned int capture_rec_size(const capture_rec_t *rec)
+{
+	if(rec->magic != CAPTURE_REC_MAGIC || rec->header < CAPTURE_REC_HEADER || (rec->header & 3)
+	   || rec->channels != 2)
+	{
+		return 0;
+	}
+	return rec->header + 4*rec->frames;			// later versions: longer header, same frames
+}
+
+
+int capture_rec_fits(const capture_rec_t *rec)
+{
+	return rec->sample_rate == SAMPLE_RATE && rec->frames == RESPONSE_MONO;
+}
+
+
+void capture_rec_pack(const short *capture, short *frames)
+{
+	const short *right = CAPTURE_RIGHT(capture);
+	int i;
+
+	for(i=0;i<RESPONSE_MONO;i++)
+	{
+		frames[2*i] = capture[i];
+		frames[2*i+1] = right[i];
+	}
+}
+
+
+void capture_rec_unpack(const short *frames, short *capture)
+{
+	short *right = CAPTURE_RIGHT(capture);
+	int i;
+
+	for(i=0;i<RESPONSE_MONO;i++)
+	{
+		capture[i] = frames[2*i];
+		right[i] = frames[2*i+1];
+	}
+	for(i=RESPONSE_MONO;i<CAPTURE_STRIDE;i++)		// as written at init on the target
+	{
+		capture[i] = 0;
+	}
+}
@@ -0,0 +1,62 @@
+/***********************************************************
+*  capture_rec.h                                           *
+*                                                          *
+*  Recording format of raw captures (field data => host    *
+*  replay). A recording is a plain sequence of records,    *
+*  one per ping:                                           *
+*                                                          *
+*    capture_rec_t   CAPTURE_REC_HEADER bytes              *
+*    frames x { left, right }   int16, interleaved         *
+*                                                          *
+*  No file header and no index: records can be appended    *
+*  (or recordings concatenated) at any time, a memory      *
+*  dump of the target's record store is a valid file, and  *
+*  a mapped file is walked with capture_rec_size. All      *
+*  fields are little endian (C6713 DSK and x86), 32 bit    *
+*  values 4 byte aligned, the frames 4 byte aligned.       *
+*                                                          *
+************************************************************/
+#ifndef CAPTURE_REC_H_
+#define CAPTURE_REC_H_
+
+#include "sonar_params.h"
+
+#define CAPTURE_REC_MAGIC 0x43524E53	// "SNRC" in a little endian file
+#define CAPTURE_REC_VERSION 1
+#define CAPTURE_REC_HEADER 64			// bytes, also the offset of the frames
+#define CAPTURE_REC_AIC23 10			// registers of the codec (config_AIC23.c)
+
+/* unsigned int / short: 32 / 16 bit on the C6000 and on the host (long is 40 bit on the C6000) */
+typedef struct {
+	unsigned int magic;					// CAPTURE_REC_MAGIC
+	unsigned short version;				// CAPTURE_REC_VERSION
+	unsigned short header;				// CAPTURE_REC_HEADER (newer versions may append fields)
+	unsigned int sample_rate;			// Hz per channel
+	unsigned int frames;				// stereo frames behind the header
+	unsigned short sweep_id;			// waveform of the ping (sweep_bank index)
+	unsigned short channels;			// 2
+	unsigned short aic23[CAPTURE_REC_AIC23];	// gain (0, 1: line in volume), sample rate (8) ...
+	unsigned int seq;					// ping number since boot
+	unsigned int time_hi;				// timestamp in microseconds since boot (target) or 1970 (host)
+	unsigned int time_lo;
+	unsigned short reserved[6];			// 0
+} capture_rec_t;
+
+typedef char capture_rec_size_check[sizeof(capture_rec_t) == CAPTURE_REC_HEADER ? 1 : -1];
+
+/* bytes of one ping as recorded by this build */
+#define CAPTURE_REC_BYTES (CAPTURE_REC_HEADER + 4*RESPONSE_MONO)
+
+void capture_rec_header(capture_rec_t *rec, short sweep_id, const unsigned short *aic23,
+                        unsigned int seq, unsigned int time_hi, unsigned int time_lo);	// frames = RESPONSE_MONO
+
+/* record size in bytes (header + frames), 0 if rec is not a valid record header */
+unsigned int capture_rec_size(const capture_rec_t *rec);
+
+/* 1 if the frames of rec can be processed by this build (sample rate and length) */
+int capture_rec_fits(const capture_rec_t *rec);
+
+void capture_rec_pack(const short *capture, short *frames);		// Buffer_in layout (capture.h) => interleaved
+void capture_rec_unpack(const short *frames, short *capture);	// interleaved => Buffer_in layout, zero tail included
+
+#endif /*CAPTURE_REC_H_*/
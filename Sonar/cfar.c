@@ -0,0 +1,182 @@
+/***********************************************************
+*  cfar.c                                                  *
+*                                                          *
+*  Multi target CFAR detection (portable C)                *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include "cfar.h"
+
+#ifdef _TMS320C6X
+#define ABSF(x) _fabsf(x)			// ABSSP, single precision
+#else
+#define ABSF(x) fabsf(x)
+#endif
+
+
+static int cfar_local_max(const float *r, short n, short k, short guard)
+{
+	int i, lo, hi;
+	float a = ABSF(r[k]);
+
+	lo = k - guard < 0 ? 0 : k - guard;
+	hi = k + guard >= n ? n-1 : k + guard;
+	for(i=lo;i<=hi;i++)
+	{
+		if(ABSF(r[i]) > a || (ABSF(r[i]) == a && i < k))	// first of equal values wins
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+
+static int cfar_keep(cfar_target_t *target, int count, int max_targets, short k, float r_k, float snr)
+{
+	float a = ABSF(r_k);
+	int i;
+
+	for(i=count; i > 0 && ABSF(target[i-1].amplitude) < a; i--)	// insertion, strongest first
+	{
+		if(i < max_targets)
+		{
+			target[i] = target[i-1];
+		}
+	}
+	if(i < max_targets)
+	{
+		target[i].lag = k;
+		target[i].amplitude = r_k;
+		target[i].snr = snr;
+		if(count < max_targets)
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+
+int cfar_detect(const cfar_t *cfg, const float *r, short n, short lag_lo, short lag_hi, cfar_target_t *target)
+{
+	int i, k, count, n_lag, n_lead, max_targets, in_lo, in_hi;
+	float sum_lag, sum_lead, noise, a, lag_mean, lead_mean, thr;
+	short g = cfg->guard, w = cfg->train;
+
+	max_targets = cfg->max_targets > CFAR_MAX_TARGETS ? CFAR_MAX_TARGETS : cfg->max_targets;
+	thr = cfg->alpha/w;								// a > alpha x mean = thr x sum: the only division
+	in_lo = g + w;									// from here both windows are inside 0..n-1
+	in_hi = n - g - w - 2;							// up to here they still are after the slide
+
+	/*------ Windows of the first cell ------*/
+	/* lag side: k-g-w .. k-g-1, lead side: k+g+1 .. k+g+w, clipped to 0..n-1 */
+	sum_lag = 0;
+	n_lag = 0;
+	sum_lead = 0;
+	n_lead = 0;
+	for(i=lag_lo-g-w;i<lag_lo-g;i++)
+	{
+		if(i >= 0 && i < n)
+		{
+			sum_lag += ABSF(r[i]);
+			n_lag++;
+		}
+	}
+	for(i=lag_lo+g+1;i<=lag_lo+g+w;i++)
+	{
+		if(i >= 0 && i < n)
+		{
+			sum_lead += ABSF(r[i]);
+			n_lead++;
+		}
+	}
+
+	/*------ One pass over the gate ------*/
+	count = 0;
+	k = lag_lo;
+	while(k <= lag_hi)
+	{
+		if(k >= in_lo && k <= in_hi)
+		{
+			/* both windows full, no clipping: two add/sub pairs, one multiply and one compare per lag,
+			   the mode decided once (no branch in the loop but the rare detections) */
+			i = lag_hi < in_hi ? lag_hi : in_hi;
+			if(cfg->mode == CFAR_GO)
+			{
+				for(;k<=i;k++)
+				{
+					noise = sum_lag > sum_lead ? sum_lag : sum_lead;
+					if(ABSF(r[k]) > thr*noise && cfar_local_max(r, n, k, g))
+					{
+						count = cfar_keep(target, count, max_targets, k, r[k], ABSF(r[k])*w/noise);
+					}
+					sum_lag += ABSF(r[k-g]) - ABSF(r[k-g-w]);
+					sum_lead += ABSF(r[k+g+w+1]) - ABSF(r[k+g+1]);
+				}
+			}
+			else
+			{
+				for(;k<=i;k++)
+				{
+					noise = 0.5f*(sum_lag + sum_lead);
+					if(ABSF(r[k]) > thr*noise && cfar_local_max(r, n, k, g))
+					{
+						count = cfar_keep(target, count, max_targets, k, r[k], ABSF(r[k])*w/noise);
+					}
+					sum_lag += ABSF(r[k-g]) - ABSF(r[k-g-w]);
+					sum_lead += ABSF(r[k+g+w+1]) - ABSF(r[k+g+1]);
+				}
+			}
+			n_lag = w;
+			n_lead = w;
+			continue;
+		}
+
+		/* close to 0 or n: one sided or shorter windows */
+		a = ABSF(r[k]);
+		lag_mean = n_lag ? sum_lag/n_lag : 0;
+		lead_mean = n_lead ? sum_lead/n_lead : 0;
+		if(cfg->mode == CFAR_GO || n_lag == 0 || n_lead == 0)
+		{
+			noise = lag_mean > lead_mean ? lag_mean : lead_mean;
+		}
+		else
+		{
+			noise = (sum_lag + sum_lead)/(n_lag + n_lead);
+		}
+		noise *= w;
+		if(a > thr*noise && cfar_local_max(r, n, k, g))
+		{
+			count = cfar_keep(target, count, max_targets, k, r[k], noise > 0 ? a*w/noise : 1e30f);
+		}
+
+		/* slide both windows by one cell */
+		i = k-g;									// enters the lag window
+		if(i >= 0 && i < n)
+		{
+			sum_lag += ABSF(r[i]);
+			n_lag++;
+		}
+		i = k-g-w;									// leaves it
+		if(i >= 0 && i < n)
+		{
+			sum_lag -= ABSF(r[i]);
+			n_lag--;
+		}
+		i = k+g+1;									// leaves the lead window
+		if(i >= 0 && i < n)
+		{
+			sum_lead -= ABSF(r[i]);
+			n_lead--;
+		}
+		i = k+g+w+1;								// enters it
+		if(i >= 0 && i < n)
+		{
+			sum_lead += ABSF(r[i]);
+			n_lead++;
+		}
+		k++;
+	}
+	return count;
+}
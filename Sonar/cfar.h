@@ -0,0 +1,49 @@
+/***********************************************************
+*  cfar.h                                                  *
+*                                                          *
+*  Multi target detection on the correlation output        *
+*                                                          *
+*  Cell averaging CFAR on |r|: for every lag of the gate   *
+*  the noise level is the mean of |r| over train cells on  *
+*  each side, guard cells away from the cell under test.   *
+*  Both windows are running sums => one pass, a few adds   *
+*  per lag like the plain maximum search.                  *
+*                                                          *
+*  CFAR_CA  noise = mean of both windows                   *
+*  CFAR_GO  noise = the larger of the two means (greatest  *
+*           of, no false alarms at the edge of a strong    *
+*           echo or of the clutter close to the sonar)     *
+*                                                          *
+*  A detection must exceed alpha x noise and be the        *
+*  largest |r| within +/- guard (one detection per echo:   *
+*  the correlation oscillates at the sweep frequencies).   *
+*  The strongest max_targets detections are kept.          *
+*                                                          *
+************************************************************/
+#ifndef CFAR_H_
+#define CFAR_H_
+
+#define CFAR_MAX_TARGETS 8
+
+#define CFAR_CA 0
+#define CFAR_GO 1
+
+typedef struct {
+	short guard;			// cells skipped on each side of the cell under test (>= half the main lobe)
+	short train;			// cells averaged on each side
+	float alpha;			// threshold factor over the noise level
+	short mode;				// CFAR_CA or CFAR_GO
+	short max_targets;		// <= CFAR_MAX_TARGETS
+} cfar_t;
+
+typedef struct {
+	short lag;				// array index of the echo (as cross_correlation_*)
+	float amplitude;		// correlation value at lag
+	float snr;				// |amplitude| / noise level (linear)
+} cfar_target_t;
+
+/* r: correlation values 0..n-1 (all may be used as training cells), detection in lag_lo..lag_hi.
+   Returns the number of targets, strongest first */
+int cfar_detect(const cfar_t *cfg, const float *r, short n, short lag_lo, short lag_hi, cfar_target_t *target);
+
+#endif /*CFAR_H_*/
@@ -0,0 +1,109 @@
+/***********************************************************
+*  coarse.c                                                *
+*                                                          *
+*  Decimated envelope correlation (portable C)             *
+*                                                          *
+************************************************************/
+#include "coarse.h"
+
+/* exp(-j 2 pi n / 8): mixing with SAMPLE_RATE/8 only needs 8 values */
+static const float mix_re[8] = { 1, 0.70710678f, 0, -0.70710678f, -1, -0.70710678f, 0, 0.70710678f };
+static const float mix_im[8] = { 0, -0.70710678f, -1, -0.70710678f, 0, 0.70710678f, 1, 0.70710678f };
+
+
+/* out[i] = sum over the block i of decim samples of x[n] exp(-j 2 pi n / 8) */
+static void baseband(const short *x, int len, short decim, float *out, int out_len)
+{
+	int i, n, m;
+	float re, im;
+
+	for(i=0;i<out_len;i++)
+	{
+		re = 0;
+		im = 0;
+		if((i+1)*decim <= len)
+		{
+			for(n=0;n<decim;n++)
+			{
+				m = i*decim + n;
+				re += x[m]*mix_re[m & 7];
+				im += x[m]*mix_im[m & 7];
+			}
+		}
+		out[2*i]   = re;
+		out[2*i+1] = im;
+	}
+}
+
+
+int coarse_init(coarse_t *c, const short *sweep, short decim)
+{
+	if(decim != 4 && decim != 8)
+	{
+		return 0;
+	}
+	c->decim = decim;
+	c->tpl_len = SWEEP_LEN/decim;
+	baseband(sweep, SWEEP_LEN, decim, c->tpl, c->tpl_len);
+	return 1;
+}
+
+
+int coarse_candidates(coarse_t *c, const short *mono, short lag_lo, short lag_hi, short *cand)
+{
+	int i, j, k, lo, hi, count;
+	const float *y, *t = c->tpl;
+	float re0, im0, re1, im1, e, best[COARSE_CANDIDATES];
+
+	/*------ Decimated baseband response ------*/
+	baseband(mono, RESPONSE_MONO, c->decim, c->resp, (RESPONSE_MONO + SWEEP_LEN)/c->decim + 1);
+
+	/*--------- Envelope correlation ----------*/
+	/* r[i] = sum_j conj(tpl[j]) resp[i+j], only the coarse lags of the gate */
+	lo = lag_lo/c->decim;
+	hi = lag_hi/c->decim;
+	for(i=lo;i<=hi;i++)
+	{
+		y = c->resp + 2*i;
+		re0 = im0 = re1 = im1 = 0;						// 2 independent sums (float adds are not reordered)
+		for(j=0;j<2*c->tpl_len;j+=4)					// tpl_len is even
+		{
+			re0 += t[j]   * y[j]   + t[j+1] * y[j+1];
+			im0 += t[j]   * y[j+1] - t[j+1] * y[j];
+			re1 += t[j+2] * y[j+2] + t[j+3] * y[j+3];
+			im1 += t[j+2] * y[j+3] - t[j+3] * y[j+2];
+		}
+		re0 += re1;
+		im0 += im1;
+		c->env[i] = re0*re0 + im0*im0;
+	}
+
+	/*------- Strongest local maxima -------*/
+	count = 0;
+	for(i=lo;i<=hi;i++)
+	{
+		e = c->env[i];
+		if((i > lo && c->env[i-1] > e) || (i < hi && c->env[i+1] >= e))
+		{
+			continue;
+		}
+		for(k=count; k > 0 && best[k-1] < e; k--)			// insertion, strongest first
+		{
+			if(k < COARSE_CANDIDATES)
+			{
+				best[k] = best[k-1];
+				cand[k] = cand[k-1];
+			}
+		}
+		if(k < COARSE_CANDIDATES)
+		{
+			best[k] = e;
+			cand[k] = i*c->decim;
+			if(count < COARSE_CANDIDATES)
+			{
+				count++;
+			}
+		}
+	}
+	return count;
+}
@@ -0,0 +1,45 @@
+/***********************************************************
+*  coarse.h                                                *
+*                                                          *
+*  First stage of the coarse to fine correlator            *
+*                                                          *
+*  Sweep and response are mixed down by SAMPLE_RATE/8      *
+*  (6 kHz, middle of the 1..10 kHz sweep), summed over     *
+*  blocks of decim samples and correlated at the reduced   *
+*  rate. The magnitude of this complex correlation is the  *
+*  envelope of the full rate one, its strongest local      *
+*  maxima are the candidate lags refined at full rate.     *
+*                                                          *
+*  decim 4: 12 kHz complex rate, covers the sweep band,    *
+*           1/16 of the multiply accumulates               *
+*  decim 8: 6 kHz, the band edges alias, still coherent    *
+*           on the lag grid, 1/64 of the multiply          *
+*           accumulates                                    *
+*                                                          *
+************************************************************/
+#ifndef COARSE_H_
+#define COARSE_H_
+
+#include "sonar_params.h"
+
+#define COARSE_DECIM_MIN 4
+#define COARSE_TPL_MAX (SWEEP_LEN/COARSE_DECIM_MIN)
+#define COARSE_RESP_MAX ((RESPONSE_MONO + SWEEP_LEN)/COARSE_DECIM_MIN + 1)	// + zero tail for the last lags
+#define COARSE_LAGS_MAX (PEAK_SPAN/COARSE_DECIM_MIN + 1)
+#define COARSE_CANDIDATES 3				// local maxima of the envelope refined at full rate
+
+typedef struct {
+	short decim;						// 4 or 8
+	short tpl_len;						// SWEEP_LEN/decim
+	float tpl[2*COARSE_TPL_MAX];		// decimated baseband sweep (complex)
+	float resp[2*COARSE_RESP_MAX];		// decimated baseband response of the current ping
+	float env[COARSE_LAGS_MAX];			// |correlation|^2 on the coarse lag grid
+} coarse_t;
+
+int coarse_init(coarse_t *c, const short *sweep, short decim);		// 0 if decim is not 4 or 8
+
+/* envelope over the coarse lags covering lag_lo..lag_hi, fills cand[] with up to
+   COARSE_CANDIDATES full rate lags (strongest first), returns how many */
+int coarse_candidates(coarse_t *c, const short *mono, short lag_lo, short lag_hi, short *cand);
+
+#endif /*COARSE_H_*/
@@ -183,6 +183,11 @@ void Config_DSK6713_AIC23(void)
 
 
 
+/* Registerwerte, mit denen der AIC23 konfiguriert wurde (z.B. fuer den Kopf einer Aufnahme) */
+const unsigned short *AIC23_registers(void)
+{
+	return myAIC23_registers;
+}
 
 
 void set_aic23_register(MCBSP_Handle hMcbsp00,unsigned short regnum, unsigned short regval)
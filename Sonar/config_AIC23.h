@@ -6,3 +6,4 @@
 
 void Config_DSK6713_AIC23(void);
 void set_aic23_register(MCBSP_Handle hMcbsp,unsigned short regnum, unsigned short regval);
+const unsigned short *AIC23_registers(void);	/* die 10 Registerwerte von Config_DSK6713_AIC23 */
@@ -0,0 +1,82 @@
+/***********************************************************
+*  convert.c                                               *
+*                                                          *
+*  Format stage of the frequency domain correlators        *
+*  (portable C, no CSL => also builds on the host)         *
+*                                                          *
+*  The first DIT pass (block n, q = n/4) combines the      *
+*  points i, i+q, i+2q, i+3q. With live points, quarter k  *
+*  holds data for i < live - k q, so the pass splits into  *
+*  up to 5 ranges with 4, 3, 2, 1 and 0 converted          *
+*  operands, each a straight loop without tests.           *
+*                                                          *
+************************************************************/
+#include "fft_r4_bfly.h"
+#include "convert.h"
+
+#define CVT(src, p) ((float)(src)[(p)*step])
+
+/* first pass over i in [lo, hi): LB/LC/LD = quarters 1..3 converted (1) or zero (0) */
+#define FIRST_PASS(LB, LC, LD)                                                  \
+	for(i=lo; i < hi; i++)                                                     \
+	{                                                                          \
+		float ar = CVT(re, i),                ai = CVT(im, i);                 \
+		float br = LB ? CVT(re, i+q) : 0.0f,  bi = LB ? CVT(im, i+q) : 0.0f;   \
+		float cr = LC ? CVT(re, i+2*q) : 0.0f, ci = LC ? CVT(im, i+2*q) : 0.0f; \
+		float dr = LD ? CVT(re, i+3*q) : 0.0f, di = LD ? CVT(im, i+3*q) : 0.0f; \
+		DIT_QUAD_STORE(x, i, q, c0, s0, c1, s1, c2, s2);                       \
+	}
+
+static int quarter_end(int live, int k, int q)		// points of quarter k with data
+{
+	int e = live - k*q;
+	return e < 0 ? 0 : e > q ? q : e;
+}
+
+
+void convert_dit_pass(float *RESTRICT x, const float *w, short n, const short *RESTRICT re, const short *RESTRICT im,
+                      short step, short live)
+{
+	int i, lo, hi, q;
+	int e0, e1, e2, e3;
+	float c0, s0, c1, s1, c2, s2;
+
+	q = n >> 2;
+	c0 = w[0];  s0 = w[1];						// group 0 of cfftr4_dit (same table values
+	c1 = w[0];  s1 = w[1];						// => same rounding as the full transform)
+	c2 = w[2];  s2 = w[3];
+
+	e0 = quarter_end(live, 0, q);
+	e1 = quarter_end(live, 1, q);
+	e2 = quarter_end(live, 2, q);
+	e3 = quarter_end(live, 3, q);
+
+	lo = 0;   hi = e3;  FIRST_PASS(1, 1, 1)
+	lo = e3;  hi = e2;  FIRST_PASS(1, 1, 0)
+	lo = e2;  hi = e1;  FIRST_PASS(1, 0, 0)
+	lo = e1;  hi = e0;  FIRST_PASS(0, 0, 0)
+
+	for(i=e0; i < q; i++)						// no data in any quarter: the pass output is 0
+	{
+		x[2*i]         = 0;  x[2*i+1]         = 0;
+		x[2*(i+q)]     = 0;  x[2*(i+q)+1]     = 0;
+		x[2*(i+2*q)]   = 0;  x[2*(i+2*q)+1]   = 0;
+		x[2*(i+3*q)]   = 0;  x[2*(i+3*q)+1]   = 0;
+	}
+}
+
+
+void convert_i16(float *RESTRICT x, const short *RESTRICT re, const short *RESTRICT im, short step, short live, short n)
+{
+	int i;
+
+	for(i=0; i < live; i++)
+	{
+		x[2*i]   = CVT(re, i);
+		x[2*i+1] = CVT(im, i);
+	}
+	for(i=2*live; i < 2*n; i++)
+	{
+		x[i] = 0;
+	}
+}
@@ -0,0 +1,30 @@
+/***********************************************************
+*  convert.h                                               *
+*                                                          *
+*  Format stage of the frequency domain correlators:       *
+*  16 bit samples => complex float FFT input, without the  *
+*  1/SWEEP_AMPLITUDE scaling (folded into the template     *
+*  spectrum) and without a separate zero padding pass.     *
+*                                                          *
+*  Point p of the transform input is                       *
+*      re[p*step] + j im[p*step]   for p < live            *
+*      0                           for live <= p < n       *
+*  (real path: re = x, im = x+1, step 2 / stereo: re =     *
+*  left, im = right, step 1).                              *
+*                                                          *
+*  convert_dit_pass : radix 2 build: the conversion is     *
+*      the first radix 2^2 pass of cfft_dit itself, the    *
+*      padding only enters as zero operands, the rest of   *
+*      the transform continues with cfft_dit_from(n/4).    *
+*      Same result as converting and running cfft_dit.     *
+*  convert_i16      : live region + zero tail, for the     *
+*      mixed radix engine                                  *
+*                                                          *
+************************************************************/
+#ifndef CONVERT_H_
+#define CONVERT_H_
+
+void convert_dit_pass(float *x, const float *w, short n, const short *re, const short *im, short step, short live);
+void convert_i16(float *x, const short *re, const short *im, short step, short live, short n);
+
+#endif /*CONVERT_H_*/
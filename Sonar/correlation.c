@@ -0,0 +1,348 @@
+/***********************************************************
+*  correlation.c                                           *
+*                                                          *
+*  Correlators and helpers of the ping processing          *
+*  (portable C, no CSL => also builds on the host)         *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include "rfft.h"
+#include "correlation.h"
+#include "profile.h"
+
+#define ENV_ALPHA 0.96043387f		// alpha max + beta min magnitude (least max error)
+#define ENV_BETA  0.39782473f
+
+
+float convert_step_distance(float step) // array index (fractional after peak refinement) => distance
+{
+	float distance;
+	distance = (float)step*SPEED_OF_SOUND/(2*SAMPLE_RATE);   // distance = step x speed of sound / (2 x sampling freq)
+	return distance;
+}
+
+
+short convert_distance_step(float distance) // distance => nearest array index (inverse of convert_step_distance)
+{
+	float step;
+	step = distance*(2*SAMPLE_RATE)/SPEED_OF_SOUND;   // step = distance x 2 x sampling freq / speed of sound
+	if(step < 0)
+	{
+		return 0;
+	}
+	if(step > PEAK_SPAN-1)
+	{
+		return PEAK_SPAN-1;
+	}
+	return (short)(step + 0.5f);
+}
+
+
+void range_gate_set(range_gate_t *gate, float min_m, float max_m)
+{
+	short lo, hi;
+
+	lo = convert_distance_step(min_m);
+	hi = convert_distance_step(max_m);
+	if(lo > hi)
+	{
+		short t = lo;
+		lo = hi;
+		hi = t;
+	}
+	gate->lag_lo = lo > 0 ? lo-1 : 0;						// one lag of margin for the rounding
+	gate->lag_hi = hi < PEAK_SPAN-1 ? hi+1 : PEAK_SPAN-1;
+}
+
+
+short cross_correlation_time(const xcorr_i16_t *xc, const short *mono, short lag_lo, short lag_hi)
+{										// Cross correlation (time domain), one packed dot product per lag
+	return xcorr_i16_peak(xc, mono, lag_lo, lag_hi, 0);		// Returns the lag of the maximum of the cross correlation
+}
+
+
+short cross_correlation_coarse(coarse_t *coarse, const xcorr_i16_t *xc, const short *mono, short lag_lo, short lag_hi)
+{										// Coarse to fine: decimated envelope over the gate, full rate around the candidates
+	short cand[COARSE_CANDIDATES];
+	short max_index, k, lo, hi, radius;
+	xcorr_acc_t r, r_max;
+	int i, n;
+
+	n = coarse_candidates(coarse, mono, lag_lo, lag_hi, cand);
+
+	radius = 2*coarse->decim;			// the true lag is within one block of the candidate
+	r_max = 0;
+	max_index = lag_lo;
+	for(i=0;i<n;i++)
+	{
+		lo = cand[i] - radius < lag_lo ? lag_lo : cand[i] - radius;
+		hi = cand[i] + radius > lag_hi ? lag_hi : cand[i] + radius;
+		k = xcorr_i16_peak(xc, mono, lo, hi, &r);
+		if(r > r_max)
+		{
+			r_max = r;
+			max_index = k;
+		}
+	}
+	return max_index;
+}
+
+
+void correlate_frequency(const short *capture, const mf_template_t *tpl, float *work)
+{										// Uses the FFT dit + IFFT dif algorithm (Radix 2)	from the DSPlib
+										// max = max[ IFFT( conj(FFT(sweep)) x FFT(response) ) ]
+										// the sweep part comes precomputed from the template
+	PROF_DECL(t)
+
+	/*----- Formating + FFT --------*/
+	/* The response is real: FFT_N samples are read by the FFT as FFT_N/2 complex points
+	 (array[x0,x1,x2,x3,...] = [re(z0),im(z0),re(z1),im(z1),...]), so no imaginary zeros are stored.
+	 The int16 => float conversion is the first pass of the FFT, the padding never gets stored
+	 as such and 1/SWEEP_AMPLITUDE is part of the template */
+
+	PROF_START(t);
+	fft_forward_i16(&tpl->plan, capture, capture+1, 2, RESPONSE_MONO/2, work, work+FFT_N);
+	PROF_MARK(t, PROF_FFT);
+
+
+	/*---------- Multiply ----------*/
+	/* split into the real signal spectrum, multiply with the template, merge back (in place) */
+
+	rfft_multiply(work, tpl->spectrum, tpl->split, tpl->plan.bin, FFT_N);
+	PROF_MARK(t, PROF_MULTIPLY);
+
+
+	/*------------ IFFT ------------*/
+	fft_inverse(&tpl->plan, work, work+FFT_N);				//output normal order = FFT_N real values
+	PROF_MARK(t, PROF_IFFT);
+}
+
+
+void correlate_envelope(const short *capture, const mf_template_t *tpl, float *work)
+{										// same transforms as correlate_frequency, one sided product spectrum
+	PROF_DECL(t)
+
+	PROF_START(t);
+	fft_forward_i16(&tpl->plan, capture, capture+1, 2, RESPONSE_MONO/2, work, work+FFT_N);
+	PROF_MARK(t, PROF_FFT);
+	rfft_analytic(work, tpl->spectrum, tpl->split, tpl->plan.bin, FFT_N);
+	PROF_MARK(t, PROF_MULTIPLY);
+	fft_inverse(&tpl->plan, work, work+FFT_N);				//FFT_N/2 complex values = analytic signal at lags 0, 2, 4 ...
+	PROF_MARK(t, PROF_IFFT);
+}
+
+
+short peak_envelope(const float *work, short lag_lo, short lag_hi)
+{
+	short max_index, m;
+	float max_value, re, im, env;
+
+	/*---- Maximum of the envelope ----*/
+	/* |z| ~ alpha max(|re|,|im|) + beta min(|re|,|im|), 4 % at most, no square root */
+
+	max_value = 0;
+	max_index = lag_lo;
+	for(m=(lag_lo+1)>>1;2*m<=lag_hi;m++)
+	{
+		re = work[2*m] < 0 ? -work[2*m] : work[2*m];
+		im = work[2*m+1] < 0 ? -work[2*m+1] : work[2*m+1];
+		env = re > im ? ENV_ALPHA*re + ENV_BETA*im : ENV_ALPHA*im + ENV_BETA*re;
+		if(env > max_value)
+		{
+			max_value = env;
+			max_index = 2*m;
+		}
+	}
+	return max_index;						// even lag
+}
+
+
+short cross_correlation_envelope(const short *capture, const mf_template_t *tpl, float *work, short lag_lo, short lag_hi)
+{
+	correlate_envelope(capture, tpl, work);
+	return peak_envelope(work, lag_lo, lag_hi);
+}
+
+
+short peak_frequency(const float *work, short lag_lo, short lag_hi)
+{
+	short max_index,k;
+	float max_value;
+
+	/*---- Finding the maximum ----*/
+	/* correlation => index = lag, only lags inside the range gate */
+
+	max_value=0;
+	max_index=lag_lo;
+	for(k=lag_lo;k<=lag_hi;k++)
+	{
+		if (work[k] > max_value)
+		{
+			max_value = work[k];
+			max_index = k;
+		}
+	}
+
+
+	// return the index of the maximum value
+	return max_index;
+}
+
+
+short cross_correlation_frequency(const short *capture, const mf_template_t *tpl, float *work, short lag_lo, short lag_hi)
+{
+	correlate_frequency(capture, tpl, work);
+	return peak_frequency(work, lag_lo, lag_hi);
+}
+
+
+void correlate_stereo(const short *capture, const mf_stereo_t *st, float *work)
+{										// both channels in one complex transform, no separation needed (see header)
+	const short *right = CAPTURE_RIGHT(capture);
+	int i;
+	float zr, zi;
+	PROF_DECL(t)
+
+	PROF_START(t);
+	fft_forward_i16(&st->plan, capture, right, 1, RESPONSE_MONO, work, work+2*FFT_N);	// left => real, right => imaginary
+	PROF_MARK(t, PROF_FFT);
+
+	for(i=0 ; i < FFT_N ; i++)				// template already in spectrum order => no index table
+	{
+		zr = work[2*i];
+		zi = work[2*i+1];
+		work[2*i]   = st->spectrum[2*i]*zr - st->spectrum[2*i+1]*zi;
+		work[2*i+1] = st->spectrum[2*i+1]*zr + st->spectrum[2*i]*zi;
+	}
+	PROF_MARK(t, PROF_MULTIPLY);
+
+	fft_inverse(&st->plan, work, work+2*FFT_N);				//left + j right correlation, natural order
+	PROF_MARK(t, PROF_IFFT);
+}
+
+
+static float stereo_refine(const float *work, short max_index, short method)
+{										// refine_lag_frequency on one channel of the interleaved output
+	float y[2*PEAK_SINC_HALF+1];
+	short k;
+	int i;
+
+	if(method == PEAK_NONE)
+	{
+		return max_index;
+	}
+	for(i=-PEAK_SINC_HALF;i<=PEAK_SINC_HALF;i++)
+	{
+		k = max_index + i;
+		y[PEAK_SINC_HALF+i] = k >= 0 && k < PEAK_SPAN ? work[2*k] : 0;
+	}
+	return max_index + peak_interp(y, method);
+}
+
+
+void stereo_echo_find(const float *work, short lag_lo, short lag_hi, short method, stereo_echo_t *echo)
+{
+	short max_index[2], k;
+	float max_value[2], s;
+	int c;
+
+	max_value[0] = max_value[1] = 0;
+	max_index[0] = max_index[1] = lag_lo;
+	for(k=lag_lo;k<=lag_hi;k++)
+	{
+		if(work[2*k] > max_value[0])
+		{
+			max_value[0] = work[2*k];
+			max_index[0] = k;
+		}
+		if(work[2*k+1] > max_value[1])
+		{
+			max_value[1] = work[2*k+1];
+			max_index[1] = k;
+		}
+	}
+	for(c=0;c<2;c++)
+	{
+		echo->lag[c] = stereo_refine(work + c, max_index[c], method);
+	}
+
+	/*---- Bearing ----*/
+	/* only the way back differs: path difference = RX_SPACING x sin(bearing) */
+	echo->delay = echo->lag[1] - echo->lag[0];
+	s = echo->delay*SPEED_OF_SOUND/(SAMPLE_RATE*RX_SPACING);
+	if(s > 1)
+	{
+		s = 1;
+	}
+	if(s < -1)
+	{
+		s = -1;
+	}
+	echo->bearing = asin(s);
+}
+
+
+void cross_correlation_stereo(const short *capture, const mf_stereo_t *st, float *work, short lag_lo, short lag_hi,
+                              short method, stereo_echo_t *echo)
+{
+	correlate_stereo(capture, st, work);
+	stereo_echo_find(work, lag_lo, lag_hi, method, echo);
+}
+
+
+float refine_lag_time(const xcorr_i16_t *xc, const short *mono, short max_index, short method)
+{										// r[] around the argmax computed again, PEAK_SINC_HALF lags on each side at most
+	float y[2*PEAK_SINC_HALF+1];
+	short k, half;
+	int i;
+
+	if(method == PEAK_NONE)
+	{
+		return max_index;
+	}
+	half = method == PEAK_SINC ? PEAK_SINC_HALF : 1;
+	for(i=-half;i<=half;i++)
+	{
+		k = max_index + i;
+		y[PEAK_SINC_HALF+i] = k >= 0 && k < PEAK_SPAN ? (float)xcorr_i16_dot(xc->tpl[k & 1], mono + (k & ~1), XCORR_TPL_LEN/2) : 0;
+	}
+	return max_index + peak_interp(y, method);
+}
+
+
+float refine_lag_frequency(const float *work, short max_index, short method)
+{										// work still holds the correlation of cross_correlation_frequency
+	float y[2*PEAK_SINC_HALF+1];
+	short k;
+	int i;
+
+	if(method == PEAK_NONE)
+	{
+		return max_index;
+	}
+	for(i=-PEAK_SINC_HALF;i<=PEAK_SINC_HALF;i++)
+	{
+		k = max_index + i;
+		y[PEAK_SINC_HALF+i] = k >= 0 && k < PEAK_SPAN ? work[k] : 0;
+	}
+	return max_index + peak_interp(y, method);
+}
+
+
+float refine_lag_envelope(const float *work, short max_index, short method)
+{										// exact |z| around the maximum, half rate grid
+	float y[2*PEAK_SINC_HALF+1];
+	short m;
+	int i;
+
+	if(method == PEAK_NONE)
+	{
+		return max_index;
+	}
+	for(i=-PEAK_SINC_HALF;i<=PEAK_SINC_HALF;i++)
+	{
+		m = (max_index >> 1) + i;
+		y[PEAK_SINC_HALF+i] = m >= 0 && 2*m < PEAK_SPAN ? sqrt(work[2*m]*work[2*m] + work[2*m+1]*work[2*m+1]) : 0;
+	}
+	return 2*((max_index >> 1) + peak_interp(y, method));
+}
@@ -0,0 +1,79 @@
+/***********************************************************
+*  correlation.h                                           *
+*                                                          *
+*  Correlators and helpers of the ping processing          *
+*                                                          *
+************************************************************/
+#ifndef CORRELATION_H_
+#define CORRELATION_H_
+
+#include "sonar_params.h"
+#include "capture.h"
+#include "mf_template.h"
+#include "xcorr_i16.h"
+#include "coarse.h"
+#include "peak_interp.h"
+#include "cfar.h"
+
+/* lags of interest, both included, 0 <= lag_lo <= lag_hi < PEAK_SPAN */
+typedef struct {
+	short lag_lo;
+	short lag_hi;
+} range_gate_t;
+
+/* stereo engine: one echo seen by both hydrophones */
+typedef struct {
+	float lag[2];				// refined lag of the left / right channel
+	float delay;				// lag[1] - lag[0]: samples the echo reaches the right hydrophone later
+	float bearing;				// radians from broadside, > 0 towards the left hydrophone (RX_SPACING)
+} stereo_echo_t;
+
+float convert_step_distance(float step);				// array index (or fractional lag) => distance
+short convert_distance_step(float distance);			// distance => array index, clamped to the lags of PEAK_SPAN
+void  range_gate_set(range_gate_t *gate, float min_m, float max_m);	// metres => lags (+/- 1 lag margin)
+
+/* xc   : 16 bit templates of the sent sweep
+   mono : XCORR_MONO_LEN samples, the response followed by zeros (the left channel of Buffer_in, capture.h)
+   only the lags lag_lo..lag_hi are computed (cost proportional to the range span) */
+short cross_correlation_time(const xcorr_i16_t *xc, const short *mono, short lag_lo, short lag_hi);
+
+/* coarse to fine: candidates from the decimated envelope (coarse.h), the time domain
+   correlator only around them => cost of a few lags instead of the whole gate.
+   mono : as for cross_correlation_time */
+short cross_correlation_coarse(coarse_t *coarse, const xcorr_i16_t *xc, const short *mono, short lag_lo, short lag_hi);
+
+/* transform only: work holds the correlation afterwards (index = lag), for the CFAR detector */
+void correlate_frequency(const short *capture, const mf_template_t *tpl, float *work);
+short peak_frequency(const float *work, short lag_lo, short lag_hi);	// largest correlation inside the gate
+
+/* envelope mode: the product spectrum is made one sided before the inverse transform, which then
+   returns the analytic signal of the correlation at the even lags (work[2m] + j work[2m+1] = lag 2m).
+   The peak search runs on its magnitude (no carrier oscillation) and returns an even lag */
+void  correlate_envelope(const short *capture, const mf_template_t *tpl, float *work);
+short peak_envelope(const float *work, short lag_lo, short lag_hi);		// work as left by correlate_envelope
+short cross_correlation_envelope(const short *capture, const mf_template_t *tpl, float *work, short lag_lo, short lag_hi);
+
+/* capture : capture (Buffer_in) as laid out by the receive EDMA (capture.h), left channel used
+   tpl     : matched filter template of the sent sweep
+   work    : CORR_WORK_LEN floats, overwritten, holds the correlation afterwards
+   the transform covers all lags, only the peak search is limited to lag_lo..lag_hi */
+short cross_correlation_frequency(const short *capture, const mf_template_t *tpl, float *work, short lag_lo, short lag_hi);
+
+/* stereo: left + j right go through one FFT_N point complex FFT. Both channel spectra follow from
+   it by conjugate symmetry, L[k] = (Z[k] + conj(Z[N-k]))/2 and R[k] = (Z[k] - conj(Z[N-k]))/2j,
+   and as both correlations are real, L.H + j R.H = Z.H: the separated products are put back together
+   by the one inverse transform, real part = left correlation, imaginary part = right correlation.
+   work : STEREO_WORK_LEN floats, work[2k] / work[2k+1] = left / right correlation at lag k afterwards */
+void correlate_stereo(const short *capture, const mf_stereo_t *st, float *work);
+/* peak of each channel inside the gate, refined (method as below), delay and bearing between them */
+void stereo_echo_find(const float *work, short lag_lo, short lag_hi, short method, stereo_echo_t *echo);	// after correlate_stereo
+void cross_correlation_stereo(const short *capture, const mf_stereo_t *st, float *work, short lag_lo, short lag_hi,
+                              short method, stereo_echo_t *echo);
+
+/* sub-sample refinement after the argmax (method: PEAK_NONE, PEAK_PARABOLIC, PEAK_GAUSSIAN, PEAK_SINC),
+   returns the fractional lag */
+float refine_lag_time(const xcorr_i16_t *xc, const short *mono, short max_index, short method);	// also after the coarse engine
+float refine_lag_frequency(const float *work, short max_index, short method);	// work as left by cross_correlation_frequency
+float refine_lag_envelope(const float *work, short max_index, short method);	// work as left by cross_correlation_envelope
+
+#endif /*CORRELATION_H_*/
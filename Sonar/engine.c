@@ -0,0 +1,205 @@
+/***********************************************************
+*  engine.c                                                *
+*                                                          *
+*  Processing of one ping (portable C)                     *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include "engine.h"
+#include "profile.h"
+
+#ifdef ENGINE_STAGES
+#define STAGE_END(e, s) if((e)->stage_end) (e)->stage_end((e)->stage_ctx, s)
+#else
+#define STAGE_END(e, s)
+#endif
+
+
+void engine_defaults(engine_t *e, engine_cfg_t *cfg)
+{
+	e->coarse_decim = ENGINE_DEFAULT_COARSE_DECIM;
+	e->auto_lags = ENGINE_DEFAULT_AUTO_LAGS;
+	e->cfar.guard = ENGINE_DEFAULT_CFAR_GUARD;
+	e->cfar.train = ENGINE_DEFAULT_CFAR_TRAIN;
+	e->cfar.alpha = ENGINE_DEFAULT_CFAR_ALPHA;
+	e->cfar.mode = ENGINE_DEFAULT_CFAR_MODE;
+	e->cfar.max_targets = CFAR_MAX_TARGETS;
+	e->stage_end = 0;
+	cfg->engine = ENGINE_FREQUENCY;
+	cfg->method = ENGINE_DEFAULT_METHOD;
+	range_gate_set(&cfg->gate, ENGINE_DEFAULT_RANGE_MIN_M, ENGINE_DEFAULT_RANGE_MAX_M);
+	cfg->integrate_k = ENGINE_DEFAULT_INTEGRATE_K;
+	cfg->integrate_mode = ENGINE_DEFAULT_INTEGRATE_MODE;
+}
+
+
+short engine_init(engine_t *e)
+{
+	short w;
+	PROF_DECL(t)
+
+	for(w=0;w<WAVEFORMS;w++)
+	{
+		PROF_START(t);
+		if(!mf_template_init(&e->tpl[w], e->sweep[w], e->work))	// nothing of the sweeps changes between pings
+		{
+			return 0;
+		}
+		PROF_MARK(t, PROF_TEMPLATE);
+		if(!mf_stereo_init(&e->stereo[w], &e->tpl[w]))
+		{
+			return 0;
+		}
+		if(e->twiddle)
+		{
+			fft_plan_relocate(&e->tpl[w].plan, e->twiddle);		// read every pass of every ping, same for all
+		}
+	}
+	xcorr_i16_init(e->pairs, e->sweep[0]);
+	coarse_init(e->coarse, e->sweep[0], e->coarse_decim);
+	e->hot = 0;
+	integrate_init(e->integrator, 1, INTEGRATE_BLOCK);
+	return 1;
+}
+
+
+static void engine_hot(engine_t *e, short w)		// time domain engines: 16 bit templates of waveform w
+{
+	if(w != e->hot)							// a copy and a decimation of SWEEP_LEN samples
+	{
+		xcorr_i16_init(e->pairs, e->sweep[w]);
+		coarse_init(e->coarse, e->sweep[w], e->coarse_decim);
+		e->hot = w;
+	}
+}
+
+
+short engine_ping(engine_t *e, const engine_cfg_t *cfg, const short *capture, short w, engine_result_t *res)
+{
+	const range_gate_t *gate = &cfg->gate;
+	float lag;
+	short max_index, use, k;
+	int i;
+	PROF_DECL(t)
+	PROF_DECL(t_ping)
+
+	PROF_START(t_ping);
+
+	/* only the lags inside the range gate are searched (time domain: computed) */
+	use = cfg->engine;
+	if(use == ENGINE_AUTO)
+	{
+		use = gate->lag_hi - gate->lag_lo < e->auto_lags ? ENGINE_TIME : ENGINE_FREQUENCY;
+	}
+
+	if(use == ENGINE_INTEGRATE)
+	{
+		/*---- Frequency domain, integrated ----*/
+		k = cfg->integrate_k < 1 ? 1 : cfg->integrate_k > INTEGRATE_MAX ? INTEGRATE_MAX : cfg->integrate_k;
+		if(e->integrator->k != k || e->integrator->mode != cfg->integrate_mode)
+		{
+			integrate_init(e->integrator, k, cfg->integrate_mode);
+		}
+		if(!integrate_ping(e->integrator, capture, &e->tpl[w], e->work))
+		{
+			PROF_MARK(t_ping, PROF_PING);
+			return 0;								// sum not complete: last result stays
+		}
+	}
+	else if(use == ENGINE_FREQUENCY)
+	{
+		correlate_frequency(capture, &e->tpl[w], e->work);
+	}
+
+	res->target_count = 0;							// single echo engines: result only
+	res->peak = 0;
+	if(use == ENGINE_FREQUENCY || use == ENGINE_INTEGRATE)
+	{
+		/*---------- Frequency domain ----------*/
+		STAGE_END(e, STAGE_CORRELATE);
+		PROF_START(t);								// transforms: profiled inside
+		res->target_count = cfar_detect(&e->cfar, e->work, PEAK_SPAN, gate->lag_lo, gate->lag_hi, res->targets);
+		PROF_MARK(t, PROF_DETECT);
+		STAGE_END(e, STAGE_DETECT);
+		for(i=res->target_count-1;i>=0;i--)			// ends with the strongest echo => result
+		{
+			lag = refine_lag_frequency(e->work, res->targets[i].lag, cfg->method);
+			res->target_range[i] = convert_step_distance(lag);
+		}
+		if(res->target_count > 0)
+		{
+			res->peak = res->targets[0].amplitude;
+		}
+		else
+		{
+			max_index = peak_frequency(e->work, gate->lag_lo, gate->lag_hi);	// nothing above the threshold:
+			lag = refine_lag_frequency(e->work, max_index, cfg->method);		// largest correlation, as the time engines
+			res->peak = e->work[max_index];
+		}
+		PROF_MARK(t, PROF_REFINE);
+		STAGE_END(e, STAGE_REFINE);
+	}
+	else if(use == ENGINE_ENVELOPE)
+	{
+		/*------- Frequency domain envelope ------*/
+		correlate_envelope(capture, &e->tpl[w], e->work);
+		STAGE_END(e, STAGE_CORRELATE);
+		PROF_START(t);
+		max_index = peak_envelope(e->work, gate->lag_lo, gate->lag_hi);
+		PROF_MARK(t, PROF_DETECT);
+		STAGE_END(e, STAGE_DETECT);
+		lag = refine_lag_envelope(e->work, max_index, cfg->method);
+		res->peak = sqrt(e->work[max_index]*e->work[max_index] + e->work[max_index+1]*e->work[max_index+1]);
+		PROF_MARK(t, PROF_REFINE);
+		STAGE_END(e, STAGE_REFINE);
+	}
+	else if(use == ENGINE_STEREO)
+	{
+		/*------ Frequency domain, stereo -------*/
+		correlate_stereo(capture, &e->stereo[w], e->work_stereo);
+		STAGE_END(e, STAGE_CORRELATE);
+		PROF_START(t);
+		stereo_echo_find(e->work_stereo, gate->lag_lo, gate->lag_hi, cfg->method, &res->stereo);
+		PROF_MARK(t, PROF_DETECT);					// refined with the peaks
+		STAGE_END(e, STAGE_DETECT);
+		STAGE_END(e, STAGE_REFINE);
+		res->stereo_range[0] = convert_step_distance(res->stereo.lag[0]);
+		res->stereo_range[1] = convert_step_distance(res->stereo.lag[1]);
+		res->bearing_deg = res->stereo.bearing*(float)(180/PI);
+		k = (short)(res->stereo.lag[0] + 0.5f);
+		res->peak = k >= 0 && k < PEAK_SPAN ? e->work_stereo[2*k] : 0;	// real part = left hydrophone
+		lag = res->stereo.lag[0];					// result: left hydrophone as in the other engines
+	}
+	else
+	{
+		/*---- Time domain / coarse to fine ----*/
+		PROF_START(t);
+		engine_hot(e, w);
+		if(use == ENGINE_COARSE)
+		{
+			max_index = cross_correlation_coarse(e->coarse, e->pairs, capture, gate->lag_lo, gate->lag_hi);
+		}
+		else
+		{
+			use = ENGINE_TIME;
+			max_index = cross_correlation_time(e->pairs, capture, gate->lag_lo, gate->lag_hi);	// left channel, zero tail
+		}
+		PROF_MARK(t, PROF_XCORR);
+		STAGE_END(e, STAGE_CORRELATE);				// the search is part of the correlation
+		STAGE_END(e, STAGE_DETECT);
+		lag = refine_lag_time(e->pairs, capture, max_index, cfg->method);
+		res->peak = (float)xcorr_i16_dot(e->pairs->tpl[max_index & 1], capture + (max_index & ~1), XCORR_TPL_LEN/2)
+		            *(float)(1 << XCORR_PAIR_SHIFT)/((float)SWEEP_AMPLITUDE*SWEEP_AMPLITUDE);
+		PROF_MARK(t, PROF_REFINE);
+		STAGE_END(e, STAGE_REFINE);
+	}
+
+	res->used = use;
+	res->lag = lag;
+	PROF_START(t);
+	res->range = convert_step_distance(lag);		// fractional lag => sub-millimetre steps
+	PROF_MARK(t, PROF_CONVERT);
+	STAGE_END(e, STAGE_CONVERT);
+	PROF_MARK(t_ping, PROF_PING);
+	return 1;
+}
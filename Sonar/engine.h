@@ -0,0 +1,113 @@
+/***********************************************************
+*  engine.h                                                *
+*                                                          *
+*  Processing of one ping, from the capture (Buffer_in     *
+*  layout, capture.h) to the range: engine selection,      *
+*  correlation, detection, sub-sample refinement and       *
+*  distance. Portable C without CSL / BIOS, the same code  *
+*  runs in process_SWI and in the host benchmarks.         *
+*                                                          *
+*  The caller owns all buffers (placement.h on the target) *
+*  and hands them over in engine_t before engine_init.     *
+*                                                          *
+*  Stages (ENGINE_STAGES builds call e->stage_end after    *
+*  each of them, e.g. for timing):                         *
+*    STAGE_CORRELATE  transform / time domain correlation  *
+*                     (time and coarse: with the search)   *
+*    STAGE_DETECT     maximum or CFAR inside the gate      *
+*    STAGE_REFINE     sub-sample peak refinement           *
+*    STAGE_CONVERT    lag => metres                        *
+*                                                          *
+************************************************************/
+#ifndef ENGINE_H_
+#define ENGINE_H_
+
+#include "sonar_params.h"
+#include "correlation.h"
+#include "integrate.h"
+
+#define ENGINE_TIME 0
+#define ENGINE_FREQUENCY 1
+#define ENGINE_AUTO 2			// time domain for narrow gates, frequency domain otherwise
+#define ENGINE_COARSE 3			// decimated envelope, then time domain around the candidates
+#define ENGINE_ENVELOPE 4		// frequency domain, peak of the envelope (analytic signal from the same IFFT)
+#define ENGINE_STEREO 5			// frequency domain, both hydrophones in one complex FFT => range + bearing
+#define ENGINE_INTEGRATE 6		// frequency domain, product spectra of integrate_k pings summed before the IFFT
+#define ENGINES 7
+
+/* settings at start up (sonar.c), the same for the host tools reprocessing recordings */
+#define ENGINE_DEFAULT_COARSE_DECIM 4		// ENGINE_COARSE: decimation of the envelope stage (4 or 8, see coarse.h)
+#define ENGINE_DEFAULT_AUTO_LAGS 128		// ENGINE_AUTO: time domain for gates up to this many lags (about 0.45 m),
+											// the frequency path costs the same for any gate
+#define ENGINE_DEFAULT_CFAR_GUARD 16		// detection: cells between the echo and its noise estimate (main lobe ~ 10 lags)
+#define ENGINE_DEFAULT_CFAR_TRAIN 64		// cells of each noise window
+#define ENGINE_DEFAULT_CFAR_ALPHA 6.0		// threshold over the noise level (range sidelobes of a strong echo stay below)
+#define ENGINE_DEFAULT_CFAR_MODE CFAR_GO
+#define ENGINE_DEFAULT_METHOD PEAK_SINC		// sub-sample refinement (peak_interp.h)
+#define ENGINE_DEFAULT_RANGE_MIN_M 0.0		// range gate in metres
+#define ENGINE_DEFAULT_RANGE_MAX_M 10.0
+#define ENGINE_DEFAULT_INTEGRATE_K 4		// ENGINE_INTEGRATE: pings per coherent sum
+#define ENGINE_DEFAULT_INTEGRATE_MODE INTEGRATE_BLOCK
+
+#define STAGE_CORRELATE 0
+#define STAGE_DETECT 1
+#define STAGE_REFINE 2
+#define STAGE_CONVERT 3
+#define STAGES 4
+
+typedef struct {
+	/* buffers, set by the caller */
+	const short *sweep[WAVEFORMS];		// sent waveforms (Buffer_out), the time domain templates are made from them
+	mf_template_t *tpl;					// [WAVEFORMS] matched filter templates, built by engine_init
+	mf_stereo_t *stereo;				// [WAVEFORMS] stereo templates, built by engine_init
+	xcorr_i16_t *pairs;					// 16 bit templates of one waveform (time and coarse engines)
+	coarse_t *coarse;
+	integrate_t *integrator;
+	float *work;						// CORR_WORK_LEN floats
+	float *work_stereo;					// STEREO_WORK_LEN floats
+	float *twiddle;						// FFT_TWIDDLE(FFT_N/2) floats the plans are moved to, NULL = stay in the plan
+
+	/* settings, set by the caller */
+	short coarse_decim;					// 4 or 8
+	short auto_lags;					// ENGINE_AUTO: time domain for gates narrower than this
+	cfar_t cfar;
+
+	/* stage hook (ENGINE_STAGES builds only), NULL = none */
+	void (*stage_end)(void *ctx, short stage);
+	void *stage_ctx;
+
+	short hot;							// waveform of pairs / coarse
+} engine_t;
+
+/* per ping settings (watch window variables on the target) */
+typedef struct {
+	short engine;						// ENGINE_...
+	short method;						// sub-sample refinement (peak_interp.h)
+	range_gate_t gate;
+	short integrate_k;					// ENGINE_INTEGRATE: 1..INTEGRATE_MAX
+	short integrate_mode;				// INTEGRATE_BLOCK or INTEGRATE_SLIDING
+} engine_cfg_t;
+
+typedef struct {
+	short used;							// engine that ran (ENGINE_AUTO resolved)
+	float lag;							// fractional lag of the echo
+	float range;						// metres
+	float peak;							// correlation at the echo, units of correlate_frequency:
+										// echo amplitude [LSB] x sweep energy / SWEEP_AMPLITUDE^2 (0: none)
+	short target_count;					// frequency engines: every echo above the CFAR threshold, strongest first
+										// (0: range / peak of the largest correlation in the gate, no detection)
+	cfar_target_t targets[CFAR_MAX_TARGETS];
+	float target_range[CFAR_MAX_TARGETS];	// metres
+	stereo_echo_t stereo;				// ENGINE_STEREO: range of each hydrophone and direction of the echo
+	float stereo_range[2];				// metres, left / right
+	float bearing_deg;					// from broadside, > 0 towards the left hydrophone
+} engine_result_t;
+
+/* ENGINE_DEFAULT_... settings into e (buffers untouched, before engine_init) and cfg (ENGINE_FREQUENCY) */
+void  engine_defaults(engine_t *e, engine_cfg_t *cfg);
+short engine_init(engine_t *e);			// templates of every waveform, relocated twiddles, waveform 0 on chip (0: no FFT plan)
+
+/* capture of waveform w => res. Returns 0 (res unchanged) while ENGINE_INTEGRATE is still summing */
+short engine_ping(engine_t *e, const engine_cfg_t *cfg, const short *capture, short w, engine_result_t *res);
+
+#endif /*ENGINE_H_*/
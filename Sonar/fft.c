@@ -0,0 +1,118 @@
+/***********************************************************
+*  fft.c                                                   *
+*                                                          *
+*  Radix 2 FFT routines used by the correlators            *
+*  (portable C, no CSL => also builds on the host)         *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include "fft.h"
+
+
+void tw_genr2fft(float* w, int n)          //generates the coefficient table (twiddle factors) for the fft
+{
+   int i;
+   float pi = 4.0*atan(1.0);
+   float e = pi*2.0/n;
+
+    for(i=0; i < ( n>>1 ); i++)
+    {
+       w[2*i]   = cos(i*e);
+       w[2*i+1] = sin(i*e);
+    }
+}
+
+
+void bit_rev(float* x, int n)             //bit reverse a vector for the fft
+{
+  int i, j, k;
+  float rtemp, itemp;
+
+  j = 0;
+  for(i=1; i < (n-1); i++)
+  {
+     k = n >> 1;
+     while(k <= j)
+     {
+        j -= k;
+        k >>= 1;
+     }
+     j += k;
+     if(i < j)
+     {
+        rtemp    = x[j*2];
+        x[j*2]   = x[i*2];
+        x[i*2]   = rtemp;
+        itemp    = x[j*2+1];
+        x[j*2+1] = x[i*2+1];
+        x[i*2+1] = itemp;
+     }
+   }
+}
+
+
+void cfftr2_dit(float* x, const float* w, short n)
+     {
+         short n2, ie, ia, i, j, k, m;
+         float rtemp, itemp, c, s;
+
+         n2 = n;
+         ie = 1;
+
+         for(k=n; k > 1; k >>= 1)
+         {
+            n2 >>= 1;
+            ia = 0;
+            for(j=0; j < ie; j++)
+            {
+               c = w[2*j];
+               s = w[2*j+1];
+               for(i=0; i < n2; i++)
+               {
+                  m = ia + n2;
+                  rtemp     = c * x[2*m]   + s * x[2*m+1];
+                  itemp     = c * x[2*m+1] - s * x[2*m];
+                  x[2*m]    = x[2*ia]   - rtemp;
+                  x[2*m+1]  = x[2*ia+1] - itemp;
+                  x[2*ia]   = x[2*ia]   + rtemp;
+                  x[2*ia+1] = x[2*ia+1] + itemp;
+                  ia++;
+               }
+               ia += n2;
+            }
+            ie <<= 1;
+         }
+      }
+
+
+void icfftr2_dif(float* x, const float* w, short n)
+           {
+               short n2, ie, ia, i, j, k, m;
+               float rtemp, itemp, c, s;
+
+               n2 = 1;
+               ie = n;
+               for(k=n; k > 1; k >>= 1)
+               {
+                   ie >>= 1;
+                   ia = 0;
+                   for(j=0; j < ie; j++)
+                   {
+                       c = w[2*j];
+                       s = w[2*j+1];
+                       for(i=0; i < n2; i++)
+                       {
+                           m = ia + n2;
+                           rtemp     = x[2*ia]   - x[2*m];
+                           x[2*ia]   = x[2*ia]   + x[2*m];
+                           itemp     = x[2*ia+1] - x[2*m+1];
+                           x[2*ia+1] = x[2*ia+1] + x[2*m+1];
+                           x[2*m]    = c*rtemp   - s*itemp;
+                           x[2*m+1]  = c*itemp   + s*rtemp;
+                           ia++;
+                       }
+                       ia += n2;
+                   }
+                   n2 <<= 1;
+               }
+           }
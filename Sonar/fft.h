@@ -0,0 +1,16 @@
+/***********************************************************
+*  fft.h                                                   *
+*                                                          *
+*  Radix 2 FFT (C equivalents of the DSPLib routines       *
+*  DSPF_sp_cfftr2_dit / DSPF_sp_icfftr2_dif)               *
+*                                                          *
+************************************************************/
+#ifndef FFT_H_
+#define FFT_H_
+
+void tw_genr2fft(float* w, int n);              // twiddle factors for an n point FFT (n/2 complex)
+void bit_rev(float* x, int n);                  // bit reverse a complex vector of n points
+void cfftr2_dit(float* x, const float* w, short n);   // input normal order, output bit reversed
+void icfftr2_dif(float* x, const float* w, short n);  // input bit reversed, output normal order (not scaled by 1/n)
+
+#endif /*FFT_H_*/
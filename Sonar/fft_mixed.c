@@ -0,0 +1,154 @@
+/***********************************************************
+*  fft_mixed.c                                             *
+*                                                          *
+*  Mixed radix (4/2/3/5) complex FFT (portable C)          *
+*                                                          *
+*  Every stage splits the current length len = p x m:      *
+*    y[q + s(p j + r)] = W_len^(j r) x DFT_p( x[q + s(j + m i)] )[r]
+*  with s = product of the radices already done (stride)   *
+*  and the roles of x and y swapped after every stage.     *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include "fft_mixed.h"
+
+#define C3  (-0.5f)
+#define S3  0.86602540378443864676f			// sin(2 pi / 3)
+#define C51 0.30901699437494742410f			// cos(2 pi / 5)
+#define C52 (-0.80901699437494742410f)		// cos(4 pi / 5)
+#define S51 0.95105651629515357212f			// sin(2 pi / 5)
+#define S52 0.58778525229247312917f			// sin(4 pi / 5)
+
+
+int fft_mixed_factor(short *factor, int n)
+{
+	static const short radix[4] = { 4, 2, 3, 5 };
+	int i, count = 0;
+
+	for(i=0;i<4;i++)
+	{
+		while(n % radix[i] == 0 && count < FFT_MAX_FACTORS)
+		{
+			factor[count++] = radix[i];
+			n /= radix[i];
+		}
+	}
+	return n == 1 ? count : 0;
+}
+
+
+void fft_mixed_twiddle(float *w, int n)
+{
+	int i;
+	double e = 2*3.14159265358979323846/n;
+
+	for(i=0;i<n;i++)
+	{
+		w[2*i]   = cos(i*e);
+		w[2*i+1] = -sin(i*e);
+	}
+}
+
+
+void fft_mixed(float *x, float *y, const float *w, const short *factor, int nfactors, int n, int inverse)
+{
+	float *src = x, *dst = y, *tmp;
+	float ar[5], ai[5], br[5], bi[5];
+	float t1r, t1i, t2r, t2i, t3r, t3i, t4r, t4i, ur, ui, vr, vi, wr, wi, sg;
+	int f, p, m, len, s, j, q, r, a, tws;
+
+	sg = inverse ? -1.0f : 1.0f;		// sign of the imaginary part of exp(-j..)
+	len = n;
+	s = 1;
+	for(f=0;f<nfactors;f++)
+	{
+		p = factor[f];
+		m = len/p;
+		tws = n/len;					// W_len^k = W_n^(k tws)
+
+		for(j=0;j<m;j++)
+		{
+			for(q=0;q<s;q++)
+			{
+				for(r=0;r<p;r++)
+				{
+					a = 2*(q + s*(j + m*r));
+					ar[r] = src[a];
+					ai[r] = src[a+1];
+				}
+
+				/*------ DFT of length p ------*/
+				switch(p)
+				{
+				case 2:
+					br[0] = ar[0] + ar[1];	bi[0] = ai[0] + ai[1];
+					br[1] = ar[0] - ar[1];	bi[1] = ai[0] - ai[1];
+					break;
+
+				case 3:
+					t1r = ar[1] + ar[2];	t1i = ai[1] + ai[2];
+					t2r = sg*S3*(ar[1] - ar[2]);	t2i = sg*S3*(ai[1] - ai[2]);
+					ur = ar[0] + C3*t1r;	ui = ai[0] + C3*t1i;
+					br[0] = ar[0] + t1r;	bi[0] = ai[0] + t1i;
+					br[1] = ur + t2i;		bi[1] = ui - t2r;		// u - j t2
+					br[2] = ur - t2i;		bi[2] = ui + t2r;		// u + j t2
+					break;
+
+				case 4:
+					t1r = ar[0] + ar[2];	t1i = ai[0] + ai[2];
+					t2r = ar[0] - ar[2];	t2i = ai[0] - ai[2];
+					t3r = ar[1] + ar[3];	t3i = ai[1] + ai[3];
+					t4r = sg*(ar[1] - ar[3]);	t4i = sg*(ai[1] - ai[3]);
+					br[0] = t1r + t3r;		bi[0] = t1i + t3i;
+					br[2] = t1r - t3r;		bi[2] = t1i - t3i;
+					br[1] = t2r + t4i;		bi[1] = t2i - t4r;		// t2 - j t4
+					br[3] = t2r - t4i;		bi[3] = t2i + t4r;		// t2 + j t4
+					break;
+
+				default:	/* 5 */
+					t1r = ar[1] + ar[4];	t1i = ai[1] + ai[4];
+					t2r = ar[2] + ar[3];	t2i = ai[2] + ai[3];
+					t3r = sg*(ar[1] - ar[4]);	t3i = sg*(ai[1] - ai[4]);
+					t4r = sg*(ar[2] - ar[3]);	t4i = sg*(ai[2] - ai[3]);
+					br[0] = ar[0] + t1r + t2r;	bi[0] = ai[0] + t1i + t2i;
+					ur = ar[0] + C51*t1r + C52*t2r;	ui = ai[0] + C51*t1i + C52*t2i;
+					vr = S51*t3r + S52*t4r;			vi = S51*t3i + S52*t4i;
+					br[1] = ur + vi;	bi[1] = ui - vr;				// u - j v
+					br[4] = ur - vi;	bi[4] = ui + vr;
+					ur = ar[0] + C52*t1r + C51*t2r;	ui = ai[0] + C52*t1i + C51*t2i;
+					vr = S52*t3r - S51*t4r;			vi = S52*t3i - S51*t4i;
+					br[2] = ur + vi;	bi[2] = ui - vr;
+					br[3] = ur - vi;	bi[3] = ui + vr;
+					break;
+				}
+
+				/*------ twiddle + store ------*/
+				a = 2*(q + s*p*j);
+				dst[a] = br[0];
+				dst[a+1] = bi[0];
+				for(r=1;r<p;r++)
+				{
+					wr = w[2*j*r*tws];
+					wi = sg*w[2*j*r*tws+1];
+					a = 2*(q + s*(p*j + r));
+					dst[a]   = br[r]*wr - bi[r]*wi;
+					dst[a+1] = br[r]*wi + bi[r]*wr;
+				}
+			}
+		}
+
+		len = m;
+		s *= p;
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+
+	if(src != x)						// odd number of stages => result in the scratch array
+	{
+		for(a=0;a<2*n;a++)
+		{
+			x[a] = src[a];
+		}
+	}
+}
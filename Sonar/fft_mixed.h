@@ -0,0 +1,20 @@
+/***********************************************************
+*  fft_mixed.h                                             *
+*                                                          *
+*  Mixed radix (4/2/3/5) complex FFT for transform sizes   *
+*  that are not a power of 2. Stockham autosort: input     *
+*  and output in natural order, needs a scratch array.     *
+*                                                          *
+************************************************************/
+#ifndef FFT_MIXED_H_
+#define FFT_MIXED_H_
+
+#define FFT_MAX_FACTORS 16
+
+int  fft_mixed_factor(short *factor, int n);		// radices of n (4 first), 0 if n has other prime factors
+void fft_mixed_twiddle(float *w, int n);			// w[k] = exp(-j 2 pi k / n), n complex
+
+/* x: n complex points in/out, y: n complex scratch, inverse != 0 => exp(+j..), not scaled by 1/n */
+void fft_mixed(float *x, float *y, const float *w, const short *factor, int nfactors, int n, int inverse);
+
+#endif /*FFT_MIXED_H_*/
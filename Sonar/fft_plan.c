@@ -0,0 +1,105 @@
+/***********************************************************
+*  fft_plan.c                                              *
+*                                                          *
+*  Complex FFT of the correlator (portable C)              *
+*                                                          *
+************************************************************/
+#include "fft.h"
+#include "fft_r4.h"
+#include "convert.h"
+#include "fft_plan.h"
+
+
+int fft_plan_init(fft_plan_t *plan, short n)
+{
+	int i;
+#ifndef FFT_MIXED_RADIX
+	int j, k;
+#endif
+
+	if(n > FFT_PLAN_MAX || n < 4)
+	{
+		return 0;
+	}
+	plan->n = n;
+	plan->twiddle = plan->twiddle_store;
+
+#ifdef FFT_MIXED_RADIX
+	plan->nfactors = fft_mixed_factor(plan->factor, n);
+	if(plan->nfactors == 0)
+	{
+		return 0;
+	}
+	fft_mixed_twiddle(plan->twiddle, n);
+	for(i=0;i<n;i++)								// self sorting => natural order
+	{
+		plan->bin[i] = i;
+	}
+#else
+	if(n & (n-1))
+	{
+		return 0;
+	}
+	tw_genr2fft(plan->twiddle, n);					//generates coefficient table for fft
+	bit_rev(plan->twiddle, n>>1);					//bit reverse the vector (right format for fft dit)
+
+	j = 0;											// same bit reversed order as bit_rev / cfftr2_dit
+	for(i=0;i<n;i++)
+	{
+		plan->bin[i] = j;
+		k = n >> 1;
+		while(k && k <= j)
+		{
+			j -= k;
+			k >>= 1;
+		}
+		j += k;
+	}
+#endif
+	return 1;
+}
+
+
+void fft_plan_relocate(fft_plan_t *plan, float *twiddle)
+{
+	int i;
+
+	for(i=0;i<FFT_TWIDDLE(plan->n);i++)
+	{
+		twiddle[i] = plan->twiddle[i];
+	}
+	plan->twiddle = twiddle;
+}
+
+
+void fft_forward(const fft_plan_t *plan, float *x, float *scratch)
+{
+#ifdef FFT_MIXED_RADIX
+	fft_mixed(x, scratch, plan->twiddle, plan->factor, plan->nfactors, plan->n, 0);
+#else
+	cfft_dit(x, plan->twiddle, plan->n);			// radix 2^2, output bit reversed
+#endif
+}
+
+
+void fft_forward_i16(const fft_plan_t *plan, const short *re, const short *im, short step, short live,
+                     float *x, float *scratch)
+{
+#ifdef FFT_MIXED_RADIX
+	convert_i16(x, re, im, step, live, plan->n);
+	fft_mixed(x, scratch, plan->twiddle, plan->factor, plan->nfactors, plan->n, 0);
+#else
+	convert_dit_pass(x, plan->twiddle, plan->n, re, im, step, live);		// format = first radix 2^2 pass
+	cfft_dit_from(x, plan->twiddle, plan->n, plan->n >> 2);
+#endif
+}
+
+
+void fft_inverse(const fft_plan_t *plan, float *x, float *scratch)
+{
+#ifdef FFT_MIXED_RADIX
+	fft_mixed(x, scratch, plan->twiddle, plan->factor, plan->nfactors, plan->n, 1);
+#else
+	icfft_dif(x, plan->twiddle, plan->n);			// radix 2^2, input bit reversed
+#endif
+}
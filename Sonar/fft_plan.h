@@ -0,0 +1,53 @@
+/***********************************************************
+*  fft_plan.h                                              *
+*                                                          *
+*  Complex FFT of the correlators (FFT_N/2 points for the *
+*  real input path, FFT_N for the stereo one), either      *
+*  the radix 2 dit/dif pair (FFT_N power of 2) or the      *
+*  mixed radix engine (FFT_MIXED_RADIX).                   *
+*                                                          *
+*  fft_forward : input natural order, frequency k ends up  *
+*                at position bin[k] (bit reversed / natural)*
+*  fft_forward_i16 : same from 16 bit samples, converted   *
+*                in the first pass (convert.h)             *
+*  fft_inverse : input at the bin[] positions, output      *
+*                natural order, not scaled by 1/n          *
+*                                                          *
+************************************************************/
+#ifndef FFT_PLAN_H_
+#define FFT_PLAN_H_
+
+#include "sonar_params.h"
+
+#define FFT_PLAN_MAX FFT_N				// complex points
+
+#ifdef FFT_MIXED_RADIX
+#include "fft_mixed.h"
+#define FFT_TWIDDLE(n) (2*(n))				// exp(-j 2 pi k / n), k = 0..n-1
+#define FFT_SCRATCH(n) (2*(n))				// Stockham works out of place
+#else
+#define FFT_TWIDDLE(n) (n)					// n/2 complex, bit reversed
+#define FFT_SCRATCH(n) 0					// in place
+#endif
+#define FFT_TWIDDLE_LEN FFT_TWIDDLE(FFT_PLAN_MAX)
+#define FFT_SCRATCH_LEN FFT_SCRATCH(FFT_N/2)	// floats behind the data of the real input transform
+
+typedef struct {
+	short n;								// complex points
+	float *twiddle;							// twiddle_store, or its copy in on-chip RAM (fft_plan_relocate)
+	float twiddle_store[FFT_TWIDDLE_LEN];
+	unsigned short bin[FFT_PLAN_MAX];		// position of frequency k in the spectrum
+#ifdef FFT_MIXED_RADIX
+	short nfactors;
+	short factor[FFT_MAX_FACTORS];
+#endif
+} fft_plan_t;
+
+int  fft_plan_init(fft_plan_t *plan, short n);		// 0 if n is not supported by the selected engine
+void fft_plan_relocate(fft_plan_t *plan, float *twiddle);	// copies the FFT_TWIDDLE(n) floats the passes read
+void fft_forward(const fft_plan_t *plan, float *x, float *scratch);
+void fft_forward_i16(const fft_plan_t *plan, const short *re, const short *im, short step, short live,
+                     float *x, float *scratch);		// x[] = FFT of re[p*step] + j im[p*step], p < live, zero padded
+void fft_inverse(const fft_plan_t *plan, float *x, float *scratch);
+
+#endif /*FFT_PLAN_H_*/
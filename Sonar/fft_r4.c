@@ -0,0 +1,221 @@
+/***********************************************************
+*  fft_r4.c                                                *
+*                                                          *
+*  Radix 2^2 FFT: two radix 2 stages per pass over x       *
+*  (portable C, no CSL => also builds on the host)         *
+*                                                          *
+*  DIT pass with block size n2 and q = n2/4, for each      *
+*  group j and each i < q the 4 points                     *
+*      a = j*n2 + i, b = a+q, c = a+2q, d = a+3q           *
+*  go through stage 1 (a,c) (b,d) with w[j] and stage 2    *
+*  (a,b) with w[2j], (c,d) with w[2j+1]. The DIF pass is   *
+*  the mirror image. An odd number of stages ends (DIT) or *
+*  starts (DIF) with one plain radix 2 stage.              *
+*                                                          *
+************************************************************/
+#include "fft_r4.h"
+#include "fft_r4_bfly.h"
+
+
+/*------- portable reference -------*/
+
+void cfftr4_dit(float* x, const float* w, short n)
+{
+	cfftr4_dit_from(x, w, n, n);
+}
+
+
+void cfftr4_dit_from(float* x, const float* w, short n, short first)
+{
+	int n2, q, ie, i, j, a;
+	float c0, s0, c1, s1, c2, s2;
+
+	ie = n/first;
+	for(n2=first; n2 >= 4; n2 >>= 2)			// stages (ie, n2/2) and (2ie, n2/4)
+	{
+		q = n2 >> 2;
+		for(j=0; j < ie; j++)
+		{
+			c0 = w[2*j];    s0 = w[2*j+1];
+			c1 = w[4*j];    s1 = w[4*j+1];
+			c2 = w[4*j+2];  s2 = w[4*j+3];
+			for(i=0; i < q; i++)
+			{
+				a = j*n2 + i;
+				DIT_QUAD(x, a, q, c0, s0, c1, s1, c2, s2);
+			}
+		}
+		ie <<= 2;
+	}
+	if(n2 == 2)								// odd number of stages: last one alone
+	{
+		for(j=0; j < ie; j++)
+		{
+			DIT_BFLY(x, 2*j, 2*j+1, w[2*j], w[2*j+1]);
+		}
+	}
+}
+
+
+void icfftr4_dif(float* x, const float* w, short n)
+{
+	int n2, q, ie, i, j, k, a;
+	float c0, s0, c1, s1, c2, s2;
+
+	n2 = 1;
+	ie = n;
+	for(k=n; k > 2; k >>= 2);
+	if(k == 2)								// odd number of stages: first one alone
+	{
+		ie >>= 1;
+		for(j=0; j < ie; j++)
+		{
+			DIF_BFLY(x, 2*j, 2*j+1, w[2*j], w[2*j+1]);
+		}
+		n2 = 2;
+	}
+	for(; ie >= 4; ie >>= 2)				// stages (ie/2, n2) and (ie/4, 2n2)
+	{
+		q = n2;
+		for(j=0; j < (ie >> 2); j++)
+		{
+			c0 = w[2*j];    s0 = w[2*j+1];
+			c1 = w[4*j];    s1 = w[4*j+1];
+			c2 = w[4*j+2];  s2 = w[4*j+3];
+			for(i=0; i < q; i++)
+			{
+				a = 4*j*n2 + i;
+				DIF_QUAD(x, a, q, c0, s0, c1, s1, c2, s2);
+			}
+		}
+		n2 <<= 2;
+	}
+}
+
+
+/*------- C67x friendly version -------*/
+/* Same arithmetic. The loop with the longer trip count is always the inner one
+   (butterflies of one group in the early passes, groups in the late passes where
+   q drops to 1 or 2), and restrict / trip count hints let cl6x pipeline it. */
+
+void cfftr4_dit_c67(float* x, const float* w, short n)
+{
+	cfftr4_dit_c67_from(x, w, n, n);
+}
+
+
+void cfftr4_dit_c67_from(float* RESTRICT x, const float* RESTRICT w, short n, short first)
+{
+	int n2, q, ie, i, j, a;
+	float c0, s0, c1, s1, c2, s2;
+
+#ifdef _TMS320C6X
+	_nassert((int)x % 8 == 0);
+	_nassert((int)w % 8 == 0);
+#endif
+	ie = n/first;
+	for(n2=first; n2 >= 4; n2 >>= 2)
+	{
+		q = n2 >> 2;
+		if(q >= ie)
+		{
+			for(j=0; j < ie; j++)
+			{
+				c0 = w[2*j];    s0 = w[2*j+1];
+				c1 = w[4*j];    s1 = w[4*j+1];
+				c2 = w[4*j+2];  s2 = w[4*j+3];
+				#pragma MUST_ITERATE(1)
+				for(i=0; i < q; i++)
+				{
+					a = j*n2 + i;
+					DIT_QUAD(x, a, q, c0, s0, c1, s1, c2, s2);
+				}
+			}
+		}
+		else
+		{
+			for(i=0; i < q; i++)
+			{
+				#pragma MUST_ITERATE(2)
+				for(j=0; j < ie; j++)
+				{
+					c0 = w[2*j];    s0 = w[2*j+1];
+					c1 = w[4*j];    s1 = w[4*j+1];
+					c2 = w[4*j+2];  s2 = w[4*j+3];
+					a = j*n2 + i;
+					DIT_QUAD(x, a, q, c0, s0, c1, s1, c2, s2);
+				}
+			}
+		}
+		ie <<= 2;
+	}
+	if(n2 == 2)
+	{
+		#pragma MUST_ITERATE(2)
+		for(j=0; j < ie; j++)
+		{
+			DIT_BFLY(x, 2*j, 2*j+1, w[2*j], w[2*j+1]);
+		}
+	}
+}
+
+
+void icfftr4_dif_c67(float* RESTRICT x, const float* RESTRICT w, short n)
+{
+	int n2, q, ie, g, i, j, k, a;
+	float c0, s0, c1, s1, c2, s2;
+
+#ifdef _TMS320C6X
+	_nassert((int)x % 8 == 0);
+	_nassert((int)w % 8 == 0);
+#endif
+	n2 = 1;
+	ie = n;
+	for(k=n; k > 2; k >>= 2);
+	if(k == 2)
+	{
+		ie >>= 1;
+		#pragma MUST_ITERATE(2)
+		for(j=0; j < ie; j++)
+		{
+			DIF_BFLY(x, 2*j, 2*j+1, w[2*j], w[2*j+1]);
+		}
+		n2 = 2;
+	}
+	for(; ie >= 4; ie >>= 2)
+	{
+		q = n2;
+		g = ie >> 2;
+		if(q >= g)
+		{
+			for(j=0; j < g; j++)
+			{
+				c0 = w[2*j];    s0 = w[2*j+1];
+				c1 = w[4*j];    s1 = w[4*j+1];
+				c2 = w[4*j+2];  s2 = w[4*j+3];
+				#pragma MUST_ITERATE(1)
+				for(i=0; i < q; i++)
+				{
+					a = 4*j*n2 + i;
+					DIF_QUAD(x, a, q, c0, s0, c1, s1, c2, s2);
+				}
+			}
+		}
+		else
+		{
+			for(i=0; i < q; i++)
+			{
+				#pragma MUST_ITERATE(2)
+				for(j=0; j < g; j++)
+				{
+					c0 = w[2*j];    s0 = w[2*j+1];
+					c1 = w[4*j];    s1 = w[4*j+1];
+					c2 = w[4*j+2];  s2 = w[4*j+3];
+					a = 4*j*n2 + i;
+					DIF_QUAD(x, a, q, c0, s0, c1, s1, c2, s2);
+				}
+			}
+		}
+		n2 <<= 2;
+	}
+}
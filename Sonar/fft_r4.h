@@ -0,0 +1,50 @@
+/***********************************************************
+*  fft_r4.h                                                *
+*                                                          *
+*  Radix 2 FFT with two stages fused per pass (radix 2^2): *
+*  same twiddle table (bit reversed, tw_genr2fft+bit_rev), *
+*  same orders and the same butterflies as cfftr2_dit /    *
+*  icfftr2_dif, but every pass loads 4 points, runs the 4  *
+*  butterflies of two stages and stores them once, so a    *
+*  n point transform makes ceil(log2(n)/2) passes over x   *
+*  instead of log2(n).                                     *
+*                                                          *
+*  cfftr4_dit / icfftr4_dif           portable reference   *
+*  cfftr4_dit_c67 / icfftr4_dif_c67   restrict + trip      *
+*      count hints, loop order switched for the late       *
+*      stages so the inner loop stays long (software       *
+*      pipelining on the C67x)                             *
+*  cfftr4_dit_avx2 / icfftr4_dif_avx2 host batch version   *
+*      (only with -mavx2 -mfma, 4 butterflies per vector)  *
+*  ..._from(x, w, n, first): the passes from block size    *
+*      first on (n, n/4, n/16 ...), after a first pass     *
+*      done elsewhere (convert.h)                          *
+*                                                          *
+************************************************************/
+#ifndef FFT_R4_H_
+#define FFT_R4_H_
+
+void cfftr4_dit(float* x, const float* w, short n);			// input normal order, output bit reversed
+void icfftr4_dif(float* x, const float* w, short n);		// input bit reversed, output normal order (not scaled)
+
+void cfftr4_dit_c67(float* x, const float* w, short n);
+void icfftr4_dif_c67(float* x, const float* w, short n);
+
+void cfftr4_dit_from(float* x, const float* w, short n, short first);
+void cfftr4_dit_c67_from(float* x, const float* w, short n, short first);
+
+#ifdef __AVX2__
+void cfftr4_dit_avx2(float* x, const float* w, short n);
+void icfftr4_dif_avx2(float* x, const float* w, short n);
+void cfftr4_dit_avx2_from(float* x, const float* w, short n, short first);
+
+#define cfft_dit cfftr4_dit_avx2			// kernels used by the correlators
+#define icfft_dif icfftr4_dif_avx2
+#define cfft_dit_from cfftr4_dit_avx2_from
+#else
+#define cfft_dit cfftr4_dit_c67
+#define icfft_dif icfftr4_dif_c67
+#define cfft_dit_from cfftr4_dit_c67_from
+#endif
+
+#endif /*FFT_R4_H_*/
@@ -0,0 +1,166 @@
+/***********************************************************
+*  fft_r4_avx2.c                                           *
+*                                                          *
+*  AVX2 version of the radix 2^2 kernels for the host      *
+*  batch tools (empty unless built with -mavx2)            *
+*                                                          *
+*  One __m256 holds 4 interleaved complex points, so the   *
+*  passes with q >= 4 run 4 butterflies per instruction.   *
+*  The products are kept as separate mul/add (no FMA)      *
+*  => same rounding as cfftr4_dit / icfftr4_dif. The last  *
+*  DIT passes (first DIF passes) with q < 4 stay scalar.   *
+*                                                          *
+************************************************************/
+#ifdef __AVX2__
+
+#include <immintrin.h>
+#include "fft_r4.h"
+#include "fft_r4_bfly.h"
+
+/* c x + sw swap(x): with sw = (s, -s ...) x * (c - js) as in the DIT butterfly,
+   with sw = (-s, s ...) x * (c + js) as in the DIF butterfly */
+static inline __m256 mul_tw(__m256 x, __m256 c, __m256 sw)
+{
+	return _mm256_add_ps(_mm256_mul_ps(c, x), _mm256_mul_ps(sw, _mm256_permute_ps(x, 0xB1)));
+}
+
+static inline __m256 sign_pair(float re, float im)
+{
+	return _mm256_setr_ps(re, im, re, im, re, im, re, im);
+}
+
+
+void cfftr4_dit_avx2(float* x, const float* w, short n)
+{
+	cfftr4_dit_avx2_from(x, w, n, n);
+}
+
+
+void cfftr4_dit_avx2_from(float* x, const float* w, short n, short first)
+{
+	int n2, q, ie, i, j, a;
+	float c0, s0, c1, s1, c2, s2;
+
+	ie = n/first;
+	for(n2=first; n2 >= 4; n2 >>= 2)
+	{
+		q = n2 >> 2;
+		for(j=0; j < ie; j++)
+		{
+			c0 = w[2*j];    s0 = w[2*j+1];
+			c1 = w[4*j];    s1 = w[4*j+1];
+			c2 = w[4*j+2];  s2 = w[4*j+3];
+			if(q >= 4)
+			{
+				__m256 vc0 = _mm256_set1_ps(c0), vs0 = sign_pair(s0, -s0);
+				__m256 vc1 = _mm256_set1_ps(c1), vs1 = sign_pair(s1, -s1);
+				__m256 vc2 = _mm256_set1_ps(c2), vs2 = sign_pair(s2, -s2);
+				float *pa = x + 2*j*n2, *pb = pa + 2*q, *pc = pb + 2*q, *pd = pc + 2*q;
+
+				for(i=0; i < 2*q; i += 8)
+				{
+					__m256 va = _mm256_loadu_ps(pa+i), vb = _mm256_loadu_ps(pb+i);
+					__m256 vc = _mm256_loadu_ps(pc+i), vd = _mm256_loadu_ps(pd+i);
+					__m256 t;
+
+					t  = mul_tw(vc, vc0, vs0);
+					vc = _mm256_sub_ps(va, t);
+					va = _mm256_add_ps(va, t);
+					t  = mul_tw(vd, vc0, vs0);
+					vd = _mm256_sub_ps(vb, t);
+					vb = _mm256_add_ps(vb, t);
+
+					t  = mul_tw(vb, vc1, vs1);
+					_mm256_storeu_ps(pb+i, _mm256_sub_ps(va, t));
+					_mm256_storeu_ps(pa+i, _mm256_add_ps(va, t));
+					t  = mul_tw(vd, vc2, vs2);
+					_mm256_storeu_ps(pd+i, _mm256_sub_ps(vc, t));
+					_mm256_storeu_ps(pc+i, _mm256_add_ps(vc, t));
+				}
+			}
+			else
+			{
+				for(i=0; i < q; i++)
+				{
+					a = j*n2 + i;
+					DIT_QUAD(x, a, q, c0, s0, c1, s1, c2, s2);
+				}
+			}
+		}
+		ie <<= 2;
+	}
+	if(n2 == 2)
+	{
+		for(j=0; j < ie; j++)
+		{
+			DIT_BFLY(x, 2*j, 2*j+1, w[2*j], w[2*j+1]);
+		}
+	}
+}
+
+
+void icfftr4_dif_avx2(float* x, const float* w, short n)
+{
+	int n2, q, ie, i, j, k, a;
+	float c0, s0, c1, s1, c2, s2;
+
+	n2 = 1;
+	ie = n;
+	for(k=n; k > 2; k >>= 2);
+	if(k == 2)
+	{
+		ie >>= 1;
+		for(j=0; j < ie; j++)
+		{
+			DIF_BFLY(x, 2*j, 2*j+1, w[2*j], w[2*j+1]);
+		}
+		n2 = 2;
+	}
+	for(; ie >= 4; ie >>= 2)
+	{
+		q = n2;
+		for(j=0; j < (ie >> 2); j++)
+		{
+			c0 = w[2*j];    s0 = w[2*j+1];
+			c1 = w[4*j];    s1 = w[4*j+1];
+			c2 = w[4*j+2];  s2 = w[4*j+3];
+			if(q >= 4)
+			{
+				__m256 vc0 = _mm256_set1_ps(c0), vs0 = sign_pair(-s0, s0);
+				__m256 vc1 = _mm256_set1_ps(c1), vs1 = sign_pair(-s1, s1);
+				__m256 vc2 = _mm256_set1_ps(c2), vs2 = sign_pair(-s2, s2);
+				float *pa = x + 8*j*n2, *pb = pa + 2*q, *pc = pb + 2*q, *pd = pc + 2*q;
+
+				for(i=0; i < 2*q; i += 8)
+				{
+					__m256 va = _mm256_loadu_ps(pa+i), vb = _mm256_loadu_ps(pb+i);
+					__m256 vc = _mm256_loadu_ps(pc+i), vd = _mm256_loadu_ps(pd+i);
+					__m256 t;
+
+					t  = _mm256_sub_ps(va, vb);
+					va = _mm256_add_ps(va, vb);
+					vb = mul_tw(t, vc1, vs1);
+					t  = _mm256_sub_ps(vc, vd);
+					vc = _mm256_add_ps(vc, vd);
+					vd = mul_tw(t, vc2, vs2);
+
+					_mm256_storeu_ps(pa+i, _mm256_add_ps(va, vc));
+					_mm256_storeu_ps(pc+i, mul_tw(_mm256_sub_ps(va, vc), vc0, vs0));
+					_mm256_storeu_ps(pb+i, _mm256_add_ps(vb, vd));
+					_mm256_storeu_ps(pd+i, mul_tw(_mm256_sub_ps(vb, vd), vc0, vs0));
+				}
+			}
+			else
+			{
+				for(i=0; i < q; i++)
+				{
+					a = 4*j*n2 + i;
+					DIF_QUAD(x, a, q, c0, s0, c1, s1, c2, s2);
+				}
+			}
+		}
+		n2 <<= 2;
+	}
+}
+
+#endif /*__AVX2__*/
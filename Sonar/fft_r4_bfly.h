@@ -0,0 +1,86 @@
+/***********************************************************
+*  fft_r4_bfly.h                                           *
+*                                                          *
+*  Butterflies shared by the radix 2^2 kernels             *
+*  (fft_r4.c, fft_r4_avx2.c, convert.c), not a public     *
+*  interface                                               *
+*                                                          *
+************************************************************/
+#ifndef FFT_R4_BFLY_H_
+#define FFT_R4_BFLY_H_
+
+#ifdef _TMS320C6X
+#define RESTRICT restrict
+#else
+#define RESTRICT __restrict
+#endif
+
+/* DIT butterfly of cfftr2_dit: x[m] = x[ia] - w'*x[m], x[ia] = x[ia] + w'*x[m] */
+#define DIT_BFLY(x, ia, m, c, s)                                   \
+	{                                                              \
+		float rt = (c) * x[2*(m)]   + (s) * x[2*(m)+1];            \
+		float it = (c) * x[2*(m)+1] - (s) * x[2*(m)];              \
+		x[2*(m)]    = x[2*(ia)]   - rt;                            \
+		x[2*(m)+1]  = x[2*(ia)+1] - it;                            \
+		x[2*(ia)]   = x[2*(ia)]   + rt;                            \
+		x[2*(ia)+1] = x[2*(ia)+1] + it;                            \
+	}
+
+/* DIF butterfly of icfftr2_dif: x[ia] = x[ia] + x[m], x[m] = w*(x[ia] - x[m]) */
+#define DIF_BFLY(x, ia, m, c, s)                                   \
+	{                                                              \
+		float rt = x[2*(ia)]   - x[2*(m)];                         \
+		float it = x[2*(ia)+1] - x[2*(m)+1];                       \
+		x[2*(ia)]   = x[2*(ia)]   + x[2*(m)];                      \
+		x[2*(ia)+1] = x[2*(ia)+1] + x[2*(m)+1];                    \
+		x[2*(m)]    = (c)*rt - (s)*it;                             \
+		x[2*(m)+1]  = (c)*it + (s)*rt;                             \
+	}
+
+/* the 4 points of one fused DIT pass, kept in registers between the 2 stages */
+#define DIT_QUAD(x, a, q, c0, s0, c1, s1, c2, s2)                  \
+	{                                                              \
+		float ar = x[2*(a)],       ai = x[2*(a)+1];                \
+		float br = x[2*(a+q)],     bi = x[2*(a+q)+1];              \
+		float cr = x[2*(a+2*q)],   ci = x[2*(a+2*q)+1];            \
+		float dr = x[2*(a+3*q)],   di = x[2*(a+3*q)+1];            \
+		DIT_QUAD_STORE(x, a, q, c0, s0, c1, s1, c2, s2);           \
+	}
+
+/* same from the inputs ar/ai .. dr/di already in registers (overwritten) */
+#define DIT_QUAD_STORE(x, a, q, c0, s0, c1, s1, c2, s2)            \
+	{                                                              \
+		float rt, it;                                              \
+		rt = c0*cr + s0*ci;  it = c0*ci - s0*cr;                   \
+		cr = ar - rt;  ci = ai - it;  ar = ar + rt;  ai = ai + it; \
+		rt = c0*dr + s0*di;  it = c0*di - s0*dr;                   \
+		dr = br - rt;  di = bi - it;  br = br + rt;  bi = bi + it; \
+		rt = c1*br + s1*bi;  it = c1*bi - s1*br;                   \
+		x[2*(a+q)]     = ar - rt;  x[2*(a+q)+1]   = ai - it;       \
+		x[2*(a)]       = ar + rt;  x[2*(a)+1]     = ai + it;       \
+		rt = c2*dr + s2*di;  it = c2*di - s2*dr;                   \
+		x[2*(a+3*q)]   = cr - rt;  x[2*(a+3*q)+1] = ci - it;       \
+		x[2*(a+2*q)]   = cr + rt;  x[2*(a+2*q)+1] = ci + it;       \
+	}
+
+/* the 4 points of one fused DIF pass (stage 1 twiddles c1/s1, c2/s2, stage 2 c0/s0) */
+#define DIF_QUAD(x, a, q, c0, s0, c1, s1, c2, s2)                  \
+	{                                                              \
+		float ar = x[2*(a)],       ai = x[2*(a)+1];                \
+		float br = x[2*(a+q)],     bi = x[2*(a+q)+1];              \
+		float cr = x[2*(a+2*q)],   ci = x[2*(a+2*q)+1];            \
+		float dr = x[2*(a+3*q)],   di = x[2*(a+3*q)+1];            \
+		float rt, it;                                              \
+		rt = ar - br;  it = ai - bi;  ar = ar + br;  ai = ai + bi; \
+		br = c1*rt - s1*it;  bi = c1*it + s1*rt;                   \
+		rt = cr - dr;  it = ci - di;  cr = cr + dr;  ci = ci + di; \
+		dr = c2*rt - s2*it;  di = c2*it + s2*rt;                   \
+		rt = ar - cr;  it = ai - ci;                               \
+		x[2*(a)]       = ar + cr;  x[2*(a)+1]     = ai + ci;       \
+		x[2*(a+2*q)]   = c0*rt - s0*it;  x[2*(a+2*q)+1] = c0*it + s0*rt; \
+		rt = br - dr;  it = bi - di;                               \
+		x[2*(a+q)]     = br + dr;  x[2*(a+q)+1]   = bi + di;       \
+		x[2*(a+3*q)]   = c0*rt - s0*it;  x[2*(a+3*q)+1] = c0*it + s0*rt; \
+	}
+
+#endif /*FFT_R4_BFLY_H_*/
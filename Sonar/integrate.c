@@ -0,0 +1,123 @@
+/***********************************************************
+*  integrate.c                                             *
+*                                                          *
+*  Coherent multi ping integration (portable C)            *
+*                                                          *
+************************************************************/
+#include "fft_plan.h"
+#include "rfft.h"
+#include "integrate.h"
+#include "profile.h"
+
+
+void integrate_init(integrate_t *in, short k, short mode)
+{
+	int i;
+
+	in->k = k < 1 ? 1 : k > INTEGRATE_MAX ? INTEGRATE_MAX : k;
+	in->mode = mode;
+	in->count = 0;
+	in->head = 0;
+	for(i=0;i<FFT_N;i++)
+	{
+		in->sum[i] = 0;
+	}
+}
+
+
+static void integrate_resum(integrate_t *in)	// sliding: sum again from the ring, drops the rounding of the subtractions
+{
+	int i, j;
+	float s;
+
+	for(i=0;i<FFT_N;i++)
+	{
+		s = 0;
+		for(j=0;j<in->k;j++)
+		{
+			s += in->ring[j][i];
+		}
+		in->sum[i] = s;
+	}
+}
+
+
+short integrate_ping(integrate_t *in, const short *capture, const mf_template_t *tpl, float *work)
+{
+	int i;
+	float p, scale;
+	float *slot;
+	PROF_DECL(t)
+
+	/*--- product spectrum (as correlate_frequency) ---*/
+	PROF_START(t);
+	fft_forward_i16(&tpl->plan, capture, capture+1, 2, RESPONSE_MONO/2, work, work+FFT_N);
+	PROF_MARK(t, PROF_FFT);
+	rfft_multiply(work, tpl->spectrum, tpl->split, tpl->plan.bin, FFT_N);
+	PROF_MARK(t, PROF_MULTIPLY);
+
+	/*------------- add ----------------*/
+	scale = 1.0f/in->k;
+	if(in->mode == INTEGRATE_SLIDING)
+	{
+		slot = in->ring[in->head];
+		if(in->count == in->k)				// window full => the oldest product leaves
+		{
+			for(i=0;i<FFT_N;i++)
+			{
+				p = work[i];
+				in->sum[i] += p - slot[i];
+				slot[i] = p;
+			}
+		}
+		else
+		{
+			for(i=0;i<FFT_N;i++)
+			{
+				p = work[i];
+				in->sum[i] += p;
+				slot[i] = p;
+			}
+			in->count++;
+		}
+		in->head = in->head+1 == in->k ? 0 : in->head+1;
+		if(in->count < in->k)
+		{
+			PROF_MARK(t, PROF_SUM);
+			return 0;
+		}
+		if(in->head == 0)
+		{
+			integrate_resum(in);			// once per k pings
+		}
+		for(i=0;i<FFT_N;i++)
+		{
+			work[i] = scale*in->sum[i];
+		}
+	}
+	else
+	{
+		if(++in->count < in->k)
+		{
+			for(i=0;i<FFT_N;i++)
+			{
+				in->sum[i] += work[i];
+			}
+			PROF_MARK(t, PROF_SUM);
+			return 0;
+		}
+		for(i=0;i<FFT_N;i++)				// last ping of the block: out and start again
+		{
+			work[i] = scale*(in->sum[i] + work[i]);
+			in->sum[i] = 0;
+		}
+		in->count = 0;
+	}
+
+	PROF_MARK(t, PROF_SUM);
+
+	/*------- one inverse transform ------*/
+	fft_inverse(&tpl->plan, work, work+FFT_N);
+	PROF_MARK(t, PROF_IFFT);
+	return 1;
+}
@@ -0,0 +1,51 @@
+/***********************************************************
+*  integrate.h                                             *
+*                                                          *
+*  Coherent integration over K pings in the frequency      *
+*  domain: the product spectrum of each ping (forward FFT  *
+*  x template, before the inverse transform) is summed,    *
+*  the inverse transform is linear, so one IFFT of the sum *
+*  gives the sum of the K correlations. The echo adds up   *
+*  in phase, the noise does not => about sqrt(K) more      *
+*  SNR, without a longer sweep and without K inverse FFTs. *
+*                                                          *
+*  Coherent means the echo keeps its delay and phase from  *
+*  ping to ping (sonar and target at rest, pings locked to *
+*  the sample clock as with the EDMA).                     *
+*                                                          *
+*  INTEGRATE_BLOCK   : one result every K pings, the sum   *
+*                      starts again afterwards             *
+*  INTEGRATE_SLIDING : one result per ping over the last K *
+*                      (ring of the last K products, the   *
+*                      oldest is subtracted)               *
+*                                                          *
+************************************************************/
+#ifndef INTEGRATE_H_
+#define INTEGRATE_H_
+
+#include "sonar_params.h"
+#include "mf_template.h"
+
+#define INTEGRATE_MAX 16				// pings of the sliding window
+
+#define INTEGRATE_BLOCK 0
+#define INTEGRATE_SLIDING 1
+
+typedef struct {
+	short k;							// pings per result, 1..INTEGRATE_MAX
+	short mode;							// INTEGRATE_BLOCK or INTEGRATE_SLIDING
+	short count;						// products in the sum
+	short head;							// sliding: slot of the oldest product
+	float sum[FFT_N];					// sum of the products (FFT_N/2 complex, spectrum order)
+	float ring[INTEGRATE_MAX][FFT_N];	// sliding: the last k products
+} integrate_t;
+
+void integrate_init(integrate_t *in, short k, short mode);	// also starts again after a change of k / mode
+
+/* one ping: forward transform and template multiplication as correlate_frequency, added to the sum.
+   capture : as for correlate_frequency, work : CORR_WORK_LEN floats
+   returns 1 when work holds the integrated correlation (mean of the last k, index = lag),
+   0 while the sum is still filling (block: k-1 pings out of k) */
+short integrate_ping(integrate_t *in, const short *capture, const mf_template_t *tpl, float *work);
+
+#endif /*INTEGRATE_H_*/
@@ -0,0 +1,109 @@
+/***********************************************************
+*  meas_ring.c                                             *
+*                                                          *
+*  Single producer / single consumer measurement ring      *
+*  (portable C)                                            *
+*                                                          *
+************************************************************/
+#include "meas_ring.h"
+
+
+void meas_ring_init(meas_ring_t *ring)
+{
+	ring->head = 0;
+	ring->tail = 0;
+	ring->lost = 0;
+}
+
+
+static unsigned int meas_sum(const unsigned int *w)
+{
+	unsigned int sum = MEAS_SYNC;
+	int i;
+
+	for(i=0;i<MEAS_WORDS-1;i++)
+	{
+		sum += w[i];
+	}
+	return sum;
+}
+
+
+void meas_seal(meas_t *m)
+{
+	m->sync = MEAS_SYNC;
+	m->reserved = 0;
+	m->check = meas_sum((const unsigned int *)m);
+}
+
+
+int meas_valid(const meas_t *m)
+{
+	return m->sync == MEAS_SYNC && m->check == meas_sum((const unsigned int *)m);
+}
+
+
+int meas_put(meas_ring_t *ring, meas_t *m)
+{
+	volatile unsigned int *dst;
+	const unsigned int *src;
+	unsigned int head = ring->head;
+	int i;
+
+	if(head - ring->tail >= MEAS_RING)		// full: the new record is dropped, the old ones stay in order
+	{
+		ring->lost++;
+		return 0;
+	}
+	m->lost = ring->lost;
+	meas_seal(m);
+	dst = (volatile unsigned int *)&ring->rec[head & (MEAS_RING-1)];
+	src = (const unsigned int *)m;
+	for(i=0;i<MEAS_WORDS;i++)
+	{
+		dst[i] = src[i];
+	}
+	ring->head = head + 1;					// publish after the record
+	return 1;
+}
+
+
+const meas_t *meas_peek(const meas_ring_t *ring)
+{
+	unsigned int tail = ring->tail;
+
+	return ring->head == tail ? 0 : &ring->rec[tail & (MEAS_RING-1)];
+}
+
+
+void meas_pop(meas_ring_t *ring)
+{
+	ring->tail = ring->tail + 1;			// the slot may be written again from now on
+}
+
+
+int meas_get(meas_ring_t *ring, meas_t *m)
+{
+	const volatile unsigned int *src;
+	unsigned int *dst;
+	int i;
+
+	src = (const volatile unsigned int *)meas_peek(ring);
+	if(src == 0)
+	{
+		return 0;
+	}
+	dst = (unsigned int *)m;
+	for(i=0;i<MEAS_WORDS;i++)
+	{
+		dst[i] = src[i];
+	}
+	meas_pop(ring);
+	return 1;
+}
+
+
+unsigned int meas_fill(const meas_ring_t *ring)
+{
+	return ring->head - ring->tail;
+}
@@ -0,0 +1,73 @@
+/***********************************************************
+*  meas_ring.h                                             *
+*                                                          *
+*  Measurements of the processed pings: fixed 64 byte      *
+*  records in a single producer / single consumer ring.    *
+*  process_SWI writes (meas_put), the RTDX task drains it  *
+*  (meas_peek / meas_pop) => no lock, no torn record, and  *
+*  a reader that falls behind loses whole records that     *
+*  are counted (lost) instead of overwritten ones.         *
+*                                                          *
+*  The record is also the RTDX wire format: 32 bit words,  *
+*  little endian, sync word first, checksum last (the host *
+*  decoder in Host/meas_reader.h resynchronises on it).    *
+*                                                          *
+*  Only head is written by the producer and only tail by   *
+*  the consumer, both free running. Records are copied     *
+*  word by word through volatile pointers before head /    *
+*  tail move, which orders them on the single C6713 core   *
+*  and on x86 (stores are not reordered with stores).      *
+*                                                          *
+************************************************************/
+#ifndef MEAS_RING_H_
+#define MEAS_RING_H_
+
+#define MEAS_SYNC 0x5341454D			// "MEAS" in a little endian stream
+#define MEAS_TARGETS 4					// further echoes of the frequency engines
+#define MEAS_WORDS 16					// 64 bytes
+#define MEAS_RING 64					// records, power of 2 (6.4 s at 10 pings/s)
+#define MEAS_STREAM 0xFF				// engine of the records of process_stream (stream_corr.h)
+
+typedef struct {
+	unsigned int sync;					// MEAS_SYNC
+	unsigned int seq;					// ping number
+	unsigned int time_hi;				// microseconds since boot
+	unsigned int time_lo;
+	unsigned int cycles;				// CPU cycles of the processing (engine_ping)
+	unsigned short engine;				// ENGINE_... that ran, MEAS_STREAM
+	unsigned short waveform;
+	unsigned short target_count;		// echoes above the CFAR threshold (frequency engines)
+	unsigned short reserved;			// 0
+	unsigned int lost;					// records the ring had to drop so far (reader too slow)
+	float range;						// metres, strongest echo
+	float peak;							// its correlation (engine_result_t.peak)
+	float bearing_deg;					// stereo engine, 0 otherwise
+	float target_range[MEAS_TARGETS];	// metres, echoes 0..target_count-1 (strongest first)
+	unsigned int check;					// sum of the words before + MEAS_SYNC (meas_seal)
+} meas_t;
+
+typedef char meas_size_check[sizeof(meas_t) == 4*MEAS_WORDS ? 1 : -1];
+
+typedef struct {
+	volatile unsigned int head;			// records written (producer)
+	volatile unsigned int tail;			// records read (consumer)
+	unsigned int lost;					// records dropped because the ring was full (producer)
+	meas_t rec[MEAS_RING];
+} meas_ring_t;
+
+void meas_ring_init(meas_ring_t *ring);
+
+void meas_seal(meas_t *m);						// sync + check
+int  meas_valid(const meas_t *m);				// sync and check right
+
+/* producer: seals and copies m into the ring, 0 (and lost + 1) if the ring is full */
+int meas_put(meas_ring_t *ring, meas_t *m);
+
+/* consumer: oldest record in place (NULL if empty), released with meas_pop when it has been sent */
+const meas_t *meas_peek(const meas_ring_t *ring);
+void meas_pop(meas_ring_t *ring);
+int  meas_get(meas_ring_t *ring, meas_t *m);	// peek + copy + pop, 0 if empty
+
+unsigned int meas_fill(const meas_ring_t *ring);	// records waiting
+
+#endif /*MEAS_RING_H_*/
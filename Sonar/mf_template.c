@@ -0,0 +1,78 @@
+/***********************************************************
+*  mf_template.c                                           *
+*                                                          *
+*  Matched filter template (portable C)                    *
+*                                                          *
+************************************************************/
+#include "rfft.h"
+#include "mf_template.h"
+
+
+int mf_template_init(mf_template_t *tpl, const short *sweep, float *work)
+{
+	int i;
+	short M;
+	float scale;
+
+	M = FFT_N/2;											//length of FFT in complex samples
+	if(!fft_plan_init(&tpl->plan, M))						//coefficients (size checked by sonar_params.h)
+	{
+		return 0;
+	}
+	rfft_split_table(tpl->split, FFT_N);
+
+	/*----- Sweep spectrum -----*/
+	for(i=0;i<FFT_N;i++)									// real samples, read as M complex points
+	{
+		if(i < SWEEP_LEN)
+		{
+			work[i] = (float)sweep[i]/SWEEP_AMPLITUDE;
+		}
+		else
+		{
+			work[i] = 0;
+		}
+	}
+	fft_forward(&tpl->plan, work, work+FFT_N);
+	rfft_split(work, tpl->spectrum, tpl->split, tpl->plan.bin, FFT_N);	// frequencies 0..M, natural order
+
+	// conjugate => spectrum x response is a correlation (not a convolution),
+	// and fold in the scaling rfft_multiply / fft_inverse leave out and the
+	// 1/SWEEP_AMPLITUDE of the response (converted unscaled, see convert.h)
+	scale = 1.0f/(2.0f*FFT_N*SWEEP_AMPLITUDE);
+	for(i=0;i<=M;i++)
+	{
+		tpl->spectrum[2*i]   =  scale*tpl->spectrum[2*i];
+		tpl->spectrum[2*i+1] = -scale*tpl->spectrum[2*i+1];
+	}
+	return 1;
+}
+
+
+int mf_stereo_init(mf_stereo_t *st, const mf_template_t *tpl)
+{
+	int k, p;
+
+	if(!fft_plan_init(&st->plan, FFT_N))
+	{
+		return 0;
+	}
+
+	// H[k] = 2 x spectrum[k] for k <= N/2 (the real input path scales by 1/(2N), this one by 1/N),
+	// H[N-k] = conj(H[k]) because the sweep is real
+	for(k=0;k<FFT_N;k++)
+	{
+		p = 2*st->plan.bin[k];
+		if(k <= FFT_N/2)
+		{
+			st->spectrum[p]   = 2*tpl->spectrum[2*k];
+			st->spectrum[p+1] = 2*tpl->spectrum[2*k+1];
+		}
+		else
+		{
+			st->spectrum[p]   =  2*tpl->spectrum[2*(FFT_N-k)];
+			st->spectrum[p+1] = -2*tpl->spectrum[2*(FFT_N-k)+1];
+		}
+	}
+	return 1;
+}
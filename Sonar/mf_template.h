@@ -0,0 +1,36 @@
+/***********************************************************
+*  mf_template.h                                           *
+*                                                          *
+*  Matched filter template: everything about the sent      *
+*  sweep the frequency domain correlator needs, computed   *
+*  once after frequency_sweep_init instead of every ping   *
+*                                                          *
+************************************************************/
+#ifndef MF_TEMPLATE_H_
+#define MF_TEMPLATE_H_
+
+#include "sonar_params.h"
+#include "fft_plan.h"
+
+#define CORR_WORK_LEN (FFT_N + FFT_SCRATCH_LEN)	// floats of the per ping work buffer
+#define STEREO_WORK_LEN (2*FFT_N + FFT_SCRATCH(FFT_N))	// same for the stereo correlator (>= CORR_WORK_LEN)
+
+/* real input transform of FFT_N points = FFT_N/2 point complex FFT + split (see rfft.h) */
+typedef struct {
+	fft_plan_t plan;				// FFT_N/2 point complex FFT (twiddles, spectrum order)
+	float spectrum[FFT_N+2];		// conj(FFT(sweep/SWEEP_AMPLITUDE)) / (2 FFT_N SWEEP_AMPLITUDE), frequencies 0..FFT_N/2
+	float split[FFT_N/2+2];			// split factors of the real transform
+} mf_template_t;
+
+int  mf_template_init(mf_template_t *tpl, const short *sweep, float *work);	// work: CORR_WORK_LEN floats, 0: no FFT plan
+
+/* stereo: left + j right as one FFT_N point complex signal. The sweep spectrum is the cached one
+   above, completed to all FFT_N frequencies by conjugate symmetry and stored in spectrum order */
+typedef struct {
+	fft_plan_t plan;				// FFT_N point complex FFT
+	float spectrum[2*FFT_N];		// conj(FFT(sweep/SWEEP_AMPLITUDE)) / (FFT_N SWEEP_AMPLITUDE), frequency k at bin[k]
+} mf_stereo_t;
+
+int  mf_stereo_init(mf_stereo_t *st, const mf_template_t *tpl);		// 0: no FFT plan
+
+#endif /*MF_TEMPLATE_H_*/
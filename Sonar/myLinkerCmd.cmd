@@ -1,3 +1,4 @@
+/* Buffers (on-chip, hot set) and process_mem (SDRAM, cold set): see placement.h */
 SECTIONS {
 	.databuffer {} > Buffers
 	.processbuffer {} > process_mem
@@ -0,0 +1,107 @@
+/***********************************************************
+*  peak_interp.c                                           *
+*                                                          *
+*  Sub-sample refinement of a correlation peak             *
+*  (portable C, no CSL => also builds on the host)         *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include "sonar_params.h"
+#include "peak_interp.h"
+
+#define SINC_STEPS 8					// grid of the sinc search: 1/8 sample, then a parabola
+
+#if PEAK_SINC_HALF != 8 || SINC_STEPS != 8
+#error "sinc_kernel is tabulated for PEAK_SINC_HALF 8 and SINC_STEPS 8"
+#endif
+
+/* Hann windowed sinc at t = d/SINC_STEPS samples, d = 0..(PEAK_SINC_HALF+1) x SINC_STEPS:
+   sin(pi t)/(pi t) x 0.5 (1 + cos(pi t/(PEAK_SINC_HALF+1))), even in t. The search only
+   evaluates it on the 1/SINC_STEPS grid => no sin / cos per ping (nor at boot) */
+static const float sinc_kernel[(PEAK_SINC_HALF+1)*SINC_STEPS+1] = {
+	1.0f, 0.974031627f, 0.89860332f, 0.780858755f, 0.631783903f, 0.464951277f, 0.294992507f, 0.135992005f,
+	0.0f, -0.104156204f, -0.171627998f, -0.201793507f, -0.197991446f, -0.166801393f, -0.116986588f, -0.0582538173f,
+	0.0f, 0.0497931987f, 0.0853853375f, 0.103738435f, 0.104583107f, 0.0901151523f, 0.06439621f, 0.032567203f,
+	0.0f, -0.0284893457f, -0.049261786f, -0.0602399297f, -0.0610254668f, -0.0527602136f, -0.0377778448f, -0.0191195924f,
+	0.0f, 0.0166923106f, 0.0287877657f, 0.0350751504f, 0.0353677645f, 0.0304056648f, 0.0216275938f, 0.0108627975f,
+	0.0f, -0.00931190234f, -0.0158880316f, -0.0191300865f, -0.0190401357f, -0.0161369294f, -0.0113005694f, -0.0055800369f,
+	0.0f, 0.00460101431f, 0.00767832203f, 0.00902395602f, 0.00874647964f, 0.00720018335f, 0.00488326931f, 0.0023274729f,
+	0.0f, -0.00176645804f, -0.00280724769f, -0.00312240282f, -0.00284302933f, -0.0021788755f, -0.00136052631f, -0.000588722585f,
+	0.0f, 0.000346943212f, 0.000464811135f, 0.00041617133f, 0.000284461305f, 0.000145848986f, 4.89425074e-05f, 6.53171583e-06f,
+	0.0f
+};
+
+
+static float parabola(float ym1, float y0, float yp1)	// vertex of the parabola through (-1,ym1) (0,y0) (1,yp1)
+{
+	float d = ym1 - 2*y0 + yp1;
+
+	if(d >= 0)											// not a maximum
+	{
+		return 0;
+	}
+	d = 0.5f*(ym1 - yp1)/d;
+	if(d > 0.5f)
+	{
+		d = 0.5f;
+	}
+	if(d < -0.5f)
+	{
+		d = -0.5f;
+	}
+	return d;
+}
+
+
+static float sinc_value(const float *y, int j)			// interpolated value at x = j/SINC_STEPS (0 = argmax)
+{
+	int i, d;
+	float v = 0;
+
+	for(i=-PEAK_SINC_HALF;i<=PEAK_SINC_HALF;i++)
+	{
+		d = j - i*SINC_STEPS;								// (x - i) x SINC_STEPS
+		v += y[PEAK_SINC_HALF+i]*sinc_kernel[d < 0 ? -d : d];
+	}
+	return v;
+}
+
+
+float peak_interp(const float *y, short method)
+{
+	const float *c = y + PEAK_SINC_HALF;
+	float v[2*SINC_STEPS+1];
+	int i, best;
+
+	switch(method)
+	{
+	case PEAK_PARABOLIC:
+		return parabola(c[-1], c[0], c[1]);
+
+	case PEAK_GAUSSIAN:
+		if(c[-1] > 0 && c[0] > 0 && c[1] > 0)
+		{
+			return parabola(log(c[-1]), log(c[0]), log(c[1]));
+		}
+		return parabola(c[-1], c[0], c[1]);
+
+	case PEAK_SINC:
+		best = 0;										// compared with computed values only
+		for(i=0;i<=2*SINC_STEPS;i++)					// -1 .. +1 sample in 1/8 steps
+		{
+			v[i] = sinc_value(y, i - SINC_STEPS);
+			if(v[i] > v[best])
+			{
+				best = i;
+			}
+		}
+		if(best == 0 || best == 2*SINC_STEPS)			// maximum belongs to a neighbour sample
+		{
+			return parabola(c[-1], c[0], c[1]);
+		}
+		return ((float)(best - SINC_STEPS) + parabola(v[best-1], v[best], v[best+1]))/SINC_STEPS;
+
+	default:
+		return 0;
+	}
+}
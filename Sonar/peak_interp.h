@@ -0,0 +1,37 @@
+/***********************************************************
+*  peak_interp.h                                           *
+*                                                          *
+*  Sub-sample refinement of a correlation peak             *
+*                                                          *
+*  PEAK_PARABOLIC  parabola through the 3 samples around   *
+*                  the argmax                              *
+*  PEAK_GAUSSIAN   parabola through their logarithms       *
+*                  (exact for a gaussian peak, needs 3     *
+*                  positive samples, else parabolic)       *
+*  PEAK_SINC       maximum of the band limited (Hann       *
+*                  windowed sinc) interpolation of the     *
+*                  2 x PEAK_SINC_HALF + 1 samples around   *
+*                  the argmax                              *
+*                                                          *
+*  The correlation of the 1..10 kHz sweep oscillates at    *
+*  about 5.5 kHz (9 samples per period): the 3 point fits  *
+*  are cheap but biased, the sinc one is the reference.    *
+*                                                          *
+************************************************************/
+#ifndef PEAK_INTERP_H_
+#define PEAK_INTERP_H_
+
+#define PEAK_NONE 0
+#define PEAK_PARABOLIC 1
+#define PEAK_GAUSSIAN 2
+#define PEAK_SINC 3
+
+#define PEAK_SINC_HALF 8				// samples used on each side of the argmax
+
+/* y : samples around the argmax, y[PEAK_SINC_HALF] = maximum (2 x PEAK_SINC_HALF + 1 values,
+       PEAK_PARABOLIC and PEAK_GAUSSIAN only read the middle 3)
+   returns the offset of the true maximum from the argmax in samples
+   (|offset| <= 0.5 for the 3 point fits, <= 1 for the sinc search) */
+float peak_interp(const float *y, short method);
+
+#endif /*PEAK_INTERP_H_*/
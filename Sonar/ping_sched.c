@@ -0,0 +1,91 @@
+/***********************************************************
+*  ping_sched.c                                            *
+*                                                          *
+*  Pipelined ping scheduler (portable C)                   *
+*                                                          *
+************************************************************/
+#include "ping_sched.h"
+
+
+void ping_sched_init(ping_sched_t *s, short nbuf)
+{
+	short i;
+
+	s->nbuf = nbuf < 1 ? 1 : nbuf > PING_BUFFERS ? PING_BUFFERS : nbuf;
+	s->capturing = PING_NONE;
+	s->ready = PING_NONE;
+	s->processing = PING_NONE;
+	for(i=0;i<PING_BUFFERS;i++)
+	{
+		s->seq[i] = 0;
+	}
+	s->launched = 0;
+	s->captured = 0;
+	s->processed = 0;
+	s->overruns = 0;
+	s->dropped = 0;
+}
+
+
+short ping_sched_launch(ping_sched_t *s)
+{
+	short b;
+
+	if(s->capturing != PING_NONE)
+	{
+		s->overruns++;
+		return PING_NONE;
+	}
+	for(b=0;b<s->nbuf;b++)
+	{
+		if(b != s->ready && b != s->processing)
+		{
+			s->capturing = b;
+			s->seq[b] = s->launched++;
+			return b;
+		}
+	}
+	s->dropped++;
+	return PING_NONE;
+}
+
+
+short ping_sched_captured(ping_sched_t *s)
+{
+	if(s->capturing == PING_NONE)
+	{
+		return 0;
+	}
+	if(s->ready != PING_NONE)			// the SWI did not even start on the previous one
+	{
+		s->dropped++;					// => replaced by the newer ping
+	}
+	s->ready = s->capturing;
+	s->capturing = PING_NONE;
+	s->captured++;
+	return 1;
+}
+
+
+short ping_sched_begin(ping_sched_t *s)
+{
+	short b = s->ready;
+
+	if(b != PING_NONE && s->processing == PING_NONE)
+	{
+		s->processing = b;
+		s->ready = PING_NONE;
+		return b;
+	}
+	return PING_NONE;
+}
+
+
+void ping_sched_end(ping_sched_t *s)
+{
+	if(s->processing != PING_NONE)
+	{
+		s->processing = PING_NONE;
+		s->processed++;
+	}
+}
@@ -0,0 +1,47 @@
+/***********************************************************
+*  ping_sched.h                                            *
+*                                                          *
+*  Pipelined ping scheduler: a timer launches the pings    *
+*  at a fixed rate, the capture of ping N+1 runs while     *
+*  ping N is processed (double buffered).                  *
+*                                                          *
+*  Buffer states: capturing (EDMA) => ready => processing  *
+*  (SWI) => free. Portable C, no BIOS / CSL: sonar.c calls *
+*  it with interrupts disabled, the host drives it from a  *
+*  simulated timer and EDMA (sonar_bench sched).           *
+*                                                          *
+*  overruns : ticks while the last capture still runs      *
+*             (interval shorter than the capture)          *
+*  dropped  : ticks without a free buffer (processing      *
+*             slower than the ping rate), or a captured    *
+*             ping replaced before the SWI took it         *
+*  no ping is launched on a skipped tick, the sent sweeps  *
+*  stay on the timer grid.                                 *
+*                                                          *
+************************************************************/
+#ifndef PING_SCHED_H_
+#define PING_SCHED_H_
+
+#define PING_BUFFERS 2				// capture buffers (1 = serial, capture and compute never overlap)
+#define PING_NONE -1
+
+typedef struct {
+	short nbuf;						// <= PING_BUFFERS
+	short capturing;				// buffer the EDMA fills, PING_NONE if idle
+	short ready;					// captured, not yet taken by the SWI
+	short processing;				// buffer the SWI works on
+	unsigned long seq[PING_BUFFERS];	// number of the ping held by each buffer
+	unsigned long launched;			// pings sent
+	unsigned long captured;
+	unsigned long processed;
+	unsigned long overruns;
+	unsigned long dropped;
+} ping_sched_t;
+
+void  ping_sched_init(ping_sched_t *s, short nbuf);
+short ping_sched_launch(ping_sched_t *s);		// timer: buffer for the next ping, PING_NONE if skipped
+short ping_sched_captured(ping_sched_t *s);		// EDMA done: 1 if the processing has to be posted
+short ping_sched_begin(ping_sched_t *s);		// SWI: buffer to process next, PING_NONE if none waits
+void  ping_sched_end(ping_sched_t *s);			// SWI: processing buffer is free again
+
+#endif /*PING_SCHED_H_*/
@@ -0,0 +1,45 @@
+/***********************************************************
+*  placement.h                                             *
+*                                                          *
+*  Memory placement of the per ping data (sonar.tcf,       *
+*  myLinkerCmd.cmd):                                       *
+*                                                          *
+*  0x00000000  IRAM     96 KB  code, BIOS, stack, .bss     *
+*  0x00018000  Buffers 128 KB  .databuffer  hot set        *
+*  0x00038000  L2 cache 32 KB  (2-way, caches SDRAM)       *
+*  0x80000000  SDRAM     2 MB  BIOS segments               *
+*  0x80200000  process_mem 6 MB  .processbuffer  cold set  *
+*                                                          *
+*  Hot: everything the correlator reads again and again    *
+*  within one ping => FFT work array, twiddle factors,     *
+*  16 bit sweep pairs and the coarse stage. Cold: capture  *
+*  and sweep buffers (EDMA, read in one pass), templates   *
+*  and the stereo work, served through the L2 cache.       *
+*                                                          *
+************************************************************/
+#ifndef PLACEMENT_H_
+#define PLACEMENT_H_
+
+#include "mf_template.h"
+#include "xcorr_i16.h"
+#include "coarse.h"
+
+#define ONCHIP_BYTES 0x20000				// length of "Buffers" in sonar.tcf
+#define ONCHIP_SLACK 64						// DATA_ALIGN padding between the hot buffers
+#define L2_LINE 128							// bytes, unit of CACHE_wbL2 / CACHE_wbInvL2
+
+/* shorts of an EDMA buffer padded to whole L2 lines, so that no CPU data shares a line with it */
+#define L2_ROUND_SHORTS(n) ((((n)*2 + L2_LINE-1)/L2_LINE)*L2_LINE/2)
+
+/* bytes of the hot set (.databuffer) */
+#define HOT_WORK_BYTES (sizeof(float)*CORR_WORK_LEN)
+#define HOT_TWIDDLE_BYTES (sizeof(float)*FFT_TWIDDLE(FFT_N/2))
+#define HOT_PAIRS_BYTES sizeof(xcorr_i16_t)
+#define HOT_COARSE_BYTES sizeof(coarse_t)
+#define HOT_BYTES (HOT_WORK_BYTES + HOT_TWIDDLE_BYTES + HOT_PAIRS_BYTES + HOT_COARSE_BYTES + ONCHIP_SLACK)
+
+/* fails the build when the hot set no longer fits (bigger FFT_N, SWEEP_LEN ...),
+   the linker reports the same for .databuffer, but only after everything compiled */
+typedef char onchip_budget_check[HOT_BYTES <= ONCHIP_BYTES ? 1 : -1];
+
+#endif /*PLACEMENT_H_*/
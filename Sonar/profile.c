@@ -0,0 +1,105 @@
+/***********************************************************
+*  profile.c                                               *
+*                                                          *
+*  Cycle counts of the processing stages                   *
+*                                                          *
+************************************************************/
+#include "profile.h"
+
+#ifdef PROFILE
+
+#ifdef _TMS320C6X
+#include <std.h>
+#include <clk.h>
+#include <sts.h>
+#include "sonarcfg.h"
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+prof_stat_t prof_stat[PROF_STAGES];
+static short prof_ready = 0;			// prof_reset done (min of every stage set)
+
+const char *const prof_name[PROF_STAGES] = {
+	"format+fft", "multiply", "sum", "ifft", "xcorr", "detect", "refine", "convert", "ping", "template"
+};
+
+#ifdef _TMS320C6X
+/* same order as the stages, unit: CPU cycles */
+static STS_Obj *const prof_sts[PROF_STAGES] = {
+	&STS_fft, &STS_multiply, &STS_sum, &STS_ifft, &STS_xcorr,
+	&STS_detect, &STS_refine, &STS_convert, &STS_ping, &STS_template
+};
+static float prof_cycles;				// CPU cycles per timer tick, read by prof_reset
+#endif
+
+
+void prof_reset(void)
+{
+	short s, b;
+
+	for(s=0;s<PROF_STAGES;s++)
+	{
+		prof_stat[s].count = 0;
+		prof_stat[s].min = (prof_time_t)-1;
+		prof_stat[s].max = 0;
+		prof_stat[s].sum = 0;
+		for(b=0;b<PROF_BINS;b++)
+		{
+			prof_stat[s].hist[b] = 0;
+		}
+#ifdef _TMS320C6X
+		STS_reset(prof_sts[s]);
+#endif
+	}
+#ifdef _TMS320C6X
+	prof_cycles = CLK_cpuCyclesPerHtime();
+#endif
+	prof_ready = 1;
+}
+
+
+prof_time_t prof_now(void)
+{
+#ifdef _TMS320C6X
+	return CLK_gethtime();
+#elif defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec*1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+
+prof_time_t prof_mark(short stage, prof_time_t since)
+{
+	prof_stat_t *st = &prof_stat[stage];
+	prof_time_t now, c;
+	short b;
+
+	now = prof_now();
+	c = now - since;						// wraps correctly in unsigned arithmetic
+	if(!prof_ready)
+	{
+		prof_reset();						// first probe after boot
+	}
+#ifdef _TMS320C6X
+	c = (prof_time_t)(c*prof_cycles);
+	STS_add(prof_sts[stage], c);
+#endif
+	st->count++;
+	st->sum += c;
+	st->min = c < st->min ? c : st->min;
+	st->max = c > st->max ? c : st->max;
+	for(b=0;b<PROF_BINS-1 && (c >> (b + PROF_BIN0 + 1)) != 0;b++)
+	{
+	}
+	st->hist[b]++;
+	return prof_now();						// the bookkeeping is not part of the next stage
+}
+
+#endif /* PROFILE */
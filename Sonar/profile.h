@@ -0,0 +1,75 @@
+/***********************************************************
+*  profile.h                                               *
+*                                                          *
+*  Cycle counts of the processing stages: every probe      *
+*  adds the cycles since the last one to its stage,        *
+*  min / avg / max and a log2 histogram are kept in        *
+*  prof_stat (CCS watch window, host report).              *
+*                                                          *
+*  Clock: target  CLK_gethtime x CLK_cpuCyclesPerHtime,    *
+*                 each stage also goes to its STS object   *
+*                 (sonar.tcf) => RTA statistics view       *
+*         host    time stamp counter (ns without one)      *
+*                                                          *
+*  Without PROFILE every probe is an empty macro: no       *
+*  code, no data, nothing to link (Release).               *
+*                                                          *
+************************************************************/
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+//#define PROFILE	// uncomment (or --define=PROFILE in the Debug build options, make PROFILE=1 on the host)
+
+/* stages, in the order of a ping. The twiddles (tw_genr2fft), bit reversal tables and the sweep
+   spectrum are part of the template since mf_template.h => PROF_TEMPLATE, at boot only */
+#define PROF_FFT 0			// int16 => float (fused first pass) + forward FFT
+#define PROF_MULTIPLY 1		// split, product with the template, merge (rfft_multiply / rfft_analytic / stereo)
+#define PROF_SUM 2			// ENGINE_INTEGRATE: product spectrum into the coherent sum
+#define PROF_IFFT 3			// inverse FFT
+#define PROF_XCORR 4		// time domain / coarse to fine correlation, search included
+#define PROF_DETECT 5		// peak scan / CFAR inside the gate
+#define PROF_REFINE 6		// sub-sample refinement
+#define PROF_CONVERT 7		// lag => metres
+#define PROF_PING 8			// the whole engine_ping
+#define PROF_TEMPLATE 9		// one mf_template_init (boot, waveform bank)
+#define PROF_STAGES 10
+
+#define PROF_BIN0 8			// histogram bin 0: < 2^(PROF_BIN0+1) cycles
+#define PROF_BINS 18		// last bin: >= 2^(PROF_BIN0+PROF_BINS-1) cycles (~ 150 ms at 225 MHz)
+
+#ifdef PROFILE
+
+#ifdef _TMS320C6X
+typedef unsigned int prof_time_t;			// 32 bit high resolution timer
+#else
+typedef unsigned long long prof_time_t;
+#endif
+
+typedef struct {
+	unsigned long count;
+	prof_time_t min;						// cycles
+	prof_time_t max;
+	double sum;								// avg = sum / count
+	unsigned long hist[PROF_BINS];			// [b]: cycles in [2^(b+PROF_BIN0), 2^(b+PROF_BIN0+1)), b = 0 below as well
+} prof_stat_t;
+
+extern prof_stat_t prof_stat[PROF_STAGES];
+extern const char *const prof_name[PROF_STAGES];
+
+void prof_reset(void);
+prof_time_t prof_now(void);						// clock ticks
+prof_time_t prof_mark(short stage, prof_time_t since);	// now - since => stage, returns now
+
+#define PROF_DECL(t) prof_time_t t;			// after the last declaration, no semicolon
+#define PROF_START(t) ((t) = prof_now())
+#define PROF_MARK(t, stage) ((t) = prof_mark(stage, t))
+
+#else
+
+#define PROF_DECL(t)
+#define PROF_START(t) ((void)0)
+#define PROF_MARK(t, stage) ((void)0)
+
+#endif /* PROFILE */
+
+#endif /*PROFILE_H_*/
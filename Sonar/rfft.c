@@ -0,0 +1,167 @@
+/***********************************************************
+*  rfft.c                                                  *
+*                                                          *
+*  Real input FFT split / merge (portable C)               *
+*                                                          *
+*  With M = n/2, Z = FFT_M(z) and W = exp(-j 2 pi / n):    *
+*    X[k]   = A + W^k (-jB)         A = Z[k] + conj(Z[M-k])*
+*    X[M-k] = conj(A - W^k (-jB))   B = Z[k] - conj(Z[M-k])*
+*  (both 2x too large). The merge is the same butterfly    *
+*  backwards:                                              *
+*    Z'[k]   = D + j conj(W^k) E    D = Y[k] + conj(Y[M-k])*
+*    Z'[M-k] = conj(D) + j W^k conj(E)   E = Y[k] - conj(..)*
+*                                                          *
+*  Analytic output (rfft_analytic): the product Y of the   *
+*  frequencies 1..M-1 is doubled, Y[0] and Y[M] are folded *
+*  onto bin 0, the negative frequencies dropped. The M     *
+*  point inverse of this one sided spectrum is the         *
+*  analytic signal of the correlation at the even lags     *
+*  (exp(j 2 pi k 2m / n) = exp(j 2 pi k m / M)).           *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include "rfft.h"
+
+
+void rfft_split_table(float *split, int n)
+{
+	int i;
+	double e = 2*3.14159265358979323846/n;
+
+	for(i=0; i <= (n>>2); i++)
+	{
+		split[2*i]   = cos(i*e);
+		split[2*i+1] = -sin(i*e);
+	}
+}
+
+
+void rfft_split(const float *z, float *X, const float *split, const unsigned short *bin, int n)
+{
+	int k, m, p, q;
+	float ar, ai, br, bi, tr, ti, wr, wi;
+
+	m = n >> 1;
+	for(k=0; k <= (m>>1); k++)
+	{
+		p = 2*bin[k];
+		q = 2*bin[k ? m-k : 0];
+		wr = split[2*k];
+		wi = split[2*k+1];
+
+		ar = z[p] + z[q];			// A = Z[k] + conj(Z[M-k])
+		ai = z[p+1] - z[q+1];
+		br = z[p] - z[q];			// B = Z[k] - conj(Z[M-k])
+		bi = z[p+1] + z[q+1];
+		tr = wr*bi + wi*br;			// T = W^k (-jB)
+		ti = wi*bi - wr*br;
+
+		X[2*k]   = 0.5f*(ar + tr);
+		X[2*k+1] = 0.5f*(ai + ti);
+		X[2*(m-k)]   =  0.5f*(ar - tr);
+		X[2*(m-k)+1] = -0.5f*(ai - ti);
+	}
+}
+
+
+void rfft_multiply(float *z, const float *coef, const float *split, const unsigned short *bin, int n)
+{
+	int k, m, p, q;
+	float ar, ai, br, bi, tr, ti, wr, wi;
+	float xr, xi, yr, yi, ur, ui, vr, vi, dr, di, er, ei, sr, si;
+
+	m = n >> 1;
+	for(k=0; k <= (m>>1); k++)
+	{
+		p = 2*bin[k];
+		q = 2*bin[k ? m-k : 0];			// k = 0 => q = p = Z[0] (Z[M] = Z[0])
+		wr = split[2*k];
+		wi = split[2*k+1];
+
+		/*----- split -----*/
+		ar = z[p] + z[q];
+		ai = z[p+1] - z[q+1];
+		br = z[p] - z[q];
+		bi = z[p+1] + z[q+1];
+		tr = wr*bi + wi*br;
+		ti = wi*bi - wr*br;
+		xr = ar + tr;					// 2 X[k]
+		xi = ai + ti;
+		yr = ar - tr;					// 2 X[M-k]
+		yi = ti - ai;
+
+		/*---- multiply ----*/
+		ur = coef[2*k]*xr - coef[2*k+1]*xi;			// Y[k]
+		ui = coef[2*k+1]*xr + coef[2*k]*xi;
+		vr = coef[2*(m-k)]*yr - coef[2*(m-k)+1]*yi;	// Y[M-k]
+		vi = coef[2*(m-k)+1]*yr + coef[2*(m-k)]*yi;
+
+		/*----- merge -----*/
+		dr = ur + vr;					// D = Y[k] + conj(Y[M-k])
+		di = ui - vi;
+		er = ur - vr;					// E = Y[k] - conj(Y[M-k])
+		ei = ui + vi;
+		sr = wr*er + wi*ei;				// S = conj(W^k) E
+		si = wr*ei - wi*er;
+
+		z[p]   = dr - si;				// Z'[k] = D + jS
+		z[p+1] = di + sr;
+		if(q != p)
+		{
+			z[q]   = dr + si;			// Z'[M-k] = conj(D) + j conj(S)
+			z[q+1] = sr - di;
+		}
+	}
+}
+
+
+void rfft_analytic(float *z, const float *coef, const float *split, const unsigned short *bin, int n)
+{
+	int k, m, p, q;
+	float ar, ai, br, bi, tr, ti, wr, wi;
+	float xr, xi, yr, yi, ur, ui, vr, vi;
+
+	m = n >> 1;
+	for(k=0; k <= (m>>1); k++)
+	{
+		p = 2*bin[k];
+		q = 2*bin[k ? m-k : 0];
+		wr = split[2*k];
+		wi = split[2*k+1];
+
+		/*----- split -----*/
+		ar = z[p] + z[q];
+		ai = z[p+1] - z[q+1];
+		br = z[p] - z[q];
+		bi = z[p+1] + z[q+1];
+		tr = wr*bi + wi*br;
+		ti = wi*bi - wr*br;
+		xr = ar + tr;					// 2 X[k]
+		xi = ai + ti;
+		yr = ar - tr;					// 2 X[M-k]  (k = 0: 2 X[M], Nyquist)
+		yi = ti - ai;
+
+		/*---- multiply ----*/
+		ur = coef[2*k]*xr - coef[2*k+1]*xi;			// Y[k]
+		ui = coef[2*k+1]*xr + coef[2*k]*xi;
+		vr = coef[2*(m-k)]*yr - coef[2*(m-k)+1]*yi;	// Y[M-k]
+		vi = coef[2*(m-k)+1]*yr + coef[2*(m-k)]*yi;
+
+		/*--- one sided ---*/
+		if(k == 0)
+		{
+			z[p]   = ur + vr;			// DC and Nyquist count once, both on bin 0
+			z[p+1] = ui + vi;
+		}
+		else
+		{
+			z[p]   = 2*ur;				// positive frequencies twice
+			z[p+1] = 2*ui;
+			if(q != p)
+			{
+				z[q]   = 2*vr;
+				z[q+1] = 2*vi;
+			}
+		}
+	}
+}
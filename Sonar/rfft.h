@@ -0,0 +1,33 @@
+/***********************************************************
+*  rfft.h                                                  *
+*                                                          *
+*  Real input FFT on top of the radix 2 routines:          *
+*  n real samples x[] are transformed as the n/2 point     *
+*  complex signal z[m] = x[2m] + j x[2m+1] and separated   *
+*  with a post twiddle (split), the inverse merges the     *
+*  spectrum back so fft_inverse delivers n real samples.   *
+*                                                          *
+************************************************************/
+#ifndef RFFT_H_
+#define RFFT_H_
+
+/* split factors for n real points: n/4+1 complex values exp(-j 2 pi k / n)  (n/2+2 floats) */
+void rfft_split_table(float *split, int n);
+
+/* bin: position of frequency k in the n/2 point spectrum (see fft_plan.h) */
+
+/* spectrum of n real samples: z = fft_forward output (n/2 points),
+   X = frequencies 0..n/2 in natural order (n/2+1 complex) */
+void rfft_split(const float *z, float *X, const float *split, const unsigned short *bin, int n);
+
+/* in place: split the response spectrum, multiply it with coef (frequencies 0..n/2, natural order)
+   and merge the product back, so that fft_inverse (n/2 points) returns the n real samples of
+   IFFT(coef x X) * 4/n  (the template folds in 1/(2n) to get the unscaled correlation) */
+void rfft_multiply(float *z, const float *coef, const float *split, const unsigned short *bin, int n);
+
+/* same split and multiply, but only the positive frequencies are kept (one sided spectrum), so that
+   fft_inverse (n/2 points) returns the analytic signal of the same correlation at the even lags:
+   n/2 complex values, real part = correlation, magnitude = envelope */
+void rfft_analytic(float *z, const float *coef, const float *split, const unsigned short *bin, int n);
+
+#endif /*RFFT_H_*/
@@ -13,51 +13,193 @@
 #include <csl_mcbsp.h>
 #include <csl_irq.h>
 #include <csl_edma.h>
+#include <csl_cache.h>
 #include <dsk6713_led.h>
+#include <rtdx.h>
 #include "config_AIC23.h"
 #include "sonar.h"
 #include "sonarcfg.h"
+#include "sonar_params.h"
+#include "sweep.h"
+#include "mf_template.h"
+#include "capture.h"
+#include "correlation.h"
+#include "stream_corr.h"
+#include "placement.h"
+#include "ping_sched.h"
+#include "integrate.h"
+#include "engine.h"
+#include "capture_rec.h"
+#include "profile.h"
+#include "meas_ring.h"
+#include "tracker.h"
 
 
 /*****************************************************************/
 
-//#define SWITCH     //uncomment for frequency domain calculation
+//#define SWITCH     //uncomment for frequency domain calculation at start up (see engine)
+//#define STREAMING  //uncomment for continuous capture (ping pong buffers, overlap-save correlation)
+//#define PIPELINED  //uncomment for timer driven pings (PRD_ping): ping N+1 is captured while ping N is processed
+//#define RECORD     //uncomment to keep the raw captures for replay on the host (see recording, capture_rec.h)
+
+//range gate, CFAR, refinement and ENGINE_AUTO / ENGINE_COARSE settings at start up: ENGINE_DEFAULT_... (engine.h),
+//shared with the host tools that reprocess the recordings
+#define WAVEFORM_ROTATION 1		//pings cycle through this many sweeps of the bank (1 = waveform 0 only, <= WAVEFORMS),
+								//the echoes of the previous ping then fall on another template (see rotation)
+#define REC_PINGS 64			//RECORD: pings kept in SDRAM (CAPTURE_REC_BYTES = 17 KB each)
+#define TRACKING 1				//range gate of each ping predicted from the last echoes at start up (see tracking, tracker.h)
+#define TRACK_ALPHA 0.5			//range gain of the alpha-beta filter
+#define TRACK_BETA 0.167		//rate gain (alpha^2/(2 - alpha): critically damped)
+#define TRACK_SIGMAS 4.0		//gate half width in standard deviations of the prediction error
+#define TRACK_MIN_HALF_M 0.05	//gate half width at least (14 lags)
+#define TRACK_MAX_SPEED 2.0		//m/s: gate growth while the rate is unknown or the echo missing
+#define TRACK_MIN_PEAK 0.3		//echo weaker than this fraction of the track mean = missing
+#define TRACK_MAX_MISSES 3		//pings without echo before the full gate is searched again
 
 /*****************************************************************/
 
+#if defined(PIPELINED) && defined(STREAMING)
+#error "PIPELINED and STREAMING are two different capture modes"
+#endif
+#if defined(RECORD) && defined(STREAMING)
+#error "RECORD keeps whole pings, STREAMING has no ping buffer"
+#endif
 
-#define SWEEP_LEN 2880		// 60 ms
-#define RESPONSE_MONO 4320   // 60 + 30 ms
-#define RESPONSE_LEN 8640
-#define FFT_LEN 32768        // next power of 2 for the dit/dif algorithm (complex array => length = 2 x length)
-
-#define PI 3.14159265358979323846
 
 /*########## DATA BUFFERS ##########*/
-/* no ping pong buffers needed (calculation made offline)  => only 1 buffer for input and 1 for output */
+/* serial: no ping pong buffers needed (calculation made offline)  => only 1 buffer for input and 1 for output
+   PIPELINED: one capture buffer per stage of the scheduler (ping_sched.h)
+   all in SDRAM (cold, read once per ping through the L2 cache), whole L2 lines (placement.h) */
+
+#ifdef PIPELINED
+#define CAPTURE_BUFFERS PING_BUFFERS
+#else
+#define CAPTURE_BUFFERS 1
+#endif
 
 #pragma DATA_SECTION(Buffer_in, ".processbuffer");
-short Buffer_in[RESPONSE_LEN];
-#pragma DATA_SECTION(Buffer_mono, ".processbuffer");
-short Buffer_mono[RESPONSE_MONO];
+#pragma DATA_ALIGN(Buffer_in, L2_LINE);					//paired 32 bit loads in the time domain correlator
+short Buffer_in[CAPTURE_BUFFERS][L2_ROUND_SHORTS(CAPTURE_LEN)];	//left + zero tail, right: sorted by the receive EDMA (capture.h)
 #pragma DATA_SECTION(Buffer_out, ".processbuffer");
-short Buffer_out[SWEEP_LEN];
-/* Memory "Buffers" set to adequate length ( 0x1C200 )*/
+#pragma DATA_ALIGN(Buffer_out, L2_LINE);
+short Buffer_out[WAVEFORMS][L2_ROUND_SHORTS(SWEEP_LEN)];	//the waveform bank (sweep.h), one sent per ping
 
 /*######## PROCESS BUFFERS #########*/
-// all initalized with zeros so the filling is easier
+/* hot set in on-chip RAM (.databuffer, HOT_BYTES checked against "Buffers" in placement.h),
+   the rest in SDRAM */
 
 //buffers for cross correlation in frequency domain
-#pragma DATA_SECTION(sweep_freq, ".processbuffer");			//freq sweep vector for fft
-float sweep_freq[FFT_LEN]={0};
-#pragma DATA_SECTION(fft_coeff, ".processbuffer");			//coefficient vector for fft function
-float fft_coeff[FFT_LEN/2]={0};
-#pragma DATA_SECTION(response_freq, ".processbuffer");		//response vector for fft
-float response_freq[FFT_LEN]={0};
-#pragma DATA_SECTION(cross_corr_freq, ".processbuffer");	//sweep_freq_fft x response_freq_fft
-float cross_corr_freq[FFT_LEN]={0};
-
-float result;
+#pragma DATA_SECTION(matched_filter, ".processbuffer");		//sweep spectrum + fft coefficients, built once at init per waveform
+mf_template_t matched_filter[WAVEFORMS];
+#pragma DATA_SECTION(stereo_filter, ".processbuffer");		//same spectrum for the FFT_N point complex transform (stereo)
+mf_stereo_t stereo_filter[WAVEFORMS];
+#pragma DATA_SECTION(response_freq, ".databuffer");			//real response for fft, multiplied and transformed back in place
+#pragma DATA_ALIGN(response_freq, 8);
+float response_freq[CORR_WORK_LEN];
+#pragma DATA_SECTION(twiddle_onchip, ".databuffer");		//twiddles of matched_filter.plan, moved here at init
+#pragma DATA_ALIGN(twiddle_onchip, 8);
+float twiddle_onchip[FFT_TWIDDLE(FFT_N/2)];
+#pragma DATA_SECTION(response_stereo, ".processbuffer");	//stereo engine: twice the transform, runs from SDRAM
+float response_stereo[STEREO_WORK_LEN];
+
+//buffers for cross correlation in time domain
+#pragma DATA_SECTION(sweep_pairs, ".databuffer");			//sweep as aligned 16 bit pairs (even and odd lags)
+#pragma DATA_ALIGN(sweep_pairs, 8);
+xcorr_i16_t sweep_pairs;
+#pragma DATA_SECTION(sweep_coarse, ".databuffer");			//decimated baseband sweep + envelope (coarse to fine)
+coarse_t sweep_coarse;
+
+/* integrating engine: sum of the product spectra, result every integrate_k pings (block) or every ping (sliding) */
+#pragma DATA_SECTION(integrator, ".processbuffer");
+integrate_t integrator;
+
+engine_t eng;		// the buffers above, handed to engine.c in main
+
+float result;		// last range (watch window), every measurement goes through meas below
+
+/*######## RUNTIME SETTINGS #########*/
+/* read every ping => can be changed while running (CCS watch window / RTDX) */
+
+#ifdef SWITCH
+volatile short engine = ENGINE_FREQUENCY;
+#else
+volatile short engine = ENGINE_TIME;
+#endif
+volatile short peak_method = ENGINE_DEFAULT_METHOD;		// sub-sample refinement of the peak (peak_interp.h)
+volatile float range_min = ENGINE_DEFAULT_RANGE_MIN_M;		// metres
+volatile float range_max = ENGINE_DEFAULT_RANGE_MAX_M;
+volatile short rotation = WAVEFORM_ROTATION;			// 1..WAVEFORMS
+volatile short integrate_k = ENGINE_DEFAULT_INTEGRATE_K;			// 1..INTEGRATE_MAX
+volatile short integrate_mode = ENGINE_DEFAULT_INTEGRATE_MODE;		// or INTEGRATE_SLIDING
+volatile short tracking = TRACKING;		// 0: every ping searches range_min..range_max
+
+/* last ping: engine used, range, every echo above the CFAR threshold (frequency engines),
+   range of each hydrophone and bearing (stereo engine), see engine_result_t */
+engine_cfg_t ping_cfg;
+engine_result_t ping_result;
+
+/*######## TRACKER #########*/
+/* tracking: the gate of each ping is the predicted range of the echo +/- its uncertainty (tracker.h).
+   track.stat: gate hit rate (hits / gated), lags searched vs. lags_full, cycles_saved (CCS watch window) */
+tracker_t track;
+
+/*######## PING SCHEDULER #########*/
+/* PIPELINED: PRD_ping launches a ping every PING_INTERVAL_MS into a free capture buffer,
+   sched.overruns / sched.dropped count the ticks that could not (CCS watch window) */
+#ifdef PIPELINED
+ping_sched_t sched;
+#endif
+short ping_waveform[CAPTURE_BUFFERS];		// waveform sent for the echo in each capture buffer
+unsigned long pings_sent = 0;
+unsigned long pings_done = 0;				// processed (serial / pipelined)
+
+/*######## MEASUREMENTS #########*/
+/* every result as a meas_t record: process_SWI => meas (no lock, see meas_ring.h) => tsk_meas_drain
+   => RTDX channel "meas_chan" (host: Host/meas_reader.h, meas_dump). meas.lost counts records
+   dropped because the host did not read for MEAS_RING pings */
+meas_ring_t meas;
+RTDX_CreateOutputChannel(meas_chan);
+
+/*######## PROFILING #########*/
+/* PROFILE (profile.h): cycles of every stage in prof_stat and the STS objects (RTA statistics view),
+   prof_clear = 1 restarts the statistics with the next ping */
+#ifdef PROFILE
+volatile short prof_clear = 0;
+#endif
+
+/*######## RECORDING #########*/
+/* RECORD: while recording = 1 every processed ping is appended to rec_store as a capture_rec_t
+   record until REC_PINGS are stored. The first rec_count*CAPTURE_REC_BYTES bytes of rec_store
+   are a recording as is (CCS: File > Data > Save, binary) => Host: sonar_bench replay file=... */
+#ifdef RECORD
+#pragma DATA_SECTION(rec_store, ".processbuffer");
+#pragma DATA_ALIGN(rec_store, L2_LINE);
+unsigned char rec_store[REC_PINGS][CAPTURE_REC_BYTES];
+volatile short recording = 0;
+unsigned int rec_count = 0;
+#endif
+
+/*######## STREAMING BUFFERS #########*/
+/* continuous capture: the receive EDMA alternates between ping and pong (linked parameter sets),
+   the SWI correlates the block that just landed while the other one is filled */
+#ifdef STREAMING
+#pragma DATA_SECTION(Buffer_ping, ".processbuffer");
+#pragma DATA_ALIGN(Buffer_ping, L2_LINE);
+short Buffer_ping[2*STREAM_BLOCK];			// [ left STREAM_BLOCK | right STREAM_BLOCK ] (capture.h)
+#pragma DATA_SECTION(Buffer_pong, ".processbuffer");
+#pragma DATA_ALIGN(Buffer_pong, L2_LINE);
+short Buffer_pong[2*STREAM_BLOCK];
+#pragma DATA_SECTION(stream, ".processbuffer");
+stream_corr_t stream;
+
+stream_echo_t stream_echo[STREAM_MAX_ECHO];
+short silence = 0;						// sent between two sweeps (source address not incremented)
+
+volatile unsigned int blocks_filled = 0;		// counted by the EDMA interrupt
+volatile unsigned int blocks_done = 0;		// counted by the SWI
+unsigned int stream_overruns = 0;			// blocks overwritten before they were processed
+long last_ping = -1;
+#endif /* STREAMING */
 /*######### CONFIGURATION FUNCTIONS #########*/
 
 //Configuration for McBSP1 (data-interface)
@@ -131,7 +273,7 @@ EDMA_Config configEDMARcv = {
     EDMA_FMKS(OPT, 2DS, NO)            |  // kein 2D-Transfer
     EDMA_FMKS(OPT, SUM, NONE)          |  // Quell-update mode -> FEST (McBSP)!!!
     EDMA_FMKS(OPT, 2DD, NO)            |  // 2kein 2D-Transfer
-    EDMA_FMKS(OPT, DUM, INC)           |  // Ziel-update mode
+    EDMA_FMKS(OPT, DUM, IDX)           |  // Ziel-update mode -> Index (links / rechts getrennt, capture.h)
     EDMA_FMKS(OPT, TCINT,YES)         |  // EDMA interrupt erzeugen?
     EDMA_FMKS(OPT, TCC, OF(0))         |  // Transfer complete code (TCC)
     EDMA_FMKS(OPT, LINK, NO)          |  // Link Parameter nutzen?
@@ -139,15 +281,15 @@ EDMA_Config configEDMARcv = {
 
     EDMA_FMKS(SRC, SRC, OF(0)),           // Quell-Adresse
 
-    EDMA_FMK (CNT, FRMCNT, 0)          |  // Anzahl Frames
-    EDMA_FMK (CNT, ELECNT, RESPONSE_LEN),   // Anzahl Elemente
+    EDMA_FMK (CNT, FRMCNT, RESPONSE_MONO-1)          |  // Anzahl Frames - 1 (ein Frame = ein Stereo-Sample)
+    EDMA_FMK (CNT, ELECNT, DEINTERLEAVE_ELECNT),   // Anzahl Elemente (links, rechts)
 
-    (Uint32)Buffer_in,       		  // Ziel-Adresse
+    (Uint32)Buffer_in[0],    		  // Ziel-Adresse
 
-    EDMA_FMKS(IDX, FRMIDX, DEFAULT)    |  // Frame index Wert
-    EDMA_FMKS(IDX, ELEIDX, DEFAULT),      // Element index Wert
+    EDMA_FMK (IDX, FRMIDX, (Uint16)DEINTERLEAVE_FRMIDX(CAPTURE_STRIDE))    |  // Frame index Wert (rechts => naechstes links)
+    EDMA_FMK (IDX, ELEIDX, (Uint16)DEINTERLEAVE_ELEIDX(CAPTURE_STRIDE)),      // Element index Wert (links => rechts)
 
-    EDMA_FMK (RLD, ELERLD, 0)       |  // Reload Element
+    EDMA_FMK (RLD, ELERLD, DEINTERLEAVE_ELECNT)       |  // Reload Element (1D, element sync, mehrere Frames)
     EDMA_FMK (RLD, LINK, 0)            // Reload Link
 };
 
@@ -163,7 +305,7 @@ EDMA_Config configEDMAXmt = {
     EDMA_FMKS(OPT, LINK, NO)          |  // Link Parameter nutzen?
     EDMA_FMKS(OPT, FS, NO),               // Frame Sync nutzen?
 
-    (Uint32)Buffer_out,           // Quell-Adresse
+    (Uint32)Buffer_out[0],        // Quell-Adresse
 
     EDMA_FMK (CNT, FRMCNT, 0)          | // Anzahl Frames
     EDMA_FMK (CNT, ELECNT, SWEEP_LEN),   // Anzahl Elemente
@@ -177,6 +319,35 @@ EDMA_Config configEDMAXmt = {
     EDMA_FMK (RLD, LINK, 0)            // Reload Link
 };
 
+#ifdef STREAMING
+/* pause between two sweeps, linked behind configEDMAXmt */
+EDMA_Config configEDMASilence = {
+    EDMA_FMKS(OPT, PRI, LOW)          |  // auf beide Queues verteilen
+    EDMA_FMKS(OPT, ESIZE, 16BIT)       |  // Element size
+    EDMA_FMKS(OPT, 2DS, NO)            |  // kein 2D-Transfer
+    EDMA_FMKS(OPT, SUM, NONE)          |  // Quell-update mode -> FEST (immer dasselbe Null-Wort)
+    EDMA_FMKS(OPT, 2DD, NO)            |  // kein 2D-Transfer
+    EDMA_FMKS(OPT, DUM, NONE)           |  // Ziel-update mode
+    EDMA_FMKS(OPT, TCINT,NO)          |  // EDMA interrupt erzeugen?
+    EDMA_FMKS(OPT, TCC, OF(0))         |  // Transfer complete code (TCC)
+    EDMA_FMKS(OPT, LINK, YES)         |  // Link Parameter nutzen?
+    EDMA_FMKS(OPT, FS, NO),               // Frame Sync nutzen?
+
+    (Uint32)&silence,           // Quell-Adresse
+
+    EDMA_FMK (CNT, FRMCNT, 0)          | // Anzahl Frames
+    EDMA_FMK (CNT, ELECNT, 2*PING_PERIOD-SWEEP_LEN),   // Anzahl Elemente (Rest der Ping-Periode, stereo)
+
+    EDMA_FMKS(DST, DST, OF(0)),       		  // Ziel-Adresse
+
+    EDMA_FMKS(IDX, FRMIDX, DEFAULT)    |  // Frame index Wert
+    EDMA_FMKS(IDX, ELEIDX, DEFAULT),      // Element index Wert
+
+    EDMA_FMK (RLD, ELERLD, 0)       |  // Reload Element
+    EDMA_FMK (RLD, LINK, 0)            // Reload Link
+};
+#endif /* STREAMING */
+
 /* Transfer-Complete-Codes for EDMA-Jobs */
 int tccRcv;
 int tccXmt;
@@ -184,7 +355,13 @@ int tccXmt;
 /* EDMA-Handles */
 EDMA_Handle hEdmaRcv;
 EDMA_Handle hEdmaXmt;
-// no ping pong => no reload handle needed
+// no ping pong => no reload handle needed (one shot mode)
+#ifdef STREAMING
+EDMA_Handle hEdmaRcvPing;		// reload tables for the linked transfers
+EDMA_Handle hEdmaRcvPong;
+EDMA_Handle hEdmaXmtSweep;
+EDMA_Handle hEdmaXmtSilence;
+#endif
 						
 MCBSP_Handle hMcbsp;
 
@@ -208,6 +385,23 @@ void Edma_enable(void)
 	EDMA_enableChannel(hEdmaXmt);
 }
 
+#ifndef STREAMING
+static void ping_launch(short buf)		// next waveform of the rotation, its echo into Buffer_in[buf]
+{
+	short w = 0;
+
+	if(rotation > 1 && rotation <= WAVEFORMS)
+	{
+		w = pings_sent % rotation;
+	}
+	ping_waveform[buf] = w;
+	pings_sent++;
+	configEDMARcv.dst = (Uint32)Buffer_in[buf];
+	configEDMAXmt.src = (Uint32)Buffer_out[w];
+	Edma_enable();
+}
+#endif /* STREAMING */
+
 void config_EDMA(void)
 {
 	/*############ RECIEVE #############*/
@@ -216,7 +410,7 @@ void config_EDMA(void)
 	hEdmaRcv = EDMA_open(EDMA_CHA_REVT1, EDMA_OPEN_RESET);  // EDMA Channel for REVT1
 
 	configEDMARcv.src = MCBSP_getRcvAddr(hMcbsp);          //  source addr
-	configEDMARcv.dst = (Uint32)Buffer_in;
+	configEDMARcv.dst = (Uint32)Buffer_in[0];
 
 	tccRcv = EDMA_intAlloc(-1);                        // next available TCC
 	configEDMARcv.opt |= EDMA_FMK(OPT,TCC,tccRcv);     // set it
@@ -228,319 +422,102 @@ void config_EDMA(void)
 
 	hEdmaXmt = EDMA_open(EDMA_CHA_XEVT1, EDMA_OPEN_RESET);  // EDMA Channel for XEVT1
 
-	configEDMAXmt.src = (Uint32)Buffer_out;
+	configEDMAXmt.src = (Uint32)Buffer_out[0];
 	configEDMAXmt.dst = MCBSP_getXmtAddr(hMcbsp);		 // destination addr
 
 	tccXmt = EDMA_intAlloc(-1);                        // next available TCC
 	configEDMAXmt.opt |= EDMA_FMK(OPT,TCC,tccXmt);     // set it
 
-	Edma_enable();
-}
-
-
-
-void config_interrupts(void)
-{
-	/*######### HWI ##########*/
-
-	/*--------- EDMA ----------*/
-	IRQ_map(IRQ_EVT_EDMAINT, 8);
-	IRQ_clear(IRQ_EVT_EDMAINT);
-	IRQ_enable(IRQ_EVT_EDMAINT);
-
-
-	IRQ_globalEnable();
+#ifdef PIPELINED
+	ping_sched_init(&sched, PING_BUFFERS);		// first ping on the first PRD_ping tick
+#else
+	ping_launch(0);
+#endif
 }
 
-/*######## INITIALISATION FUNCTION ########*/
 
-void frequency_sweep_init(void)			// Initialisation of then sent signal
+#ifdef STREAMING
+void config_EDMA_stream(void)		// endless transfers: ping -> pong -> ping ... / sweep -> silence -> sweep ...
 {
-	/*------- Frequency Sweep Algorithm -------*/
-	//For explanations see the file "freq_sweep.html"
-	short k;
-	float factor;
-	float omega;
-	float value[3];
-	float buf;
-	value[0]=1;
-	value[1]=2*cos(2*PI*1006.25/48000)*sin(2*PI*1006.25/48000);
-	for(k=0;k<SWEEP_LEN;k++)
-	{
-		if(k>1 && k< SWEEP_LEN/2)
-		{
-			omega = 2*PI*(1000+k*6.25)/48000;
-			factor = sin(omega)/sqrt(value[1]*value[1]+value[0]*value[0]-2*value[0]*value[1]*cos(omega));
-			value[2] = factor*(2*cos(omega)*value[1]-value[0]);
-			buf=25000*value[2];
-			Buffer_out[k]=(short)buf;
-			value[0] = value[1];
-			value[1] = value[2];
-		}
-		else if(k<2)
-		{
-			buf=25000*value[k];
-			Buffer_out[k]=(short)buf;
-		}
-		else if(k>= SWEEP_LEN/2)
-		{
-			Buffer_out[k] = Buffer_out[SWEEP_LEN-k-1];
-		}
-	}
-}
+	/*############ RECIEVE #############*/
+			  /* ADC => CPU */
 
-/*######### CALCULATION FUNCTIONS #########*/
+	hEdmaRcv = EDMA_open(EDMA_CHA_REVT1, EDMA_OPEN_RESET);
+	hEdmaRcvPing = EDMA_allocTable(-1);
+	hEdmaRcvPong = EDMA_allocTable(-1);
 
-float convert_step_distance(short step) // array index => distance
-{
-	float distance;
-	distance = (float)step*340/96000;   // distance = step x speed of sound / (2 x sampling freq)
-	return distance;
-}
+	configEDMARcv.src = MCBSP_getRcvAddr(hMcbsp);
+	configEDMARcv.cnt = EDMA_FMK(CNT, FRMCNT, STREAM_BLOCK-1) | EDMA_FMK(CNT, ELECNT, DEINTERLEAVE_ELECNT);
+	configEDMARcv.idx = EDMA_FMK(IDX, FRMIDX, (Uint16)DEINTERLEAVE_FRMIDX(STREAM_BLOCK))		// [ left | right ] per block
+	                  | EDMA_FMK(IDX, ELEIDX, (Uint16)DEINTERLEAVE_ELEIDX(STREAM_BLOCK));
+	configEDMARcv.opt |= EDMA_FMKS(OPT, LINK, YES);
 
+	tccRcv = EDMA_intAlloc(-1);
+	configEDMARcv.opt |= EDMA_FMK(OPT,TCC,tccRcv);		// same TCC for ping and pong
 
-void stereo_to_mono()
-{
-	int i;
-	for(i=0;i<RESPONSE_MONO;i++)
-	{
-		Buffer_mono[i] = Buffer_in[2*i];
-	}
-}
+	configEDMARcv.dst = (Uint32)Buffer_ping;
+	EDMA_config(hEdmaRcv, &configEDMARcv);
+	EDMA_config(hEdmaRcvPing, &configEDMARcv);
+	configEDMARcv.dst = (Uint32)Buffer_pong;
+	EDMA_config(hEdmaRcvPong, &configEDMARcv);
 
+	EDMA_link(hEdmaRcv, hEdmaRcvPong);
+	EDMA_link(hEdmaRcvPong, hEdmaRcvPing);
+	EDMA_link(hEdmaRcvPing, hEdmaRcvPong);
 
-short cross_correlation_time()  		// Cross correlation algorithm (time domain), double for-loop
-{
-	short k,m,r_new,r_max;
-	short max_index = 0;
 
-	stereo_to_mono();
-	r_max=0; 							// to compare
+	/*############ TRANSMIT #############*/
+			   /* CPU => DAC */
+	/* no interrupt: the sweep is repeated every PING_PERIOD samples,
+	   locked to the same sample clock as the capture */
 
-	for(k=0;k<SWEEP_LEN;k++)				// For explanations see "cross_correlation.html"
-	{
-		r_new=0;
+	hEdmaXmt = EDMA_open(EDMA_CHA_XEVT1, EDMA_OPEN_RESET);
+	hEdmaXmtSweep = EDMA_allocTable(-1);
+	hEdmaXmtSilence = EDMA_allocTable(-1);
 
-		/*--------- Cross correlation ----------*/
-		for(m=k;m<RESPONSE_MONO;m++)
-		{
-			r_new = r_new + Buffer_out[m-k]*Buffer_mono[m];  // Cross correlation formula
-		}
+	configEDMAXmt.src = (Uint32)Buffer_out[0];		// waveform 0 only (one template in stream_corr)
+	configEDMAXmt.dst = MCBSP_getXmtAddr(hMcbsp);
+	configEDMAXmt.opt &= ~EDMA_FMK(OPT, TCINT, 1);
+	configEDMAXmt.opt |= EDMA_FMKS(OPT, LINK, YES);
+	configEDMASilence.dst = MCBSP_getXmtAddr(hMcbsp);
 
-		/*-------- Keeping the maximum ---------*/
-		if (r_new > r_max)
-		{
-			r_max = r_new;
-			max_index=k;
-		}
-	}
+	EDMA_config(hEdmaXmt, &configEDMAXmt);
+	EDMA_config(hEdmaXmtSweep, &configEDMAXmt);
+	EDMA_config(hEdmaXmtSilence, &configEDMASilence);
 
-	return max_index;     // Returns the array index of the maximum value of the cross correlation
-}
+	EDMA_link(hEdmaXmt, hEdmaXmtSilence);
+	EDMA_link(hEdmaXmtSilence, hEdmaXmtSweep);
+	EDMA_link(hEdmaXmtSweep, hEdmaXmtSilence);
 
 
-void tw_genr2fft(float* w, int n)          //generates the coefficient table (twiddle factors) for the fft
-{
-   int i;
-   float pi = 4.0*atan(1.0);
-   float e = pi*2.0/n;
+	/* enable EDMA TCC */
+	EDMA_intClear(tccRcv);
+	EDMA_intEnable(tccRcv);
 
-    for(i=0; i < ( n>>1 ); i++)
-    {
-       w[2*i]   = cos(i*e);
-       w[2*i+1] = sin(i*e);
-    }
+	/* enable EDMA channels (never disabled again) */
+	EDMA_enableChannel(hEdmaRcv);
+	EDMA_enableChannel(hEdmaXmt);
 }
+#endif /* STREAMING */
 
 
-void bit_rev(float* x, int n)             //bit reverse a vector for the fft
+void config_interrupts(void)
 {
-  int i, j, k;
-  float rtemp, itemp;
-
-  j = 0;
-  for(i=1; i < (n-1); i++)
-  {
-     k = n >> 1;
-     while(k <= j)
-     {
-        j -= k;
-        k >>= 1;
-     }
-     j += k;
-     if(i < j)
-     {
-        rtemp    = x[j*2];
-        x[j*2]   = x[i*2];
-        x[i*2]   = rtemp;
-        itemp    = x[j*2+1];
-        x[j*2+1] = x[i*2+1];
-        x[i*2+1] = itemp;
-     }
-   }
-}
-
-
-void cfftr2_dit(float* x, float* w, short n)
-     {
-         short n2, ie, ia, i, j, k, m;
-         float rtemp, itemp, c, s;
-
-         n2 = n;
-         ie = 1;
-
-         for(k=n; k > 1; k >>= 1)
-         {
-            n2 >>= 1;
-            ia = 0;
-            for(j=0; j < ie; j++)
-            {
-               c = w[2*j];
-               s = w[2*j+1];
-               for(i=0; i < n2; i++)
-               {
-                  m = ia + n2;
-                  rtemp     = c * x[2*m]   + s * x[2*m+1];
-                  itemp     = c * x[2*m+1] - s * x[2*m];
-                  x[2*m]    = x[2*ia]   - rtemp;
-                  x[2*m+1]  = x[2*ia+1] - itemp;
-                  x[2*ia]   = x[2*ia]   + rtemp;
-                  x[2*ia+1] = x[2*ia+1] + itemp;
-                  ia++;
-               }
-               ia += n2;
-            }
-            ie <<= 1;
-         }
-      }
-
-
-void icfftr2_dif(float* x, float* w, short n)
-           {
-               short n2, ie, ia, i, j, k, m;
-               float rtemp, itemp, c, s;
-
-               n2 = 1;
-               ie = n;
-               for(k=n; k > 1; k >>= 1)
-               {
-                   ie >>= 1;
-                   ia = 0;
-                   for(j=0; j < ie; j++)
-                   {
-                       c = w[2*j];
-                       s = w[2*j+1];
-                       for(i=0; i < n2; i++)
-                       {
-                           m = ia + n2;
-                           rtemp     = x[2*ia]   - x[2*m];
-                           x[2*ia]   = x[2*ia]   + x[2*m];
-                           itemp     = x[2*ia+1] - x[2*m+1];
-                           x[2*ia+1] = x[2*ia+1] + x[2*m+1];
-                           x[2*m]    = c*rtemp   - s*itemp;
-                           x[2*m+1]  = c*itemp   + s*rtemp;
-                           ia++;
-                       }
-                       ia += n2;
-                   }
-                   n2 <<= 1;
-               }
-           }
-
-
-short cross_correlation_frequency()		// Uses the FFT dit + IFFT dif algorithm (Radix 2)	from the DSPlib
-{										// max = max[ IFFT( FFT(sweep) x FFT(response) ) ]
-										// FFT function needs complex array at input
-	short max_index,k;
-	int i, j;
-	float max_value;
-
-
-	/*--------- Formating ----------*/
-	/* Turn the freq sweep and response arrays into complex arrays ( array[re(a1),im(a1),re(a2),im(a2),...], im = 0 )
-	 and bring them to the right length (next power of 2 = 16384)*/
-
-	for(i=0 ; i < FFT_LEN/2 ; i++)						// sweep_freq and response_freq already right length
-	{														// and filled with zeros (see initialisation)
-		if(i < RESPONSE_MONO)
-		{
-			if(i < SWEEP_LEN)
-			{
-				sweep_freq[2*i] = (float)Buffer_out[i]/25000;			// fills every second value (real parts)
-				sweep_freq[2*i+1]=0;
-			}
-			else
-			{
-				sweep_freq[2*i] = 0;
-				sweep_freq[2*i+1]=0;
-			}
-			response_freq[2*i] = (float)Buffer_in[2*i]/25000;
-			response_freq[2*i+1]=0;
-		}
-		else
-		{
-			sweep_freq[2*i] = 0;
-			sweep_freq[2*i+1]=0;
-			response_freq[2*i] = 0;
-			response_freq[2*i+1]=0;
-		}
-	}
-
-
-	/*------------ FFT -------------*/
-	/* DSPF_sp_cfftr2_dit(float* x, float* w, short n)*/
-	short N;
-	N = FFT_LEN/2 ;           								//length of FFT in complex samples
-	tw_genr2fft(fft_coeff, N);	   							//generates coefficient table for fft
-	bit_rev(fft_coeff,N>>1);   								//bit reverse the vector (right format for fft dit)
-
-	cfftr2_dit(sweep_freq,fft_coeff,N);				//FFT of sweep signal
-	cfftr2_dit(response_freq,fft_coeff,N);			//FFT of response signal
-															//both signal are bit reversed (complex)
-
-
-	/*---------- Multiply ----------*/
-
-	for(j=0;j<FFT_LEN;j=j+2)									// floating point so no need to worry
-	{														// about numbers oustide of the type limits.
-		//cross_corr_freq[j]=sweep_freq[j]*response_freq[j];	// Result is cross correlation in frequency domain
-
-		cross_corr_freq[j] = sweep_freq[j]*response_freq[j] - sweep_freq[j+1]*response_freq[j+1];
-		cross_corr_freq[j+1] = sweep_freq[j+1]*response_freq[j]+sweep_freq[j]*response_freq[j+1];
-
-
-	}
-
-
-	/*------------ IFFT ------------*/
-	/*DSPF_sp_icfftr2_dif (float* x, float* w, short n)*/
-	icfftr2_dif(cross_corr_freq,fft_coeff,N);		//Input bit reversed, output normal (complex)
-
-
-	/*---- Finding the maximum ----*/
+	/*######### HWI ##########*/
 
-	max_value=0;
-	max_index=0;
-	for(k=0;k<RESPONSE_LEN;k++)
-	{
-		if (cross_corr_freq[2*k] > max_value)				//Take only the real values (im = 0)
-		{													// = every second value
-			max_value = cross_corr_freq[2*k];				//so k has the right format
-			max_index = k;
-		}
-	}
+	/*--------- EDMA ----------*/
+	IRQ_map(IRQ_EVT_EDMAINT, 8);
+	IRQ_clear(IRQ_EVT_EDMAINT);
+	IRQ_enable(IRQ_EVT_EDMAINT);
 
 
-	// return the index of the maximum value
-	return max_index;
+	IRQ_globalEnable();
 }
 
-
-
 /*############### MAIN ###############*/
 main()
 {
-
+	int i, j;
 
 	CSL_init();
 
@@ -552,10 +529,53 @@ main()
     MCBSP_config(hMcbsp, &datainterface_config);
 
     /* Initialize the frequency sweep signal */
-    frequency_sweep_init();
+    for(i=0;i<WAVEFORMS;i++)
+    {
+    	waveform_init(Buffer_out[i], i);
+    	eng.sweep[i] = Buffer_out[i];
+    }
+    eng.tpl = matched_filter;
+    eng.stereo = stereo_filter;
+    eng.pairs = &sweep_pairs;
+    eng.coarse = &sweep_coarse;
+    eng.integrator = &integrator;
+    eng.work = response_freq;
+    eng.work_stereo = response_stereo;
+    eng.twiddle = twiddle_onchip;
+    engine_defaults(&eng, &ping_cfg);	// ping_cfg: read again from the watch variables every ping
+#ifdef PROFILE
+    prof_reset();
+#endif
+    if(!engine_init(&eng))			// templates of every sweep, twiddles on chip, waveform 0 hot
+    {
+    	return;						// FFT_N not supported by the FFT engine: nothing started
+    }
+    meas_ring_init(&meas);
+    track.alpha = TRACK_ALPHA;
+    track.beta = TRACK_BETA;
+    track.sigmas = TRACK_SIGMAS;
+    track.min_half_m = TRACK_MIN_HALF_M;
+    track.max_speed = TRACK_MAX_SPEED;
+    track.min_peak = TRACK_MIN_PEAK;
+    track.max_misses = TRACK_MAX_MISSES;
+    tracker_reset(&track);
+    for(i=RESPONSE_MONO;i<CAPTURE_STRIDE;i++)			// the receive EDMA skips the tail of the left channel
+    {
+    	for(j=0;j<CAPTURE_BUFFERS;j++)
+    	{
+    		Buffer_in[j][i] = 0;
+    	}
+    }
+    CACHE_wbInvL2(Buffer_in, sizeof(Buffer_in), CACHE_WAIT);		// zero tail to SDRAM, EDMA sees the sweep
+    CACHE_wbL2(Buffer_out, sizeof(Buffer_out), CACHE_WAIT);
 
 	/* configure EDMA */
+#ifdef STREAMING
+    stream_corr_init(&stream, Buffer_out[0], PING_PERIOD);
+    config_EDMA_stream();
+#else
     config_EDMA();
+#endif
 
     /* finally the interrupts */
     config_interrupts();
@@ -571,6 +591,13 @@ main()
 
 void EDMA_interrupt_service(void)
 {
+#ifdef STREAMING
+	if(EDMA_intTest(tccRcv)) {
+		EDMA_intClear(tccRcv); /* clear is mandatory */
+		blocks_filled++;		// the EDMA already continues with the other buffer
+		SWI_post(&SWI_process);
+	}
+#else
 	static int rcvDone=0;
 	static int xmtDone=0;
 	
@@ -589,34 +616,224 @@ void EDMA_interrupt_service(void)
 		rcvDone=0;
 		xmtDone=0;
 		// processing in SWI
+#ifdef PIPELINED
+		if(ping_sched_captured(&sched))		// already in the HWI, no lock needed
+#endif
 		SWI_post(&SWI_process);
 	}
+#endif /* STREAMING */
 }
 
-void process_SWI(void)
+static void time_us(unsigned int *hi, unsigned int *lo)	// microseconds since boot (system ticks)
+{
+	double us;
+
+	us = (double)CLK_getltime()*CLK_getprd()*1000.0/CLK_countspms();
+	*hi = (unsigned int)(us/4294967296.0);
+	*lo = (unsigned int)(us - *hi*4294967296.0);
+}
+
+static void meas_publish(meas_t *m)		// from the SWI, the drain task sends it
+{
+	time_us(&m->time_hi, &m->time_lo);
+	meas_put(&meas, m);						// full ring: counted in meas.lost
+	SEM_postBinary(&SEM_meas);
+}
+
+#ifdef STREAMING
+void process_stream(void)		// correlates every block that landed since the last run
+{
+	short *block;
+	int i, count;
+	meas_t m = { 0 };
+
+	while(blocks_done != blocks_filled)
+	{
+		block = (blocks_done & 1) ? Buffer_pong : Buffer_ping;	// first block lands in ping
+
+		if(blocks_filled - blocks_done > 1)		// the EDMA is already writing into this buffer again
+		{
+			stream_corr_skip(&stream);
+			stream_overruns++;
+		}
+		else
+		{
+			CACHE_wbInvL2(block, 2*STREAM_BLOCK*sizeof(short), CACHE_WAIT);	// drop stale lines of the last round
+			count = stream_corr_push(&stream, block, 1, stream_echo);	// left channel first, unit stride
+			for(i=0;i<count;i++)
+			{
+				last_ping = stream_echo[i].ping;
+				result = convert_step_distance(stream_echo[i].lag);
+				m.seq = last_ping;
+				m.engine = MEAS_STREAM;
+				m.range = result;
+				m.peak = stream_echo[i].peak;
+				meas_publish(&m);
+			}
+		}
+		blocks_done++;
+	}
+}
+#endif /* STREAMING */
+
+#ifndef STREAMING
+#ifdef RECORD
+static void record_ping(const short *capture, short w)	// next record of rec_store
+{
+	unsigned char *rec;
+	unsigned int hi, lo;
+
+	if(!recording || rec_count >= REC_PINGS)
+	{
+		return;
+	}
+	rec = rec_store[rec_count];
+	time_us(&hi, &lo);
+	capture_rec_header((capture_rec_t *)rec, w, AIC23_registers(), pings_done, hi, lo);
+	capture_rec_pack(capture, (short *)(rec + CAPTURE_REC_HEADER));
+	CACHE_wbL2(rec, CAPTURE_REC_BYTES, CACHE_NOWAIT);		// the debugger reads SDRAM, not the cache
+	rec_count++;
+}
+#endif /* RECORD */
+
+static void process_ping(short *capture, short w)	// one capture (capture.h layout) of waveform w => result, ping_result, meas
 {
-	float dist;
-	short max_index;
+	meas_t m;
+	range_gate_t full;
+	double t;
+	Uint32 start;
+	int i;
+
+#ifdef RECORD
+	record_ping(capture, w);
+#endif
+	pings_done++;
+#ifdef PROFILE
+	if(prof_clear)
+	{
+		prof_clear = 0;
+		prof_reset();
+	}
+#endif
 
 	/* ########### Calculation ############ */
-#ifdef SWITCH
+	range_gate_set(&full, range_min, range_max);	// watch window settings, read every ping
+	t = (double)CLK_getltime()*CLK_getprd()/CLK_countspms()*1e-3;	// seconds since boot
+	if(tracking)
+	{
+		tracker_gate(&track, t, &full, &ping_cfg.gate);
+	}
+	else
+	{
+		ping_cfg.gate = full;
+		track.state = TRACK_SEARCH;						// starts again from the full gate
+	}
+	ping_cfg.engine = engine;
+	ping_cfg.method = peak_method;
+	ping_cfg.integrate_k = integrate_k;
+	ping_cfg.integrate_mode = integrate_mode;
+
+	start = CLK_gethtime();
+	if(engine_ping(&eng, &ping_cfg, capture, w, &ping_result))
+	{
+		result = ping_result.range;
+		//printf("distance : %f",result);
 
-	/*---------- Frequency domain ----------*/
-	max_index = cross_correlation_frequency();
+		m.cycles = (unsigned int)((CLK_gethtime() - start)*CLK_cpuCyclesPerHtime());
+		if(tracking)
+		{
+			tracker_update(&track, t, &ping_cfg.gate, &ping_result);
+			tracker_cycles(&track, m.cycles);
+		}
+		m.seq = pings_done - 1;
+		m.engine = ping_result.used;
+		m.waveform = w;
+		m.target_count = ping_result.target_count;
+		m.range = ping_result.range;
+		m.peak = ping_result.peak;
+		m.bearing_deg = ping_result.used == ENGINE_STEREO ? ping_result.bearing_deg : 0;
+		for(i=0;i<MEAS_TARGETS;i++)
+		{
+			m.target_range[i] = i < ping_result.target_count ? ping_result.target_range[i] : 0;
+		}
+		meas_publish(&m);
+	}
+}
+#endif /* STREAMING */
 
+#ifdef PIPELINED
+void ping_tick(void)		// PRD_ping: next ping on the timer grid, while the SWI may still process the last one
+{
+	Uns key;
+	short buf;
+
+	key = HWI_disable();
+	buf = ping_sched_launch(&sched);
+	HWI_restore(key);
+	if(buf != PING_NONE)
+	{
+		ping_launch(buf);
+	}
+}
+
+static void process_pipelined(void)		// every captured ping, oldest first
+{
+	Uns key;
+	short buf;
+
+	for(;;)
+	{
+		key = HWI_disable();
+		buf = ping_sched_begin(&sched);
+		HWI_restore(key);
+		if(buf == PING_NONE)
+		{
+			break;
+		}
+		CACHE_wbInvL2(Buffer_in[buf], sizeof(Buffer_in[buf]), CACHE_WAIT);	// the EDMA wrote behind the cache
+		process_ping(Buffer_in[buf], ping_waveform[buf]);
+		key = HWI_disable();
+		ping_sched_end(&sched);
+		HWI_restore(key);
+	}
+}
 #else
+void ping_tick(void)		// PRD_ping: serial pings are armed by process_SWI
+{
+}
+#endif /* PIPELINED */
 
-	/*------------ Time domain -------------*/
-	max_index = cross_correlation_time();
+void process_SWI(void)
+{
+#ifdef STREAMING
+	process_stream();		// channels keep running, nothing to enable again
+#elif defined(PIPELINED)
+	process_pipelined();	// PRD_ping arms the channels
+#else
+	CACHE_wbInvL2(Buffer_in[0], sizeof(Buffer_in[0]), CACHE_WAIT);	// the EDMA wrote behind the cache
+	process_ping(Buffer_in[0], ping_waveform[0]);
 
-#endif /* SWITCH */
+	// Enable the channels again after processing (next sweep of the rotation)
+	ping_launch(0);
+#endif /* STREAMING */
+}
 
-	dist = convert_step_distance(max_index);
-	result=dist;
-	//printf("distance : %f",dist);
 
-	// Enable the channels again after processing
-	Edma_enable();
+/*######### MEASUREMENT TASK #########*/
+
+void tsk_meas_drain(void)		// lowest priority: meas => RTDX whenever nothing else runs
+{
+	const meas_t *m;
+
+	RTDX_enableOutput(&meas_chan);
+	while(1) {
+		SEM_pendBinary(&SEM_meas, meas_fill(&meas) ? 1 : SYS_FOREVER);	// RTDX buffer was full: again next tick
+
+		while((m = meas_peek(&meas)) != 0 && RTDX_write(&meas_chan, (void *)m, sizeof(meas_t)))
+		{
+			meas_pop(&meas);		// RTDX_write copied it, the slot is free again
+		}
+	}
 }
 
 
@@ -2,11 +2,13 @@
 #define SONAR_H
 
 extern void process_SWI(void);
+extern void ping_tick(void);
 extern void EDMA_interrupt_service(void);
 extern void config_EDMA(void);
 extern void config_interrutps(void);
 extern void SWI_LEDToggle(void);
 extern void tsk_led_toggle(void);
+extern void tsk_meas_drain(void);
 
 	
 #endif /*SONAR_H*/
@@ -0,0 +1,115 @@
+/***********************************************************
+*  sonar_params.h                                          *
+*                                                          *
+*  Signal and buffer dimensions shared by the target       *
+*  code (sonar.c) and the portable processing modules      *
+*                                                          *
+*  Only the first block is meant to be edited, all         *
+*  lengths and transform sizes are derived from it and     *
+*  invalid combinations stop the build.                    *
+*                                                          *
+************************************************************/
+#ifndef SONAR_PARAMS_H_
+#define SONAR_PARAMS_H_
+
+/*------- Parameters -------*/
+
+#define SAMPLE_RATE 48000		// per channel
+#define SWEEP_MS 60				// length of the sent sweep
+#define LISTEN_MS 90			// listening window after the start of the sweep (60 + 30 ms)
+#define SPEED_OF_SOUND 340		// m/s
+#define SWEEP_AMPLITUDE 25000	// peak value of the sent sweep (see frequency_sweep_init)
+#define RX_SPACING 0.1			// m between the left and right hydrophone (stereo engine, bearing)
+#define WAVEFORMS 2				// sweeps in the bank (Host/sweep*.params => sweep_table.c), used in rotation
+#define PING_INTERVAL_MS 100	// PIPELINED: ping rate of the scheduler, >= LISTEN_MS (keep the PRD_ping period in sonar.tcf equal)
+
+//#define FFT_MIXED_RADIX		// uncomment for the smallest 2/3/5 transform size instead of the next power of 2
+
+#define PI 3.14159265358979323846
+
+
+/*------- Derived lengths -------*/
+
+#define SWEEP_LEN (SAMPLE_RATE/1000*SWEEP_MS)			// 2880
+#define RESPONSE_MONO (SAMPLE_RATE/1000*LISTEN_MS)		// 4320
+#define RESPONSE_LEN (2*RESPONSE_MONO)					// interleaved stereo capture
+
+#define CORR_LEN (RESPONSE_MONO + SWEEP_LEN - 1)		// linear correlation without wrap around
+#define PEAK_SPAN RESPONSE_MONO							// lags with overlap between sweep and response
+
+/* smallest power of 2 >= x (256 .. 65536) */
+#define POW2_CEIL(x) ((x) <= 256 ? 256 : (x) <= 512 ? 512 : (x) <= 1024 ? 1024 : (x) <= 2048 ? 2048 : \
+                      (x) <= 4096 ? 4096 : (x) <= 8192 ? 8192 : (x) <= 16384 ? 16384 :              \
+                      (x) <= 32768 ? 32768 : 65536)
+
+#define FFT_POW2 POW2_CEIL(CORR_LEN)					// 8192
+
+/* smallest N = FFT_POW2/256 x n >= CORR_LEN with n/128 in [1,2] 2/3/5 smooth => N/2 is 2/3/5 smooth too */
+#define FFT_SMOOTH(n) (FFT_POW2/256*(n))
+#define FFT_SMOOTH_CEIL                                                                              \
+    (FFT_SMOOTH(135) >= CORR_LEN ? FFT_SMOOTH(135) : FFT_SMOOTH(144) >= CORR_LEN ? FFT_SMOOTH(144) :  \
+     FFT_SMOOTH(150) >= CORR_LEN ? FFT_SMOOTH(150) : FFT_SMOOTH(160) >= CORR_LEN ? FFT_SMOOTH(160) :  \
+     FFT_SMOOTH(162) >= CORR_LEN ? FFT_SMOOTH(162) : FFT_SMOOTH(180) >= CORR_LEN ? FFT_SMOOTH(180) :  \
+     FFT_SMOOTH(192) >= CORR_LEN ? FFT_SMOOTH(192) : FFT_SMOOTH(200) >= CORR_LEN ? FFT_SMOOTH(200) :  \
+     FFT_SMOOTH(216) >= CORR_LEN ? FFT_SMOOTH(216) : FFT_SMOOTH(225) >= CORR_LEN ? FFT_SMOOTH(225) :  \
+     FFT_SMOOTH(240) >= CORR_LEN ? FFT_SMOOTH(240) : FFT_SMOOTH(243) >= CORR_LEN ? FFT_SMOOTH(243) :  \
+     FFT_SMOOTH(250) >= CORR_LEN ? FFT_SMOOTH(250) : FFT_POW2)
+
+#ifdef FFT_MIXED_RADIX
+#define FFT_N FFT_SMOOTH_CEIL							// 7200 = 2 x 3600 = 2 x 2^4 3^2 5^2
+#else
+#define FFT_N FFT_POW2
+#endif
+/* FFT_N real points of the correlation transform, computed as FFT_N/2 complex points */
+
+
+/*------- Streaming mode (continuous capture) -------*/
+/* The receive channel runs forever on two linked ping pong buffers of STREAM_BLOCK
+   stereo frames. Every block is correlated with overlap-save, so the transform must
+   cover one block plus the sweep length: STREAM_BLOCK + SWEEP_LEN - 1 <= STREAM_FFT_N */
+
+#define STREAM_BLOCK 4096		// new mono samples per EDMA block (hop size)
+#define PING_PERIOD RESPONSE_MONO	// samples between two sent sweeps (90 ms), >= SWEEP_LEN
+#define STREAM_FFT_N POW2_CEIL(STREAM_BLOCK + SWEEP_LEN - 1)		// complex points of the overlap-save transform
+#define STREAM_MAX_ECHO (STREAM_BLOCK/PING_PERIOD + 1)			// echoes one block can complete
+
+
+/*------- Checks -------*/
+
+#if SAMPLE_RATE % 1000 != 0
+#error "SAMPLE_RATE must be a multiple of 1000 Hz"
+#endif
+
+#if SWEEP_LEN % 2 != 0
+#error "SWEEP_LEN must be even (up sweep mirrored into the down sweep)"
+#endif
+
+#if RESPONSE_MONO % 2 != 0
+#error "RESPONSE_MONO must be even (read by the real input transform as RESPONSE_MONO/2 complex points)"
+#endif
+
+#if LISTEN_MS <= SWEEP_MS
+#error "LISTEN_MS must be longer than SWEEP_MS"
+#endif
+
+#if PING_INTERVAL_MS < LISTEN_MS
+#error "PING_INTERVAL_MS must be at least LISTEN_MS (a ping is launched before the last one is captured)"
+#endif
+
+#if FFT_N > 16384
+#error "sweep + listening window too long: transform sizes are 16 bit (CORR_LEN <= FFT_N <= 16384)"
+#endif
+
+#if FFT_N < CORR_LEN || FFT_N % 4 != 0
+#error "invalid FFT_N"
+#endif
+
+#if STREAM_FFT_N > 16384
+#error "STREAM_BLOCK + SWEEP_LEN too long for the 16 bit radix 2 FFT"
+#endif
+
+#if PING_PERIOD < SWEEP_LEN
+#error "PING_PERIOD must be at least SWEEP_LEN"
+#endif
+
+#endif /*SONAR_PARAMS_H_*/
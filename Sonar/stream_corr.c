@@ -0,0 +1,207 @@
+/***********************************************************
+*  stream_corr.c                                           *
+*                                                          *
+*  Overlap-save streaming cross correlation                *
+*  (portable C, no CSL => also builds on the host)         *
+*                                                          *
+*  Every push takes one block of STREAM_BLOCK new samples. *
+*  The FFT window is [STREAM_KEEP old samples | new block] *
+*  and the first STREAM_BLOCK lags of its circular         *
+*  correlation with the sweep are free of wrap around      *
+*  (STREAM_KEEP >= SWEEP_LEN - 1). Output k of a push is   *
+*  the correlation at sample position - STREAM_KEEP + k,   *
+*  i.e. results lag the capture by STREAM_KEEP samples.    *
+*                                                          *
+************************************************************/
+#include "fft.h"
+#include "fft_r4.h"
+#include "stream_corr.h"
+
+
+void stream_corr_reset(stream_corr_t *s)
+{
+	int i;
+
+	for(i=0;i<STREAM_KEEP;i++)
+	{
+		s->history[i]=0;
+	}
+	s->skip = STREAM_KEEP;			// the first window starts STREAM_KEEP samples before the stream
+	s->ping = 0;
+	s->lag = 0;
+	s->best_lag = 0;
+	s->best_peak = 0;
+	s->invalid = 0;
+	s->lost = 0;
+}
+
+
+void stream_corr_init(stream_corr_t *s, const short *sweep, short max_lag)
+{
+	int i;
+	float scale;
+
+	/*----- Coefficients -----*/
+	tw_genr2fft(s->twiddle, STREAM_FFT_N);
+	bit_rev(s->twiddle, STREAM_FFT_N>>1);
+
+	/*----- Sweep spectrum (done once, not per block) -----*/
+	for(i=0;i<STREAM_FFT_N;i++)
+	{
+		if(i < SWEEP_LEN)
+		{
+			s->sweep_spec[2*i] = (float)sweep[i]/SWEEP_AMPLITUDE;
+		}
+		else
+		{
+			s->sweep_spec[2*i] = 0;
+		}
+		s->sweep_spec[2*i+1] = 0;
+	}
+	cfft_dit(s->sweep_spec, s->twiddle, STREAM_FFT_N);
+
+	// conjugate => the product is a correlation (not a convolution),
+	// and fold in the 1/N the inverse transform leaves out
+	scale = 1.0f/STREAM_FFT_N;
+	for(i=0;i<STREAM_FFT_N;i++)
+	{
+		s->sweep_spec[2*i]   =  scale*s->sweep_spec[2*i];
+		s->sweep_spec[2*i+1] = -scale*s->sweep_spec[2*i+1];
+	}
+
+	if(max_lag > PING_PERIOD || max_lag <= 0)
+	{
+		max_lag = PING_PERIOD;
+	}
+	s->max_lag = max_lag;
+
+	stream_corr_reset(s);
+}
+
+
+/* Advances the ping bookkeeping over n correlation outputs that are not computed.
+   Every ping whose search span overlaps them is dropped: the current one if they start
+   inside its span, the one they end in if they cover any of its lags. */
+static void stream_corr_advance(stream_corr_t *s, int n)
+{
+	int total;
+
+	if(s->skip >= n)
+	{
+		s->skip -= n;
+		return;
+	}
+	n -= s->skip;
+	s->skip = 0;
+
+	total = s->lag + n;
+	if(total < PING_PERIOD)
+	{
+		s->invalid |= s->lag < s->max_lag;
+	}
+	else
+	{
+		s->ping += total/PING_PERIOD;
+		s->lag = total%PING_PERIOD;
+		s->invalid = s->lag > 0;					// lags 0..lag-1 of the new ping are lost
+		s->best_lag = 0;
+		s->best_peak = 0;
+		return;
+	}
+	s->lag = total;
+}
+
+
+void stream_corr_skip(stream_corr_t *s)		// a block was lost (overrun): keep the time base, forget the overlap
+{
+	int i;
+
+	for(i=0;i<STREAM_KEEP;i++)
+	{
+		s->history[i]=0;
+	}
+	stream_corr_advance(s, STREAM_BLOCK);
+	s->lost = STREAM_KEEP;						// the next push reaches back into the lost block
+}
+
+
+int stream_corr_push(stream_corr_t *s, const short *block, int stride, stream_echo_t *echo)
+{
+	float *x = s->window;
+	float re, im, value;
+	int i, k, count;
+
+	/*--------- Window ----------*/
+	/* [ history | block ], block read with stride (2 = left channel of the interleaved capture) */
+	for(i=0;i<STREAM_KEEP;i++)
+	{
+		x[2*i] = s->history[i];
+		x[2*i+1] = 0;
+	}
+	for(i=0;i<STREAM_BLOCK;i++)
+	{
+		x[2*(STREAM_KEEP+i)] = (float)block[i*stride]/SWEEP_AMPLITUDE;
+		x[2*(STREAM_KEEP+i)+1] = 0;
+	}
+	for(i=0;i<STREAM_KEEP;i++)							// overlap for the next push
+	{
+		s->history[i] = x[2*(STREAM_FFT_N-STREAM_KEEP+i)];
+	}
+
+	/*------ Correlation -------*/
+	cfft_dit(x, s->twiddle, STREAM_FFT_N);
+	for(i=0;i<2*STREAM_FFT_N;i=i+2)						// both spectra bit reversed
+	{
+		re = x[i]*s->sweep_spec[i] - x[i+1]*s->sweep_spec[i+1];
+		im = x[i+1]*s->sweep_spec[i] + x[i]*s->sweep_spec[i+1];
+		x[i] = re;
+		x[i+1] = im;
+	}
+	icfft_dif(x, s->twiddle, STREAM_FFT_N);
+
+	/*---- Maximum per ping ----*/
+	count = 0;
+	for(k=0;k<STREAM_BLOCK;k++)
+	{
+		if(s->skip)
+		{
+			s->skip--;
+			s->lost -= s->lost > 0;
+			continue;
+		}
+		if(s->lag < s->max_lag)
+		{
+			value = x[2*k];
+			if(s->lost)
+			{
+				s->invalid = 1;					// correlated with the zeroed overlap
+			}
+			else if(value > s->best_peak)
+			{
+				s->best_peak = value;
+				s->best_lag = s->lag;
+			}
+			if(s->lag == s->max_lag-1)			// search span complete => report
+			{
+				if(!s->invalid)
+				{
+					echo[count].ping = s->ping;
+					echo[count].lag = s->best_lag;
+					echo[count].peak = s->best_peak;
+					count++;
+				}
+				s->best_lag = 0;
+				s->best_peak = 0;
+			}
+		}
+		s->lost -= s->lost > 0;
+		if(++s->lag == PING_PERIOD)
+		{
+			s->lag = 0;
+			s->ping++;
+			s->invalid = 0;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,43 @@
+/***********************************************************
+*  stream_corr.h                                           *
+*                                                          *
+*  Overlap-save streaming cross correlation                *
+*  Every captured block is correlated with the sweep as    *
+*  soon as it lands, the echoes are reported per ping.     *
+*                                                          *
+************************************************************/
+#ifndef STREAM_CORR_H_
+#define STREAM_CORR_H_
+
+#include "sonar_params.h"
+
+#define STREAM_KEEP (STREAM_FFT_N - STREAM_BLOCK)	// samples kept from the previous window
+
+typedef struct {
+	long  ping;			// sequence number of the ping (0 = first sweep sent)
+	short lag;			// array index of the strongest echo (same meaning as in cross_correlation_time)
+	float peak;			// correlation value at lag
+} stream_echo_t;
+
+typedef struct {
+	float window[2*STREAM_FFT_N];		// complex work array (window -> spectrum -> correlation)
+	float sweep_spec[2*STREAM_FFT_N];	// conj(FFT(sweep)) / N, bit reversed
+	float twiddle[STREAM_FFT_N];		// bit reversed twiddle factors
+	float history[STREAM_KEEP];			// tail of the previous window (overlap)
+
+	int   skip;			// correlation outputs still belonging to the time before the first block
+	long  ping;			// ping the next correlation output belongs to
+	short lag;			// its position inside the ping period
+	short max_lag;		// peak search span of a ping (<= PING_PERIOD)
+	short best_lag;		// strongest echo so far in the current ping
+	float best_peak;
+	short invalid;		// the current ping lost part of its search span (overrun): not reported
+	int   lost;			// next outputs correlated against the zeroed overlap, count as lost
+} stream_corr_t;
+
+void stream_corr_init(stream_corr_t *s, const short *sweep, short max_lag);
+void stream_corr_reset(stream_corr_t *s);
+int  stream_corr_push(stream_corr_t *s, const short *block, int stride, stream_echo_t *echo);
+void stream_corr_skip(stream_corr_t *s);	// a block was lost: every ping whose span overlaps it is dropped
+
+#endif /*STREAM_CORR_H_*/
@@ -0,0 +1,32 @@
+/***********************************************************
+*  sweep.c                                                 *
+*                                                          *
+*  Sent frequency sweep                                    *
+*  (portable C, no CSL => also builds on the host)         *
+*                                                          *
+*  The samples are computed on the host by sweep_gen       *
+*  (Host/sweep*.params => sweep_table.c), boot only copies *
+*  them: no sin/cos/sqrt per sample and no libm at start   *
+*  up. For the recursion itself see Host/sweep_synth.c     *
+*  and the file "freq_sweep.html".                         *
+*                                                          *
+************************************************************/
+#include "sonar_params.h"
+#include "sweep.h"
+
+
+void frequency_sweep_init(short *sweep)			// Initialisation of then sent signal
+{
+	waveform_init(sweep, 0);
+}
+
+
+void waveform_init(short *sweep, short waveform)
+{
+	short k;
+
+	for(k=0;k<SWEEP_LEN;k++)
+	{
+		sweep[k] = sweep_bank[waveform][k];
+	}
+}
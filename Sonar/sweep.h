@@ -0,0 +1,17 @@
+/***********************************************************
+*  sweep.h                                                 *
+*                                                          *
+*  Generation of the sent frequency sweep                  *
+*                                                          *
+************************************************************/
+#ifndef SWEEP_H_
+#define SWEEP_H_
+
+#include "sonar_params.h"
+
+extern const short sweep_bank[WAVEFORMS][SWEEP_LEN];	// generated (sweep_table.c), [0] = up + down sweep
+
+void frequency_sweep_init(short *sweep);	// fills SWEEP_LEN samples (up sweep + mirrored down sweep)
+void waveform_init(short *sweep, short waveform);	// same for any waveform of the bank
+
+#endif /*SWEEP_H_*/
@@ -0,0 +1,503 @@
+/***********************************************************
+*  sweep_table.c                                           *
+*                                                          *
+*  GENERATED by Host/sweep_gen, do not edit:               *
+*    make -C Host table [PARAMS=<files>]                   *
+*                                                          *
+************************************************************/
+/* 0: sample_rate 48000, f_start 1000, f_step 6.25, amplitude 25000, length 2880, mirror 1, window none */
+/* 1: sample_rate 48000, f_start 10000, f_step -3.125, amplitude 25000, length 2880, mirror 0, window none */
+#include "sonar_params.h"
+#include "sweep.h"
+
+#if WAVEFORMS != 2 || SWEEP_LEN != 2880 || SAMPLE_RATE != 48000 || SWEEP_AMPLITUDE != 25000
+#error "sweep_table.c was generated for another WAVEFORMS / SWEEP_LEN / SAMPLE_RATE / SWEEP_AMPLITUDE, run sweep_gen again"
+#endif
+
+#pragma DATA_SECTION(sweep_bank, ".processbuffer");		// read once at boot (placement.h)
+const short sweep_bank[WAVEFORMS][SWEEP_LEN] = {
+{
+	25000, 6509, -2151, -4141, -9979, -8913, -15611, -10883, -4031, 1444, 4370, 8529,
+	10337, 18772, 10981, 1313, -3105, -6102, -10622, -11649, -23585, -10596, 738, 3969,
+	8224, 10670, 17234, 12948, 6584, 37, -3848, -7651, -11306, -14651, -17776, -20068,
+	-22973, -22463, -23212, -24973, -24623, -23632, -22048, -19993, -17787, -16335, -18804, -22646,
+	-21024, -19662, -20226, -24882, -20482, -11362, -868, 4018, 7914, 12690, 14842, 22539,
+	15778, 5049, -2432, -5983, -11750, -13123, -24162, -13769, -1229, 4208, 8193, 13496,
+	15248, 24015, 15975, 3954, -3251, -6941, -13185, -14105, -24984, -14873, -1903, 4227,
+	8275, 14153, 15517, 24812, 16489, 4078, -3447, -7373, -13847, -14902, -24991, -16209,
+	-3586, 3770, 7846, 14365, 15484, 24996, 17057, 4890, -3261, -7470, -14076, -15547,
+	-24887, -17514, -5854, 2820, 7262, 13790, 15806, 24476, 18339, 8126, -1334, -6433,
+	-12358, -16026, -22015, -20810, -20842, -23541, -24799, -24772, -23413, -20805, -17137, -12723,
+	-7950, -3023, 2442, 8552, 13675, 18807, 21371, 24843, 24600, 22936, 19971, 15963,
+	11302, 6396, 1264, -4732, -10898, -15930, -20727, -22876, -24996, -24965, -23120, -19527,
+	-14278, -7616, -394, 6109, 12157, 17466, 21455, 24156, 24994, 24081, 21469, 17343,
+	12011, 5866, -716, -7388, -13530, -18705, -22482, -24615, -24885, -23269, -19881, -14976,
+	-8936, -2218, 4720, 11362, 17088, 21535, 24191, 24980, 23764, 20632, 15839, 9788,
+	2960, -4181, -11084, -17013, -21613, -24268, -24946, -23504, -20055, -14902, -8505, -1383,
+	5975, 12885, 18611, 22761, 24780, 24593, 22187, 17779, 11783, 4744, -2783, -10192,
+	-16607, -21542, -24348, -24893, -23067, -19035, -13192, -6103, 1603, 9273, 16024, 21224,
+	24277, 24917, 23046, 18844, 12736, 5344, -2619, -10399, -17094, -22042, -24649, -24669,
+	-22076, -17138, -10384, -2525, 5660, 13300, 19465, 23549, 24998, 23675, 19714, 13553,
+	5880, -2471, -10611, -17548, -22498, -24846, -24323, -20971, -15173, -7608, 859, 9288,
+	16638, 22004, 24737, 24481, 21252, 15434, 7735, -919, -9514, -16955, -22287, -24839,
+	-24264, -20618, -14355, -6269, 2630, 11249, 18426, 23227, 24996, 23489, 18889, 11797,
+	3145, -5956, -14315, -20740, -24394, -24725, -21680, -15663, -7495, 1711, 10728, 18272,
+	23267, 24999, 23202, 18115, 10455, 1303, -8073, -16330, -22217, -24897, -23937, -19464,
+	-12127, -3001, 6595, 15258, 21633, 24778, 24179, 19911, 12611, 3389, -6375, -15206,
+	-21683, -24812, -24067, -19549, -11957, -2480, 7414, 16176, 22349, 24955, 23539, 18313,
+	10116, 270, -9656, -18031, -23431, -24962, -22341, -15992, -6968, 3237, 12946, 20473,
+	24526, 24388, 20064, 12286, 2387, -7953, -16951, -22983, -24995, -22602, -16210, -6945,
+	3567, 13489, 21001, 24738, 23998, 18897, 10353, -85, -10544, -19092, -24106, -24650,
+	-20598, -12694, -2409, 8357, 17586, 23473, 24898, 21560, 14085, 3899, -7061, -16698,
+	-23081, -24965, -21950, -14613, -4391, 6718, 16538, 23054, 24961, 21845, 14319, 3895,
+	-7340, -17123, -23399, -24878, -21225, -13182, -2403, 8901, 18386, 24010, 24586, 19967,
+	11116, -99, -11329, -20163, -24662, -23843, -17863, -8005, 3603, 14467, 22171, 24999,
+	22303, 14662, 3761, -7996, -18006, -23970, -24537, -19555, -10136, 1593, 12995, 21443,
+	24961, 22719, 15216, 4181, -7845, -18079, -24073, -24408, -18979, -9055, 3024, 14422,
+	22388, 24985, 21565, 12935, 1171, -10902, -20352, -24820, -23198, -15863, -4611, 7799,
+	18312, 24259, 24142, 17965, 7266, -5276, -16523, -23579, -24628, -19377, -9154, 3428,
+	15163, 22988, 24843, 20223, 10316, -2298, -14341, -22622, -24918, -20597, -10790, 1899,
+	14112, 22556, 24920, 20545, 10597, -2234, -14489, -22801, -24854, -20063, -9731, 3300,
+	15448, 23309, 24658, 19092, 8159, -5080, -16920, -23972, -24206, -17531, -5839, 7538,
+	18785, 24612, 23314, 15244, 2734, -10592, -20852, -24984, -21753, -12093, 1152, 14084,
+	22842, 24771, 19270, 7974, -5732, -17740, -24378, -23603, -15627, -2870, 10783, 21155,
+	24999, 21109, 10668, -3093, -15922, -23787, -24189, -16978, -4409, 9566, 20543, 24985,
+	21454, 11058, -2887, -15935, -23861, -24067, -16464, -3505, 10611, 21292, 24989, 20466,
+	9193, -5124, -17775, -24529, -23105, -13955, -127, 13765, 23047, 24540, 17714, 4869,
+	-9644, -20899, -24997, -20510, -8960, 5688, 18400, 24737, 22465, 12352, -2082, -15814,
+	-24005, -23730, -15063, -1055, 13345, 23020, 24469, 17149, 3670, -11143, -21966, -24839,
+	-18694, -5748, 9304, 20988, 24978, 19785, 7298, -7892, -20192, -24998, -20495, -8339,
+	6942, 19652, 24977, 20881, 8890, -6476, -19413, -24964, -20979, -8961, 6501, 19494,
+	24975, 20796, 8553, -7019, -19889, -24997, -20315, -7657, 8020, 20566, 24984, 19495,
+	6256, -9482, -21467, -24859, -18271, -4331, 11366, 22501, 24515, 16566, 1869, -13605,
+	-23541, -23817, -14295, 1120, 16093, 24422, 22609, 11383, -4595, -18677, -24943, -20726,
+	-7776, 8462, 21151, 24871, 18011, 3473, -12561, -23245, -23950, -14344, 1448, 16636,
+	24635, 21931, 9676, -6805, -20338, -24962, -18613, -4064, 12290, 23236, 23874, 13893,
+	-2279, -17455, -24835, -21069, -7824, 8952, 21715, 24646, 16388, 672, -15365, -24406,
+	-22265, -9899, 7025, 20737, 24870, 17479, 1970, -14469, -24187, -22595, -10414, 6660,
+	20626, 24871, 17356, 1615, -14906, -24360, -22192, -9412, 7880, 21417, 24652, 15994,
+	-395, -16611, -24784, -20895, -6815, 10602, 22855, 23891, 13170, -4044, -19284, -24988,
+	-18290, -2494, 14557, 24364, 21972, 8556, -9166, -22298, -24174, -13816, 3549, 19133,
+	24987, 18087, 1934, -15222, -24585, -21292, -7012, 10897, 23189, 23445, 11500, -6441,
+	-21043, -24636, -15301, 2079, 18384, 24999, 18387, 2025, -15425, -24688, -20777, -5756,
+	12355, 23861, 22530, 9051, -9321, -22674, -23731, -11885, 6435, 21269, 24477, 14268,
+	-3778, -19766, -24868, -16226, 1401, 18268, 24997, 17798, 662, -16857, -24951, -19029,
+	-2396, 15598, 24803, 19963, 3795, -14538, -24616, -20642, -4861, 13712, 24438, 21103,
+	5599, -13145, -24307, -21371, -6014, 12850, 24244, 21465, 6111, -12834, -24259, -21390,
+	-5890, 13099, 24351, 21141, 5350, -13637, -24503, -20703, -4486, 14434, 24689, 20051,
+	3293, -15467, -24868, -19150, -1767, 16704, 24984, 17957, -91, -18099, -24973, -16429,
+	2276, 19589, 24754, 14519, -4765, -21095, -24238, -12186, 7520, 22519, 23327, 9401,
+	-10477, -23739, -21924, -6155, 13543, 24616, 19935, 2472, -16588, -24995, -17284, 1591,
+	19453, 24717, 13924, -5932, -21942, -23627, -9848, 10390, 23829, 21589, 5114, -14744,
+	-24871, -18509, 146, 18716, 24828, 14359, -5717, -21983, -23495, -9201, 11297, 24193,
+	20727, 3215, -16487, -24999, -16479, 3288, 20825, 24108, 10848, -9872, -23818, -21334,
+	-4103, 15975, 24996, 16646, -3291, -20950, -23985, -10233, 10695, 24137, 20598, 2540,
+	-17319, -24949, -14900, 5725, 22300, 22997, 7284, -13641, -24822, -18197, 1504, 20136,
+	24262, 10861, -10401, -24148, -20362, -1763, 18129, 24807, 13346, -7891, -23360, -21664,
+	-4016, 16601, 24975, 14864, -6265, -22762, -22333, -5261, 15744, 24999, 15530, -5591,
+	-22528, -22513, -5520, 15649, 24999, 15400, -5890, -22720, -22248, -4798, 16326, 24972,
+	14465, -7154, -23288, -21476, -3081, 17704, 24794, 12643, -9335, -24068, -20033, -348,
+	19619, 24225, 9813, -12319, -24771, -17679, 3383, 21782, 22921, 5855, -15874, -24976,
+	-14144, 7994, 23752, 20463, 735, -19595, -24148, -9206, 13182, 24917, 16438, -5397,
+	-22856, -21690, -2814, 18372, 24527, 10558, -12089, -24808, -17075, 4757, 22670, 21811,
+	2854, -18483, -24453, -10036, 12764, 24910, 16189, -6114, -23297, -20875, -855, 19897,
+	23837, 7586, -15105, -24983, -13598, 9377, 24367, 18522, -3184, -22174, -22122, -3035,
+	18676, 24284, 8899, -14194, -24999, -14092, 9074, 24353, 18384, -3651, -22505, -21638,
+	-1772, 19660, 23794, 6939, -16050, -24858, -11638, 11911, 24894, 15716, -7473, -24007,
+	-19074, 2942, 22333, 21668, 1506, -20022, -23495, -5731, 17226, 24584, 9621, -14093,
+	-24993, -13096, 10763, 24795, 16110, -7357, -24080, -18644, 3976, 22940, 20703, -702,
+	-21467, -22308, -2402, 19750, 23495, 5292, -17867, -24303, -7935, 15893, 24783, 10316,
+	-13889, -24985, -12428, 11911, 24960, 14277, -10000, -24759, -15874, 8193, 24429, 17235,
+	-6514, -24013, -18381, 4983, 23548, 19333, -3615, -23069, -20111, 2419, 22604, 20735,
+	-1401, -22177, -21223, 563, 21808, 21593, 90, -21512, -21856, -560, 21300, 22023,
+	847, -21181, -22100, -949, 21159, 22091, 868, -21235, -21994, -603, 21406, 21807,
+	153, -21665, -21521, 480, 22004, 21126, -1298, -22408, -20608, 2298, 22860, 19950,
+	-3477, -23337, -19134, 4829, 23812, 18138, -6346, -24255, -16943, 8012, 24628, 15527,
+	-9809, -24891, -13873, 11711, 24999, 11966, -13683, -24903, -9795, 15683, 24552, 7358,
+	-17660, -23896, -4661, 19552, 22883, 1723, -21290, -21468, 1423, 22793, 19612, -4729,
+	-23975, -17287, 8127, 24741, 14482, -11527, -24999, -11207, 14822, 24661, 7496, -17888,
+	-23650, -3412, 20586, 21906, -952, -22768, -19395, 5469, 24279, 16116, -9974, -24970,
+	-12114, 14272, 24713, 7479, -18142, -23409, -2357, 21353, 21005, -3050, -23670, -17509,
+	8490, 24873, 12999, -13660, -24777, -7636, 18226, 23263, 1666, -21846, -20292, 4584,
+	24198, 15931, -10716, -24999, -10364, 16274, 24054, 3902, -20791, -21291, 3027, 23822,
+	16782, -9895, -24995, -10773, 16102, 24055, 3681, -21036, -20930, 3916, 24139, 15759,
+	-11319, -24966, -8914, 17754, 23265, 997, -22468, -19047, 7202, 24822, 12619, -14765,
+	-24379, -4592, 20743, 21010, -4155, -24295, -14955, 12556, 24807, 6842, -19468, -22019,
+	2349, 23851, 16125, -11387, -24925, -7802, 18930, 22332, -1838, -23744, -16267, 11367,
+	24914, 7511, -19233, -22040, 2631, 24027, 15398, -12498, -24751, -5958, 20319, 21058,
+	-4712, -24554, -13412, 14675, 24213, 3085, -21958, -19133, 8010, 24973, 10117, -17644,
+	-22884, 1137, 23710, 15897, -12316, -24720, -5325, 20928, 20207, -6599, -24888, -10973,
+	17157, 23048, -990, -23747, -15598, 12878, 24566, 4165, -21685, -19151, 8486, 24999,
+	8665, -19067, -21700, 4279, 24619, 12424, -16209, -23384, 453, 23694, 15442, -13361,
+	-24376, -2874, 22467, 17777, -10708, -24857, -5655, 21143, 19519, -8383, -24998, -7881,
+	19883, 20766, -6468, -24945, -9569, 18808, 21613, -5013, -24814, -10747, 18004, 22138,
+	-4046, -24691, -11445, 17528, 22400, -3579, -24630, -11682, 17410, 22428, -3618, -24654,
+	-11467, 17656, 22226, -4161, -24754, -10791, 18253, 21770, -5204, -24890, -9635, 19160,
+	21009, -6732, -24991, -7972, 20312, 19870, -8713, -24953, -5773, 21611, 18260, -11095,
+	-24644, -3019, 22921, 16080, -13786, -23903, 283, 24066, 13238, -16650, -22551, 4087,
+	24828, 9665, -19490, -20409, 8280, 24954, 5344, -22044, -17319, 12669, 24169, 337,
+	-23990, -13175, 16962, 22209, -5184, -24957, -7970, 20768, 18860, -10915, -24556, -1834,
+	-1834, -24556, -10915, 18860, 20768, -7970, -24957, -5184, 22209, 16962, -13175, -23990,
+	337, 24169, 12669, -17319, -22044, 5344, 24954, 8280, -20409, -19490, 9665, 24828,
+	4087, -22551, -16650, 13238, 24066, 283, -23903, -13786, 16080, 22921, -3019, -24644,
+	-11095, 18260, 21611, -5773, -24953, -8713, 19870, 20312, -7972, -24991, -6732, 21009,
+	19160, -9635, -24890, -5204, 21770, 18253, -10791, -24754, -4161, 22226, 17656, -11467,
+	-24654, -3618, 22428, 17410, -11682, -24630, -3579, 22400, 17528, -11445, -24691, -4046,
+	22138, 18004, -10747, -24814, -5013, 21613, 18808, -9569, -24945, -6468, 20766, 19883,
+	-7881, -24998, -8383, 19519, 21143, -5655, -24857, -10708, 17777, 22467, -2874, -24376,
+	-13361, 15442, 23694, 453, -23384, -16209, 12424, 24619, 4279, -21700, -19067, 8665,
+	24999, 8486, -19151, -21685, 4165, 24566, 12878, -15598, -23747, -990, 23048, 17157,
+	-10973, -24888, -6599, 20207, 20928, -5325, -24720, -12316, 15897, 23710, 1137, -22884,
+	-17644, 10117, 24973, 8010, -19133, -21958, 3085, 24213, 14675, -13412, -24554, -4712,
+	21058, 20319, -5958, -24751, -12498, 15398, 24027, 2631, -22040, -19233, 7511, 24914,
+	11367, -16267, -23744, -1838, 22332, 18930, -7802, -24925, -11387, 16125, 23851, 2349,
+	-22019, -19468, 6842, 24807, 12556, -14955, -24295, -4155, 21010, 20743, -4592, -24379,
+	-14765, 12619, 24822, 7202, -19047, -22468, 997, 23265, 17754, -8914, -24966, -11319,
+	15759, 24139, 3916, -20930, -21036, 3681, 24055, 16102, -10773, -24995, -9895, 16782,
+	23822, 3027, -21291, -20791, 3902, 24054, 16274, -10364, -24999, -10716, 15931, 24198,
+	4584, -20292, -21846, 1666, 23263, 18226, -7636, -24777, -13660, 12999, 24873, 8490,
+	-17509, -23670, -3050, 21005, 21353, -2357, -23409, -18142, 7479, 24713, 14272, -12114,
+	-24970, -9974, 16116, 24279, 5469, -19395, -22768, -952, 21906, 20586, -3412, -23650,
+	-17888, 7496, 24661, 14822, -11207, -24999, -11527, 14482, 24741, 8127, -17287, -23975,
+	-4729, 19612, 22793, 1423, -21468, -21290, 1723, 22883, 19552, -4661, -23896, -17660,
+	7358, 24552, 15683, -9795, -24903, -13683, 11966, 24999, 11711, -13873, -24891, -9809,
+	15527, 24628, 8012, -16943, -24255, -6346, 18138, 23812, 4829, -19134, -23337, -3477,
+	19950, 22860, 2298, -20608, -22408, -1298, 21126, 22004, 480, -21521, -21665, 153,
+	21807, 21406, -603, -21994, -21235, 868, 22091, 21159, -949, -22100, -21181, 847,
+	22023, 21300, -560, -21856, -21512, 90, 21593, 21808, 563, -21223, -22177, -1401,
+	20735, 22604, 2419, -20111, -23069, -3615, 19333, 23548, 4983, -18381, -24013, -6514,
+	17235, 24429, 8193, -15874, -24759, -10000, 14277, 24960, 11911, -12428, -24985, -13889,
+	10316, 24783, 15893, -7935, -24303, -17867, 5292, 23495, 19750, -2402, -22308, -21467,
+	-702, 20703, 22940, 3976, -18644, -24080, -7357, 16110, 24795, 10763, -13096, -24993,
+	-14093, 9621, 24584, 17226, -5731, -23495, -20022, 1506, 21668, 22333, 2942, -19074,
+	-24007, -7473, 15716, 24894, 11911, -11638, -24858, -16050, 6939, 23794, 19660, -1772,
+	-21638, -22505, -3651, 18384, 24353, 9074, -14092, -24999, -14194, 8899, 24284, 18676,
+	-3035, -22122, -22174, -3184, 18522, 24367, 9377, -13598, -24983, -15105, 7586, 23837,
+	19897, -855, -20875, -23297, -6114, 16189, 24910, 12764, -10036, -24453, -18483, 2854,
+	21811, 22670, 4757, -17075, -24808, -12089, 10558, 24527, 18372, -2814, -21690, -22856,
+	-5397, 16438, 24917, 13182, -9206, -24148, -19595, 735, 20463, 23752, 7994, -14144,
+	-24976, -15874, 5855, 22921, 21782, 3383, -17679, -24771, -12319, 9813, 24225, 19619,
+	-348, -20033, -24068, -9335, 12643, 24794, 17704, -3081, -21476, -23288, -7154, 14465,
+	24972, 16326, -4798, -22248, -22720, -5890, 15400, 24999, 15649, -5520, -22513, -22528,
+	-5591, 15530, 24999, 15744, -5261, -22333, -22762, -6265, 14864, 24975, 16601, -4016,
+	-21664, -23360, -7891, 13346, 24807, 18129, -1763, -20362, -24148, -10401, 10861, 24262,
+	20136, 1504, -18197, -24822, -13641, 7284, 22997, 22300, 5725, -14900, -24949, -17319,
+	2540, 20598, 24137, 10695, -10233, -23985, -20950, -3291, 16646, 24996, 15975, -4103,
+	-21334, -23818, -9872, 10848, 24108, 20825, 3288, -16479, -24999, -16487, 3215, 20727,
+	24193, 11297, -9201, -23495, -21983, -5717, 14359, 24828, 18716, 146, -18509, -24871,
+	-14744, 5114, 21589, 23829, 10390, -9848, -23627, -21942, -5932, 13924, 24717, 19453,
+	1591, -17284, -24995, -16588, 2472, 19935, 24616, 13543, -6155, -21924, -23739, -10477,
+	9401, 23327, 22519, 7520, -12186, -24238, -21095, -4765, 14519, 24754, 19589, 2276,
+	-16429, -24973, -18099, -91, 17957, 24984, 16704, -1767, -19150, -24868, -15467, 3293,
+	20051, 24689, 14434, -4486, -20703, -24503, -13637, 5350, 21141, 24351, 13099, -5890,
+	-21390, -24259, -12834, 6111, 21465, 24244, 12850, -6014, -21371, -24307, -13145, 5599,
+	21103, 24438, 13712, -4861, -20642, -24616, -14538, 3795, 19963, 24803, 15598, -2396,
+	-19029, -24951, -16857, 662, 17798, 24997, 18268, 1401, -16226, -24868, -19766, -3778,
+	14268, 24477, 21269, 6435, -11885, -23731, -22674, -9321, 9051, 22530, 23861, 12355,
+	-5756, -20777, -24688, -15425, 2025, 18387, 24999, 18384, 2079, -15301, -24636, -21043,
+	-6441, 11500, 23445, 23189, 10897, -7012, -21292, -24585, -15222, 1934, 18087, 24987,
+	19133, 3549, -13816, -24174, -22298, -9166, 8556, 21972, 24364, 14557, -2494, -18290,
+	-24988, -19284, -4044, 13170, 23891, 22855, 10602, -6815, -20895, -24784, -16611, -395,
+	15994, 24652, 21417, 7880, -9412, -22192, -24360, -14906, 1615, 17356, 24871, 20626,
+	6660, -10414, -22595, -24187, -14469, 1970, 17479, 24870, 20737, 7025, -9899, -22265,
+	-24406, -15365, 672, 16388, 24646, 21715, 8952, -7824, -21069, -24835, -17455, -2279,
+	13893, 23874, 23236, 12290, -4064, -18613, -24962, -20338, -6805, 9676, 21931, 24635,
+	16636, 1448, -14344, -23950, -23245, -12561, 3473, 18011, 24871, 21151, 8462, -7776,
+	-20726, -24943, -18677, -4595, 11383, 22609, 24422, 16093, 1120, -14295, -23817, -23541,
+	-13605, 1869, 16566, 24515, 22501, 11366, -4331, -18271, -24859, -21467, -9482, 6256,
+	19495, 24984, 20566, 8020, -7657, -20315, -24997, -19889, -7019, 8553, 20796, 24975,
+	19494, 6501, -8961, -20979, -24964, -19413, -6476, 8890, 20881, 24977, 19652, 6942,
+	-8339, -20495, -24998, -20192, -7892, 7298, 19785, 24978, 20988, 9304, -5748, -18694,
+	-24839, -21966, -11143, 3670, 17149, 24469, 23020, 13345, -1055, -15063, -23730, -24005,
+	-15814, -2082, 12352, 22465, 24737, 18400, 5688, -8960, -20510, -24997, -20899, -9644,
+	4869, 17714, 24540, 23047, 13765, -127, -13955, -23105, -24529, -17775, -5124, 9193,
+	20466, 24989, 21292, 10611, -3505, -16464, -24067, -23861, -15935, -2887, 11058, 21454,
+	24985, 20543, 9566, -4409, -16978, -24189, -23787, -15922, -3093, 10668, 21109, 24999,
+	21155, 10783, -2870, -15627, -23603, -24378, -17740, -5732, 7974, 19270, 24771, 22842,
+	14084, 1152, -12093, -21753, -24984, -20852, -10592, 2734, 15244, 23314, 24612, 18785,
+	7538, -5839, -17531, -24206, -23972, -16920, -5080, 8159, 19092, 24658, 23309, 15448,
+	3300, -9731, -20063, -24854, -22801, -14489, -2234, 10597, 20545, 24920, 22556, 14112,
+	1899, -10790, -20597, -24918, -22622, -14341, -2298, 10316, 20223, 24843, 22988, 15163,
+	3428, -9154, -19377, -24628, -23579, -16523, -5276, 7266, 17965, 24142, 24259, 18312,
+	7799, -4611, -15863, -23198, -24820, -20352, -10902, 1171, 12935, 21565, 24985, 22388,
+	14422, 3024, -9055, -18979, -24408, -24073, -18079, -7845, 4181, 15216, 22719, 24961,
+	21443, 12995, 1593, -10136, -19555, -24537, -23970, -18006, -7996, 3761, 14662, 22303,
+	24999, 22171, 14467, 3603, -8005, -17863, -23843, -24662, -20163, -11329, -99, 11116,
+	19967, 24586, 24010, 18386, 8901, -2403, -13182, -21225, -24878, -23399, -17123, -7340,
+	3895, 14319, 21845, 24961, 23054, 16538, 6718, -4391, -14613, -21950, -24965, -23081,
+	-16698, -7061, 3899, 14085, 21560, 24898, 23473, 17586, 8357, -2409, -12694, -20598,
+	-24650, -24106, -19092, -10544, -85, 10353, 18897, 23998, 24738, 21001, 13489, 3567,
+	-6945, -16210, -22602, -24995, -22983, -16951, -7953, 2387, 12286, 20064, 24388, 24526,
+	20473, 12946, 3237, -6968, -15992, -22341, -24962, -23431, -18031, -9656, 270, 10116,
+	18313, 23539, 24955, 22349, 16176, 7414, -2480, -11957, -19549, -24067, -24812, -21683,
+	-15206, -6375, 3389, 12611, 19911, 24179, 24778, 21633, 15258, 6595, -3001, -12127,
+	-19464, -23937, -24897, -22217, -16330, -8073, 1303, 10455, 18115, 23202, 24999, 23267,
+	18272, 10728, 1711, -7495, -15663, -21680, -24725, -24394, -20740, -14315, -5956, 3145,
+	11797, 18889, 23489, 24996, 23227, 18426, 11249, 2630, -6269, -14355, -20618, -24264,
+	-24839, -22287, -16955, -9514, -919, 7735, 15434, 21252, 24481, 24737, 22004, 16638,
+	9288, 859, -7608, -15173, -20971, -24323, -24846, -22498, -17548, -10611, -2471, 5880,
+	13553, 19714, 23675, 24998, 23549, 19465, 13300, 5660, -2525, -10384, -17138, -22076,
+	-24669, -24649, -22042, -17094, -10399, -2619, 5344, 12736, 18844, 23046, 24917, 24277,
+	21224, 16024, 9273, 1603, -6103, -13192, -19035, -23067, -24893, -24348, -21542, -16607,
+	-10192, -2783, 4744, 11783, 17779, 22187, 24593, 24780, 22761, 18611, 12885, 5975,
+	-1383, -8505, -14902, -20055, -23504, -24946, -24268, -21613, -17013, -11084, -4181, 2960,
+	9788, 15839, 20632, 23764, 24980, 24191, 21535, 17088, 11362, 4720, -2218, -8936,
+	-14976, -19881, -23269, -24885, -24615, -22482, -18705, -13530, -7388, -716, 5866, 12011,
+	17343, 21469, 24081, 24994, 24156, 21455, 17466, 12157, 6109, -394, -7616, -14278,
+	-19527, -23120, -24965, -24996, -22876, -20727, -15930, -10898, -4732, 1264, 6396, 11302,
+	15963, 19971, 22936, 24600, 24843, 21371, 18807, 13675, 8552, 2442, -3023, -7950,
+	-12723, -17137, -20805, -23413, -24772, -24799, -23541, -20842, -20810, -22015, -16026, -12358,
+	-6433, -1334, 8126, 18339, 24476, 15806, 13790, 7262, 2820, -5854, -17514, -24887,
+	-15547, -14076, -7470, -3261, 4890, 17057, 24996, 15484, 14365, 7846, 3770, -3586,
+	-16209, -24991, -14902, -13847, -7373, -3447, 4078, 16489, 24812, 15517, 14153, 8275,
+	4227, -1903, -14873, -24984, -14105, -13185, -6941, -3251, 3954, 15975, 24015, 15248,
+	13496, 8193, 4208, -1229, -13769, -24162, -13123, -11750, -5983, -2432, 5049, 15778,
+	22539, 14842, 12690, 7914, 4018, -868, -11362, -20482, -24882, -20226, -19662, -21024,
+	-22646, -18804, -16335, -17787, -19993, -22048, -23632, -24623, -24973, -23212, -22463, -22973,
+	-20068, -17776, -14651, -11306, -7651, -3848, 37, 6584, 12948, 17234, 10670, 8224,
+	3969, 738, -10596, -23585, -11649, -10622, -6102, -3105, 1313, 10981, 18772, 10337,
+	8529, 4370, 1444, -4031, -10883, -15611, -8913, -9979, -4141, -2151, 6509, 25000
+},
+{
+	25000, 12517, -17949, -21612, 6667, 24999, 6391, -21655, -17734, 12349, 24218, 397,
+	-24008, -13069, 17098, 22117, -5370, -24965, -7907, 20754, 18973, -10618, -24649, -2588,
+	23259, 15085, -15141, -23239, 2598, 24641, 10739, -18819, -20950, 7429, 24991, 6196,
+	-21607, -18008, 11746, 24444, 1677, -23520, -14629, 15451, 23157, -2643, -24619, -11011,
+	18502, 21298, -6638, -24997, -7324, 20900, 19028, -10225, -24767, -3706, 22678, 16496,
+	-13359, -24047, -262, 23897, 13835, -16027, -22958, 2932, 24630, 11153, -18242, -21610,
+	5831, 24960, 8542, -20034, -20105, 8409, 24969, 6067, -21446, -18532, 10658, 24739,
+	3781, -22528, -16963, 12587, 24343, 1717, -23331, -15461, 14210, 23849, -102, -23908,
+	-14075, 15549, 23315, -1667, -24307, -12842, 16630, 22790, -2971, -24570, -11791, 17475,
+	22314, -4015, -24735, -10944, 18108, 21918, -4801, -24833, -10313, 18547, 21626, -5332,
+	-24884, -9910, 18806, 21454, -5613, -24906, -9740, 18893, 21412, -5643, -24904, -9805,
+	18814, 21501, -5425, -24879, -10105, 18563, 21716, -4956, -24821, -10634, 18133, 22047,
+	-4233, -24715, -11386, 17510, 22474, -3253, -24537, -12349, 16675, 22972, -2013, -24255,
+	-13503, 15606, 23505, -513, -23833, -14825, 14279, 24031, 1244, -23225, -16280, 12670,
+	24497, 3249, -22382, -17825, 10757, 24843, 5483, -21254, -19405, 8523, 24997, 7914,
+	-19787, -20951, 5961, 24885, 10498, -17933, -22381, 3077, 24422, 13169, -15650, -23599,
+	-104, 23527, 15845, -12911, -24498, -3538, 22119, 18421, -9707, -24962, -7150, 20128,
+	20769, -6054, -24871, -10836, 17502, 22744, -2002, -24108, -14461, 14219, 24188, 2357,
+	-22569, -17856, 10291, 24933, 6892, -20178, -20824, 5778, 24819, 11420, -16896, -23149,
+	800, 23703, 15714, -12741, -24605, -4461, 21481, 19509, -7797, -24978, -9761, 18109,
+	22512, -2231, -24084, -14789, 13620, 24430, 3703, -21800, -19190, 8148, 24987, 9665,
+	-18089, -22582, 1937, 23966, 15237, -13033, -24592, -4649, 21244, 19952, -6852, -24894,
+	-11141, 16832, 23328, 83, -23264, -16986, 10908, 24922, 7258, -19625, -21588, 3839,
+	24394, 14034, -14100, -24380, -3819, 21568, 19701, -7042, -24893, -11349, 16499, 23557,
+	959, -22843, -17920, 9521, 24998, 9101, -18212, -22689, 1259, 23627, 16428, -11315,
+	-24909, -7391, 19352, 21948, -2819, -24070, -15346, 12475, 24774, 6279, -20015, -21456,
+	3722, 24281, 14749, -13048, -24689, -5792, 20264, 21280, -3976, -24322, -14674, 13057,
+	24700, 5940, -20125, -21445, 3583, 24206, 15125, -12504, -24801, -6721, 19585, 21927,
+	-2538, -23898, -16075, 11364, 24937, 8116, -18589, -22661, 835, 23312, 17461, -9592,
+	-24998, -10086, 17050, 23528, 1524, -22320, -19176, 7137, 24826, 12554, -14857, -24355,
+	-4517, 20757, 21055, -3960, -24212, -15389, 11900, 24911, 8066, -18440, -22867, 61,
+	22912, 18385, -8093, -24908, -12019, 15194, 24303, 4485, -20666, -21245, 3416, 24016,
+	16118, -10892, -24988, -9491, 17238, 23571, 2041, -21897, -19981, 5509, 24497, 14619,
+	-12474, -24879, -8024, 18261, 23091, 815, -22413, -19362, 6373, 24640, 14074, -12950,
+	-24833, -7713, 18408, 23051, 825, -22359, -19509, 6037, 24559, 14542, -12360, -24912,
+	-8573, 17701, 23466, 2069, -21718, -20395, 4489, 24185, 15975, -10655, -24999, -10555,
+	16035, 24177, 4531, -20317, -21839, 1691, 23278, 18194, -7720, -24794, -13517, 13205,
+	24840, 8128, -17853, -23480, -2363, 21440, 20851, -3441, -23818, -17152, 8973, 24918,
+	12628, -13961, -24744, -7544, 18180, 23365, 2179, -21462, -20907, 3198, 23698, 17535,
+	-8341, -24838, -13447, 13032, 24891, 8858, -17094, -23908, -3984, 20390, 21986, -958,
+	-22829, -19248, 5773, 24362, 15846, -10286, -24983, -11941, 14350, 24721, 7699, -17848,
+	-23637, -3285, 20694, 21813, -1143, -22833, -19352, 5445, 24242, 16369, -9498, -24924,
+	-12986, 13199, 24904, 9323, -16466, -24230, -5499, 19239, 22961, 1626, -21479, -21170,
+	2195, 23166, 18937, -5874, -24298, -16346, 9338, 24891, 13480, -12524, -24971, -10422,
+	15387, 24575, 7248, -17892, -23747, -4032, 20018, 22537, 838, -21757, -21000, 2277,
+	23108, 19188, -5267, -24082, -17157, 8093, 24698, 14959, -10724, -24976, -12643, 13139,
+	24946, 10253, -15323, -24636, -7833, 17267, 24080, 5417, -18970, -23309, -3039, 20434,
+	22357, 724, -21666, -21256, 1503, 22678, 20036, -3628, -23483, -18727, 5637, 24096,
+	17356, -7520, -24536, -15947, 9272, 24821, 14521, -10890, -24968, -13098, 12374, 24996,
+	11696, -13725, -24924, -10328, 14948, 24768, 9007, -16048, -24544, -7745, 17030, 24269,
+	6548, -17901, -23958, -5425, 18668, 23622, 4382, -19340, -23275, -3421, 19923, 22927,
+	2547, -20424, -22588, -1762, 20851, 22268, 1068, -21211, -21972, -464, 21508, 21708,
+	-46, -21749, -21482, 465, 21938, 21297, -792, -22079, -21156, 1027, 22174, 21063,
+	-1170, -22226, -21019, 1221, 22235, 21025, -1180, -22202, -21080, 1046, 22126, 21184,
+	-821, -22006, -21335, 504, 21839, 21530, -95, -21621, -21765, -405, 21349, 22036,
+	998, -21018, -22338, -1682, 20622, 22663, 2456, -20155, -23003, -3319, 19611, 23352,
+	4268, -18981, -23697, -5301, 18258, 24028, 6413, -17436, -24332, -7600, 16506, 24597,
+	8854, -15461, -24807, -10168, 14295, 24947, 11530, -13002, -24999, -12930, 11578, 24947,
+	14352, -10019, -24772, -15780, 8325, 24455, 17194, -6499, -23978, -18572, 4543, 23323,
+	19891, -2467, -22474, -21123, 282, 21415, 22239, 1995, -20133, -23209, -4347, 18618,
+	24002, 6748, -16863, -24585, -9169, 14867, 24924, 11577, -12632, -24988, -13931, 10168,
+	24746, 16189, -7490, -24170, -18303, 4624, 23237, 20220, -1601, -21929, -21888, -1536,
+	20235, 23251, 4739, -18154, -24256, -7950, 15692, 24850, 11103, -12869, -24988, -14126,
+	9717, 24629, 16940, -6281, -23740, -19462, 2620, 22301, 21606, 1189, -20307, -23288,
+	-5060, 17769, 24432, 8894, -14718, -24967, -12580, 11203, 24835, 16002, -7294, -23995,
+	-19038, 3087, 22424, 21564, 1301, -20126, -23466, -5739, 17132, 24639, 10076, -13503,
+	-24997, -14152, 9329, 24477, 17801, -4734, -23048, -20856, -126, 20710, 23160, 5071,
+	-17508, -24576, -9899, 13528, 24994, 14396, -8900, -24343, -18345, 3796, 22593, 21533,
+	1567, -19769, -23767, -6946, 15952, 24889, 12074, -11284, -24786, -16676, 5962, 23403,
+	20482, -241, -20750, -23244, -5581, 16915, 24756, 11178, -12061, -24872, -16214, 6428,
+	23523, 20359, -322, -20721, -23311, -5890, 16580, 24830, 11814, -11311, -24754, -17047,
+	5214, 23019, 21199, 1323, -19674, -23933, -7855, 14889, 24992, 13908, -8956, -24231,
+	-19012, 2272, 21632, 22735, 4671, -17324, -24728, -11335, 11583, 24764, 17166, -4822,
+	-22764, -21648, -2425, 18819, 24340, 9552, -13198, -24943, -15925, 6337, 23326, 20941,
+	1181, -19553, -24082, -8677, 13902, 24982, 15432, -6850, -23477, -20761, -956, 19629,
+	24076, 8754, -13749, -24969, -15736, 6376, 23266, 21140, 1753, -19059, -24327, -9779,
+	12725, 24871, 16807, -4901, -22627, -22007, -3563, 17760, 24713, 11699, -10758, -24527,
+	-18527, 2393, 21381, 23173, 6348, -15568, -24988, -14383, 7739, 23660, 20664, 1162,
+	-19262, -24317, -9996, 12281, 24779, 17580, -3580, -21892, -22841, -5694, 15957, 24977,
+	14258, -7719, -23596, -20869, -1704, 18797, 24509, 10963, -11188, -24552, -18671, 1831,
+	20895, 23616, 7888, -13993, -24951, -16466, 4839, 22372, 22510, 5166, -16183, -24974,
+	-14418, 7298, 23361, 21368, 2876, -17829, -24783, -12648, 9218, 23987, 20326, 1062,
+	-19010, -24507, -11239, 10626, 24357, 19485, -256, -19796, -24248, -10242, 11551, 24555,
+	18916, -1073, -20243, -24075, -9689, 12019, 24637, 18659, -1389, -20386, -24027, -9595,
+	12046, 24630, 18734, -1205, -20236, -24116, -9963, 11631, 24532, 19135, -520, -19783,
+	-24321, -10782, 10762, 24310, 19834, 666, -18989, -24594, -12029, 9415, 23904, 20776,
+	2351, -17798, -24856, -13660, 7558, 23226, 21878, 4518, -16141, -24997, -15607, 5165,
+	22165, 23023, 7133, -13938, -24876, -17765, 2223, 20595, 24056, 10125, -11119, -24326,
+	-19990, -1251, 18383, 24786, 13378, -7634, -23160, -22083, -5192, 15409, 24985, 16716,
+	-3481, -21189, -23796, -9468, 11591, 24403, 19892, 1273, -18242, -24834, -13859, 6909,
+	22789, 22589, 6467, -14206, -24872, -18053, 1444, 19922, 24425, 11818, -9058, -23589,
+	-21638, -4583, 15663, 24986, 16914, -2921, -20719, -24126, -10797, 10012, 23877, 21223,
+	3899, -16112, -24997, -16650, 3163, 20792, 24121, 10881, -9823, -23781, -21447, -4435,
+	15606, 24974, 17297, -2175, -20158, -24412, -12063, 8481, 23256, 22256, 6175, -14084,
+	-24804, -18762, -52, 18686, 24823, 14245, -5915, -22089, -23426, -9047, 11394, 24193,
+	20804, 3509, -16125, -24989, -17195, 2050, 19924, 24545, 12864, -7352, -22683, -22987,
+	-8079, 12168, 24365, 20482, 3095, -16325, -24992, -17226, 1854, 19711, 24636, 13422,
+	-6575, -22262, -23403, -9270, 10905, 23964, 21425, 4954, -14730, -24843, -18847, -641,
+	17973, 24957, 15818, -3529, -20592, -24383, -12480, 7446, 22577, 23215, 8968, -11022,
+	-23945, -21557, -5398, 14202, 24735, 19511, 1870, -16954, -24999, -17179, 1532, 19266,
+	24799, 14653, -4747, -21142, -24203, -12020, 7725, 22602, 23280, 9352, -10437, -23677,
+	-22101, -6711, 12867, 24405, 20731, 4148, -15012, -24829, -19230, -1701, 16876, 24994,
+	17652, -598, -18472, -24943, -16044, 2730, 19817, 24721, 14450, -4681, -20935, -24368,
+	-12902, 6445, 21847, 23925, 11429, -8020, -22581, -23425, -10055, 9408, 23161, 22900,
+	8797, -10615, -23611, -22376, -7669, 11648, 23953, 21877, 6681, -12515, -24207, -21423,
+	-5841, 13224, 24392, 21029, 5153, -13783, -24520, -20709, -4623, 14197, 24606, 20472,
+	4251, -14473, -24656, -20325, -4040, 14614, 24678, 20271, 3990, -14621, -24673, -20313,
+	-4102, 14496, 24641, 20450, 4375, -14236, -24578, -20677, -4808, 13838, 24477, 20989,
+	5399, -13296, -24328, -21375, -6147, 12604, 24118, 21823, 7046, -11754, -23832, -22318,
+	-8090, 10739, 23450, 22841, 9271, -9551, -22952, -23367, -10578, 8182, 22315, 23872,
+	11993, -6627, -21514, -24323, -13498, 4884, 20524, 24687, 15068, -2955, -19321, -24926,
+	-16671, 844, 17882, 24998, 18270, 1435, -16186, -24860, -19824, -3865, 14215, 24467,
+	21280, 6417, -11960, -23775, -22584, -9053, 9418, 22740, 23672, 11722, -6599, -21324,
+	-24476, -14363, 3525, 19497, 24927, 16904, -232, -17236, -24955, -19261, -3225, 14535,
+	24495, 21343, 6780, -11401, -23486, -23051, -10342, 7866, 21882, 24279, 13803, -3984,
+	-19652, -24925, -17037, -162, 16789, 24893, 19907, 4465, -13315, -24103, -22269, -8788,
+	9282, 22495, 23976, 12969, -4784, -20040, -24884, -16823, -45, 16747, 24871, 20149,
+	5033, -12673, -23841, -22748, -9969, 7923, 21741, 24422, 14611, -2665, -18571, -24999,
+	-18694, -2877, 14396, 24347, 21950, 8433, -9349, -22391, -24124, -13688, 3644, 19132,
+	24992, 18299, 2424, -14658, -24389, -21923, -8505, 9154, 22237, 24244, 14193, -2909,
+	-18558, -24997, -19056, -3688, 13496, 24005, 22677, 10179, -7325, -21216, -24687, -16052,
+	446, 16717, 24806, 20783, 6623, -10759, -22892, -23894, -13295, 3752, 18971, 24999,
+	18942, 3737, -13264, -23861, -22972, -11040, 6193, 20443, 24891, 17425, 1627, -14940,
+	-24367, -22182, -9439, 7790, 21306, 24710, 16404, 333, -15886, -24591, -21694, -8574,
+	8579, 21684, 24603, 15979, -132, -16173, -24640, -21599, -8482, 8585, 21642, 24633,
+	16186, 229, -15824, -24542, -21913, -9166, 7808, 21170, 24785, 17007, 1419, -14811,
+	-24243, -22581, -10597, 6223, 20192, 24958, 18367, 3428, -13061, -23613, -23469, -12708,
+	3794, 18573, 24970, 20121, 6220, -10470, -22447, -24359, -15365, 501, 16134, 24556,
+	22033, 9701, -6942, -20489, -24941, -18340, -3622, 12691, 23385, 23764, 13674, -2433,
+	-17460, -24812, -21283, -8431, 8106, 21086, 24859, 17795, 2981, -13122, -23510, -23696,
+	-13612, 2364, 17308, 24766, 21540, 9033, -7359, -20573, -24950, -18626, -4324, 11822,
+	22901, 24204, 15189, -293, -15643, -24334, -22700, -11446, 4652, 18770, 24955, 20613,
+	7587, -8628, -21201, -24872, -18114, -3770, 12144, 22970, 24210, 15360, 116, -15167,
+	-24139, -23098, -12489, 3287, 17693, 24786, 21659, 9614, -6384, -19745, -24999, -20008,
+	-6827, 9140, 21360, 24866, 18243, 4198, -11546, -22589, -24475, -16452, -1776, 13609,
+	23490, 23908, 14705, -406, -15346, -24120, -23236, -13059, 2333, 16784, 24536, 22523,
+	11557, -3995, -17950, -24789, -21822, -10234, 5389, 18875, 24925, 21177, 9115, -6519,
+	-19584, -24984, -20623, -8216, 7390, 20104, 24999, 20188, 7549, -8010, -20455, -24995,
+	-19891, -7122, 8383, 20651, 24987, 19744, 6939, -8515, -20700, -24986, -19752, -7002,
+	8405, 20606, 24992, 19917, 7310, -8054, -20363, -24999, -20230, -7859, 7457, 19963,
+	24992, 20678, 8644, -6610, -19387, -24949, -21243, -9656, 5506, 18615, 24839, 21895,
+	10880, -4138, -17621, -24625, -22598, -12295, 2504, 16376, 24263, 23309, 13874, -602,
+	-14850, -23702, -23973, -15578, -1558, 13015, 22886, 24526, 17357, 3961, -10847, -21758,
+	-24894, -19146, -6574, 8333, 20261, 24994, 20865, 9349, -5471, -18343, -24740, -22422,
+	-12218, 2277, 15960, 24041, 23709, 15094, 1210, -13085, -22812, -24609, -17865, -4927,
+	9711, 20974, 24994, 20395, 8773, -5864, -18470, -24736, -22528, -12614, 1608, 15269,
+	23716, 24093, 16284, 2949, -11377, -21838, -24917, -19586, -7654, 6851, 19036, 24827,
+	22294, 12297, -1810, -15300, -23676, -24169, -16625, -3560, 10678, 21363, 24982, 20350,
+	9006, -5301, -17849, -24528, -23159, -14205, -603, 13184, 22656, 24747, 18787, 6724,
+	-7517, -19305, -24843, -22354, -12652, 1126, 14529, 23250, 24511, 17918, 5592, -8516,
+	-19889, -24922, -22024, -12127, 1617, 14836, 23347, 24480, 17889, 5660, -8345, -19709,
+	-24887, -22265, -12676, 873, 14138, 22983, 24677, 18703, 6926, -6993, -18731, -24677,
+	-23008, -14250, -1108, 12364, 22027, 24941, 20226, 9332, -4407, -16787, -24053, -24011,
+	-16687, -4307, 9367, 20195, 24931, 22158, 12721, -535, -13618, -22609, -24840, -19654,
+	-8609, 4997, 17100, 24121, 23989, 16757, 4572, -8956, -19826, -24860, -22587, -13687,
+	-775, 12350, 21853, 24980, 20830, 10621, -2671, -15173, -23271, -24638, -18891, -7696,
+	5710, 17457, 24188, 23983, 16914, 5010, -8317, -19255, -24712, -23147, -15014, -2628,
+	10492, 20630, 24950, 22244, 13282, 591, -12252, -21651, -24998, -21368, -11783, 1080,
+	13629, 22383, 24937, 20593, 10561, -2381, -14653, -22884, -24832, -19974, -9648, 3312,
+	15352, 23200, 24734, 19551, 9064, -3875, -15749, -23362, -24676, -19347, -8818, 4074,
+	15857, 23390, 24673, 19375, 8917, -3909, -15681, -23286, -24727, -19633, -9358, 3380,
+	15212, 23039, 24822, 20106, 10133, -2483, -14436, -22622, -24928, -20768, -11228, 1214,
+	13328, 21993, 24996, 21574, 12617, 426, -11860, -21101, -24961, -22465, -14259, -2432,
+	10000, 19883, 24744, 23362, 16097, 4783, -7723, -18273, -24250, -24165, -18052, -7442,
+	5014, 16205, 23374, 24756, 20021, 10347, -1873, -13617, -22006, -24999, -21875, -13406,
+	-1666, 10467, 20037, 24744, 23452, 16484, 5533, -6745, -17379, -23832, -24561, -19404,
+	-9603, 2489, 13969, 22113, 24999, 21952, 13704, 2213, -9788, -19463, -24557, -23878,
+	-17595, -7190, 4891, 15810, 23039, 24902, 20981, 12193, 581, -11150, -20292, -24758,
+	-23528, -16894, -6385, 5579, 16247, 23205, 24874, 20887, 12159, 675, -10947, -20080,
+	-24685, -23732, -17445, -7243, 4576, 15351, 22694, 24976, 21701, 13607, 2494, -9158,
+	-18768, -24238, -24366, -19137, -9706, 1849, 12981, 21267, 24915, 23140, 16338, 5992,
+	-5646, -16042, -22973, -24951, -21564, -13547, -2626, 8844, 18406, 24044, 24561, 19860,
+	10944, -287, -11441, -20165, -24642, -23936, -18205, -8658, 2696, 13467, 21422, 24916,
+	23235, 16736, 6771, -4587, -14978, -22279, -24997, -22586, -15549, -5332, 5967, 16027,
+	22826, 24985, 22081, 14709, 4366, -6849, -16663, -23129, -24952, -21780, -14256, -3888,
+	7245, 16915, 23230, 24939, 21718, 14211, 3904, -7161, -16798, -23144, -24958, -21901,
+	-14575, -4414, 6595, 16303, 22857, 24991, 22309, 15334, 5413, -5538, -15406, -22330,
+	-24991, -22896, -16453, -6888, 3974, 14064, 21496, 24877, 23585, 17871, 8811, -1893,
+	-12224, -20268, -24544, -24268, -19499, -11127, -702, 9834, 18546, 23858, 24798, 21207,
+	13747, 3783, -6856, -16229, -22665, -24999, -22825, -16543, -7288, 3269, 13219, 20801,
+	24669, 24146, 19336, 11097, 894, -9450, -18110, -23585, -24913, -21874, -15008, -5520,
+	4923, 14484, 21529, 24836, 23849, 18747, 10414, 291, -9863, -18312, -23631, -24913,
+	-21953, -15262, -5979, 4309, 13844, 21041, 24689, 24191, 19639, 11800, 1990, -8137,
+	-16890, -22840, -24998, -23023, -17249, -8632, 1402, 11184, 19123, 23934, 24839, 21702,
+	15039, 5935, -4122, -13488, -20677, -24532, -24451, -20455, -13188, -3816, 6153, 15121,
+	21691, 24818, 24027, 19450, 11813, 2320, -7522, -16166, -22290, -24932, -23701, -18795,
+	-10980, -1467, 8255, 16687, 22559, 24965, 23556, 18553, 10725, 1265, -8368, -16715,
+	-22540, -24958, -23624, -18746, -11059, -1717, 7863, 16252, 22230, 24901, 23891, 19357,
+	11971, 2823, -6725, -15265, -21578, -24733, -24294, -20330, -13423, -4573, 4927, 13694,
+	20492, 24343, 24715, 21562, 15339, 6934, -2449, -11462, -18848, -23573, -24982, -22887,
+	-17589, -9831, -701, 8504, 16510, 22231, 24869, 24081, 19980, 13136, 4490, -4760,
+	-13335, -20094, -24112, -24866, -22260, -16651, -8799, 235, 9215, 16947, 22416, 24893,
+	24063, 20045, 13375, 4936, -4144, -12652, -19499, -23784, -24968, -22901, -17860, -10500,
+	-1780, 7151, 15137, 21182, 24497, 24682, 21720, 15994, 8233, -570, -9279, -16802,
+	-22207, -24815, -24314, -20774, -14641, -6682, 2102, 10599, 17776, 22754, 24930, 24045,
+	20214, 13911, 5906, -2810, -11154, -18143, -22929, -24953, -23977, -20123, -13858, -5932,
+	2693, 10966, 17934, 22769, 24919, 24134, 20513, 14485, 6757, -1754, -10029, -17131,
+	-22241, -24780, -24461, -21329, -15748, -8359, -15, 8301, 15657, 21238, 24404, 24821,
+	22447, 17553, 10689, 2628, -5709, -13384, -19578, -23585, -24999, -23661, -19723, -13620,
+	-6021, 2227, 10200, 17060, 22061, 24683, 24642, 21952, 16906, 10045, 2107, -6029,
+	-13496, -19542, -23498, -24994, -23862, -20228, -14475, -7203, 815, 8714, 15698, 21056,
+	24238, 24930, 23067, 18846, 12699, 5253, -2716, -10376, -16986, -21869, -24564, -24791,
+	-22539, -18036, -11732, -4253, 3628, 11109, 17504, 22153, 24656, 24739, 22407, 17891,
+	11628, 4227, -3558, -10951, -17308, -21973, -24574, -24818, -22700, -18426, -12395, -5180,
+	2504, 9895, 16371, 21290, 24260, 24958, 23345, 19577, 13999, 7120, -406, -7846,
+	-14559, -19947, -23521, -24975, -24182, -21219, -16354, -10020, -2785, 4671, 11675, 17661,
+	22056, 24549, 24869, 23012, 19142, 13593, 6843, -494, -7724, -14280, -19605, -23249,
+	-24912, -24458, -21933, -17552, -11685, -4824, 2428, 9431, 15652, 20547, 23762, 24988,
+	24157, 21344, 16783, 10845, 4015, -3126, -9974, -16022, -20751, -23841, -24991, -24148,
+	-21385, -16925, -11118, -4423, 2606, 9389, 15440, 20260, 23529, 24940, 24429, 22039,
+	17960, 12504, 6087, -790, -7579, -13780, -18935, -22653, -24674, -24843, -23157, -19744,
+	-14857, -8851, -2180, 4609, 11015, 16636, 20990, 23888, 24981, 24277, 21832, 17827,
+	12550, 6378, -247, -6836, -12924, -18099, -21984, -24343, -24986, -23887, -21128, -16899,
+	-11485, -5256, 1321, 7735, 13626, 18563, 22272, 24423, 24966, 23841, 21128, 17013,
+	11770, 5745, -658, -6993, -12855, -17871, -21708, -24142, -24998, -24240, -21921, -18192,
+	-13287, -7511, -1248, 5039, 10968, 16227, 20410, 23398, 24816, 24738, 23151, 20166,
+	15988, 10903, 5229, -781, -6884, -12519, -17443, -21214, -23876, -24921, -24528, -22715,
+	-19605, -15419, -10457, -5026, 734, 6725, 12245, 17144, 20874, 23710, 24800, 24621,
+	23136, 20468, 16872, 12756, 8648, 4960, 1457, -3491, -9782, -14057, -20100, -20171,
+	-23601, -24291, -24356, -23587, -22116, -20382, -19364, -21131, -24997, -24015, -21736, -18255,
+	-13689, -8189, -2134, 3713, 9086, 14234, 18209, 22130, 23307, 24840, 24950, 23752,
+	21294, 17635, 12815, 6934, 629, -4971, -10163, -15033, -18818, -22404, -23595, -24877,
+	-24892, -23685, -21308, -17828, -13306, -7818, -1786, 3817, 8882, 13873, 17587, 21836,
+	22347, 24431, 24932, 24368, 22768, 20246, 17024, 13492, 10297, 8596, 13041, 17731,
+	19858, 24590, 22165, 17893, 11155, 2760, -3488, -7910, -13487, -15831, -23468, -17831,
+	-8288, 821, 5504, 10691, 14364, 19733, 19191, 22627, 23205, 24610, 24996, 24382,
+	22797, 20300, 16973, 12897, 8154, 2944, -2198, -6928, -11596, -15442, -19536, -20888,
+	-24981, -22512, -17740, -9638, -666, 4438, 8795, 13534, 16334, 22082, 18856, 14014,
+	7125, -11, -4704, -9217, -13395, -17095, -20186, -22578, -24165, -24939, -24846, -23897,
+	-22125, -19578, -16298, -12279, -7481, -2166, 2722, 6990, 11472, 14728, 19604, 18577,
+	21183, 23397, 24306, 24957, 24817, 23896, 22223, 19850, 16833, 13215, 8998, 4247,
+	-566, -4847, -9073, -12861, -16606, -18919, -23160, -20572, -16312, -9330, -1211, 3620,
+	7334, 11996, 13959, 22227, 14258, 2893, -3126, -6286, -11865, -12310, -24987, -11723,
+	564, 4288, 8657, 11654, 17090, 15190, 16135, 24844, 14277, 1221, -3641, -6938,
+	-11829, -12815, -24370, -11762, 349, 4053, 8115, 11285, 15808, 15613, 23783, 13990,
+	1465, -3414, -6496, -11429, -12066, -24851, -10813, 926, 4085, 8517, 10633, 18390,
+	12003, 2955, -2525, -5409, -10326, -11018, -24549, -10046, 1167, 4034, 8618, 10155,
+	20283, 10490, 171, -3538, -6940, -10497, -13128, -17669, -15404, -13932, -16902, -18694,
+	-22933, -18184, -8228, 649, 3716, 7543, 9928, 15625, 12107, 7157, 1381, -2590,
+	-5563, -9435, -11067, -19651, -10585, -478, 3168, 6148, 9812, 11516, 19390, 10863
+}
+};
@@ -0,0 +1,155 @@
+/***********************************************************
+*  tracker.c                                               *
+*                                                          *
+*  Alpha-beta range tracker, gate of the next ping         *
+*  (portable C)                                            *
+*                                                          *
+************************************************************/
+#include <math.h>
+#include "tracker.h"
+
+
+void tracker_reset(tracker_t *tr)
+{
+	tr->state = TRACK_SEARCH;
+	tr->misses = 0;
+	tr->rate_known = 0;
+	tr->gated = 0;
+	tr->peak_mean = 0;
+	tr->stat.pings = 0;
+	tr->stat.gated = 0;
+	tr->stat.hits = 0;
+	tr->stat.acquisitions = 0;
+	tr->stat.losses = 0;
+	tr->stat.lags = 0;
+	tr->stat.lags_full = 0;
+	tr->stat.cycles_full = 0;
+	tr->stat.cycles_saved = 0;
+}
+
+
+void tracker_gate(tracker_t *tr, double t, const range_gate_t *full, range_gate_t *gate)
+{
+	float dt, half, pred, coast;
+
+	tr->full = *full;
+	*gate = *full;
+	tr->gated = 0;
+	if(tr->state == TRACK_LOCKED)
+	{
+		dt = t - tr->t;
+		pred = tr->range + tr->rate*dt;
+		coast = tr->rate_known ? dt - tr->interval : dt;	// time the rate could not be checked
+		half = tr->sigmas*sqrt(tr->var) + tr->min_half_m + tr->max_speed*(coast > 0 ? coast : 0);
+		range_gate_set(gate, pred - half, pred + half);
+		gate->lag_lo = gate->lag_lo > full->lag_lo ? gate->lag_lo : full->lag_lo;
+		gate->lag_hi = gate->lag_hi < full->lag_hi ? gate->lag_hi : full->lag_hi;
+		if(gate->lag_lo < gate->lag_hi)
+		{
+			tr->gated = 1;
+		}
+		else
+		{
+			*gate = *full;						// predicted out of the full gate
+		}
+	}
+	tr->stat.pings++;
+	tr->stat.gated += tr->gated;
+	tr->stat.lags += gate->lag_hi - gate->lag_lo + 1;
+	tr->stat.lags_full += full->lag_hi - full->lag_lo + 1;
+}
+
+
+static short tracker_echo(const tracker_t *tr, const range_gate_t *gate, const engine_result_t *res)
+{
+	if(res->peak <= 0)
+	{
+		return 0;
+	}
+	if((res->used == ENGINE_FREQUENCY || res->used == ENGINE_INTEGRATE) && res->target_count == 0)
+	{
+		return 0;								// nothing above the CFAR threshold
+	}
+	if(res->peak < tr->min_peak*tr->peak_mean)
+	{
+		return 0;								// searching: weaker than the last track (noise of the time engines)
+	}
+	if(tr->gated && ((gate->lag_lo > tr->full.lag_lo && res->lag < gate->lag_lo + 1)
+	              || (gate->lag_hi < tr->full.lag_hi && res->lag > gate->lag_hi - 1)))
+	{
+		return 0;								// maximum on the edge: the echo is outside
+	}
+	return 1;
+}
+
+
+short tracker_update(tracker_t *tr, double t, const range_gate_t *gate, const engine_result_t *res)
+{
+	float dt, pred, innov;
+
+	if(!tracker_echo(tr, gate, res))
+	{
+		if(tr->state == TRACK_SEARCH)
+		{
+			tr->peak_mean -= tr->peak_mean*0.125f;	// a weaker echo starts a track after a while
+		}
+		else if(++tr->misses > tr->max_misses)
+		{
+			tr->state = TRACK_SEARCH;
+			tr->stat.losses++;
+		}
+		return 0;
+	}
+
+	tr->stat.hits += tr->gated;
+	tr->misses = 0;
+	if(tr->state == TRACK_SEARCH)
+	{
+		tr->state = TRACK_LOCKED;
+		tr->rate_known = 0;
+		tr->range = res->range;
+		tr->rate = 0;
+		tr->var = 0;
+		tr->peak_mean = res->peak;
+		tr->t = t;
+		tr->stat.acquisitions++;
+		return 1;
+	}
+
+	dt = t - tr->t;
+	if(dt <= 0)
+	{
+		return 1;								// same time: nothing to learn
+	}
+	if(!tr->rate_known)
+	{
+		tr->rate = (res->range - tr->range)/dt;		// two points
+		tr->range = res->range;
+		tr->rate_known = 1;
+	}
+	else
+	{
+		pred = tr->range + tr->rate*dt;
+		innov = res->range - pred;
+		tr->range = pred + tr->alpha*innov;
+		tr->rate += tr->beta*innov/dt;
+		tr->var += (innov*innov - tr->var)*0.125f;
+	}
+	tr->peak_mean += (res->peak - tr->peak_mean)*0.125f;
+	tr->interval = dt;
+	tr->t = t;
+	return 1;
+}
+
+
+void tracker_cycles(tracker_t *tr, float cycles)
+{
+	if(!tr->gated)
+	{
+		tr->stat.cycles_full += (cycles - tr->stat.cycles_full)*(tr->stat.cycles_full > 0 ? 0.125f : 1.0f);
+	}
+	else if(tr->stat.cycles_full > 0)
+	{
+		tr->stat.cycles_saved += tr->stat.cycles_full - cycles;
+	}
+}
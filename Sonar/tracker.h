@@ -0,0 +1,91 @@
+/***********************************************************
+*  tracker.h                                               *
+*                                                          *
+*  Range tracker of the strongest echo: alpha-beta filter  *
+*  on the ranges of engine_ping (after convert_step_       *
+*  distance). It predicts the range of the next ping and   *
+*  how far off it may be, and that window becomes the      *
+*  range gate of the next ping => the correlator searches  *
+*  a few dozen lags instead of the whole gate (time and    *
+*  coarse engines: only those lags are computed, ENGINE_   *
+*  AUTO falls to the time domain below auto_lags).         *
+*                                                          *
+*  TRACK_SEARCH  no track: the full gate is searched, the  *
+*                first echo starts a track                 *
+*  TRACK_LOCKED  the gate follows the prediction, half     *
+*                width sigmas x sd of the innovations +    *
+*                min_half_m (+ max_speed x time while the  *
+*                rate is unknown or the echo is missing).  *
+*                After max_misses pings without an echo in *
+*                the gate the track is dropped => search.  *
+*                                                          *
+*  An echo counts if the engine found one (CFAR engines:   *
+*  target_count > 0), its peak is at least min_peak x the  *
+*  mean peak of the track and it does not sit on an edge   *
+*  of a predicted gate (the maximum is then outside).      *
+*  The time engines always return a maximum, so a search  *
+*  keeps the mean peak of the lost track as its threshold, *
+*  decaying by 1/8 per ping => noise does not start a new  *
+*  track while the echo is away for a few pings.           *
+*                                                          *
+*  Portable C, state in tracker_t, no buffers.             *
+*                                                          *
+************************************************************/
+#ifndef TRACKER_H_
+#define TRACKER_H_
+
+#include "engine.h"
+
+#define TRACK_SEARCH 0
+#define TRACK_LOCKED 1
+
+typedef struct {
+	unsigned long pings;				// tracker_gate calls
+	unsigned long gated;				// of them with a predicted gate
+	unsigned long hits;					// predicted gates that held the echo
+	unsigned long acquisitions;			// tracks started
+	unsigned long losses;				// tracks dropped after max_misses
+	unsigned long lags;					// lags searched (sum of the gates)
+	unsigned long lags_full;			// lags of the full gates
+	float cycles_full;					// mean cycles of a ping with the full gate (tracker_cycles)
+	float cycles_saved;					// sum over the gated pings of cycles_full - their cycles
+} tracker_stat_t;
+
+typedef struct {
+	/* settings, set by the caller */
+	float alpha;						// range gain (0..1)
+	float beta;							// rate gain (0..alpha, about alpha^2/(2 - alpha))
+	float sigmas;						// gate half width in standard deviations of the innovation
+	float min_half_m;					// gate half width at least, metres
+	float max_speed;					// m/s: widens the gate while the rate is unknown / the echo missing
+	float min_peak;						// echo accepted down to this fraction of the mean peak of the track
+	short max_misses;					// pings without echo before the track is dropped
+
+	/* state */
+	short state;						// TRACK_SEARCH or TRACK_LOCKED
+	short misses;						// pings in a row without echo
+	short rate_known;					// 2 echoes at least
+	short gated;						// the last gate was predicted
+	range_gate_t full;					// last full gate (tracker_gate)
+	float range;						// m, filtered at t
+	float rate;							// m/s
+	double t;							// s, last echo (float runs out of digits after hours)
+	float interval;						// s between the last two echoes
+	float var;							// m^2, mean square innovation
+	float peak_mean;					// of the track, kept (decaying) while searching
+
+	tracker_stat_t stat;
+} tracker_t;
+
+void tracker_reset(tracker_t *tr);		// no track, statistics cleared (settings kept)
+
+/* gate of the ping at time t (seconds): the prediction within full, or full itself */
+void tracker_gate(tracker_t *tr, double t, const range_gate_t *full, range_gate_t *gate);
+
+/* result of that ping (gate as above), returns 1 if it extended or started the track */
+short tracker_update(tracker_t *tr, double t, const range_gate_t *gate, const engine_result_t *res);
+
+/* cost of that ping: full gates give the reference, predicted gates the saving */
+void tracker_cycles(tracker_t *tr, float cycles);
+
+#endif /*TRACKER_H_*/
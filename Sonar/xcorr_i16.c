@@ -0,0 +1,139 @@
+/***********************************************************
+*  xcorr_i16.c                                             *
+*                                                          *
+*  Time domain correlator on 16 bit samples                *
+*  (portable C, C67x intrinsics on the target, SSE2/AVX2   *
+*  pmaddwd on the host)                                    *
+*                                                          *
+************************************************************/
+#include "xcorr_i16.h"
+
+#if !defined(_TMS320C6X) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+
+void xcorr_i16_init(xcorr_i16_t *xc, const short *sweep)
+{
+	int i;
+
+	for(i=0;i<XCORR_TPL_LEN;i++)
+	{
+		xc->tpl[0][i] = i < SWEEP_LEN ? sweep[i] : 0;
+		xc->tpl[1][i] = i >= 1 && i <= SWEEP_LEN ? sweep[i-1] : 0;
+	}
+}
+
+
+xcorr_acc_t xcorr_i16_dot_c(const short *tpl, const short *x, int pairs)
+{
+	xcorr_acc_t acc = 0;
+	int i, p;
+
+	for(i=0;i<pairs;i++)
+	{
+		p = tpl[2*i]*x[2*i] + tpl[2*i+1]*x[2*i+1];
+		acc += p >> XCORR_PAIR_SHIFT;
+	}
+	return acc;
+}
+
+
+#if defined(_TMS320C6X)
+
+xcorr_acc_t xcorr_i16_dot(const short *tpl, const short *x, int pairs)
+{
+	const int *t = (const int *)tpl;			// 2 samples per word, lower half = even index
+	const int *m = (const int *)x;
+	xcorr_acc_t acc = 0;
+	int i;
+
+	_nassert((int)t % 8 == 0);
+	_nassert((int)m % 4 == 0);
+	#pragma MUST_ITERATE(8,,8)
+	for(i=0;i<pairs;i++)
+	{
+#ifdef _TMS320C6400
+		acc += _dotp2(t[i], m[i]) >> XCORR_PAIR_SHIFT;
+#else
+		acc += (_mpy(t[i], m[i]) + _mpyh(t[i], m[i])) >> XCORR_PAIR_SHIFT;		// C67x: no DOTP2
+#endif
+	}
+	return acc;
+}
+
+#elif defined(__AVX2__) && defined(__x86_64__)
+
+xcorr_acc_t xcorr_i16_dot(const short *tpl, const short *x, int pairs)
+{
+	__m256i acc = _mm256_setzero_si256();
+	__m128i s;
+	int i;
+
+	for(i=0;i<2*pairs;i+=16)
+	{
+		__m256i p = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(tpl+i)),
+		                              _mm256_loadu_si256((const __m256i *)(x+i)));
+		p = _mm256_srai_epi32(p, XCORR_PAIR_SHIFT);
+		acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(p)));
+		acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(p, 1)));
+	}
+	s = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+	s = _mm_add_epi64(s, _mm_unpackhi_epi64(s, s));
+	return _mm_cvtsi128_si64(s);
+}
+
+#elif defined(__SSE2__) && defined(__x86_64__)
+
+xcorr_acc_t xcorr_i16_dot(const short *tpl, const short *x, int pairs)
+{
+	__m128i acc = _mm_setzero_si128();
+	int i;
+
+	for(i=0;i<2*pairs;i+=8)
+	{
+		__m128i p = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(tpl+i)),
+		                           _mm_loadu_si128((const __m128i *)(x+i)));
+		__m128i sign;
+
+		p = _mm_srai_epi32(p, XCORR_PAIR_SHIFT);
+		sign = _mm_srai_epi32(p, 31);				// sign extension to 64 bit (no pmovsx in SSE2)
+		acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(p, sign));
+		acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(p, sign));
+	}
+	acc = _mm_add_epi64(acc, _mm_unpackhi_epi64(acc, acc));
+	return _mm_cvtsi128_si64(acc);
+}
+
+#else
+
+xcorr_acc_t xcorr_i16_dot(const short *tpl, const short *x, int pairs)
+{
+	return xcorr_i16_dot_c(tpl, x, pairs);
+}
+
+#endif
+
+
+short xcorr_i16_peak(const xcorr_i16_t *xc, const short *mono, short lag_lo, short lag_hi, xcorr_acc_t *peak)
+{
+	xcorr_acc_t r, r_max = 0;
+	short k, max_index = lag_lo;
+
+	for(k=lag_lo;k<=lag_hi;k++)
+	{
+		/* odd lag: delayed template against the response from k-1 => aligned pairs */
+		r = xcorr_i16_dot(xc->tpl[k & 1], mono + (k & ~1), XCORR_TPL_LEN/2);
+
+		if(r > r_max)
+		{
+			r_max = r;
+			max_index = k;
+		}
+	}
+	if(peak)
+	{
+		*peak = r_max;
+	}
+	return max_index;
+}
@@ -0,0 +1,51 @@
+/***********************************************************
+*  xcorr_i16.h                                             *
+*                                                          *
+*  Time domain correlator on 16 bit samples: packed pairs  *
+*  of products (DOTP2 style), 40/64 bit accumulator        *
+*                                                          *
+*  r[k] = sum_j sweep[j] mono[j+k]                         *
+*                                                          *
+*  The two products of a pair are summed in 32 bit and     *
+*  shifted right by XCORR_PAIR_SHIFT before they go to the *
+*  accumulator, so a full scale sweep x full scale echo    *
+*  fits the 40 bit long of the C6000 (2^39 > 2880/2 x      *
+*  2 x 25000 x 32768 / 8). Every implementation groups the *
+*  pairs the same way => all of them give the same r[k].   *
+*                                                          *
+*  Pairs are read as aligned 32 bit words: the template is *
+*  kept twice, once as is for the even lags and once       *
+*  delayed by one sample for the odd lags, so the response *
+*  is always read from an even index.                      *
+*                                                          *
+************************************************************/
+#ifndef XCORR_I16_H_
+#define XCORR_I16_H_
+
+#include "sonar_params.h"
+
+#define XCORR_PAIR_SHIFT 3
+#define XCORR_TPL_LEN ((SWEEP_LEN + 2 + 15) & ~15)		// sweep + 1 sample delay, padded to 16 samples (2896)
+#define XCORR_MONO_LEN (RESPONSE_MONO + XCORR_TPL_LEN)	// mono response + zero tail read by the last lags
+
+#ifdef _TMS320C6X
+typedef long xcorr_acc_t;				// 40 bit
+#else
+typedef long long xcorr_acc_t;
+#endif
+
+typedef struct {
+	short tpl[2][XCORR_TPL_LEN];		// [0] sweep, [1] 0 + sweep, both zero padded (8 byte aligned)
+} xcorr_i16_t;
+
+void xcorr_i16_init(xcorr_i16_t *xc, const short *sweep);
+
+/* one lag: tpl and x 4 byte aligned, pairs = number of sample pairs (multiple of 8 for the host versions) */
+xcorr_acc_t xcorr_i16_dot(const short *tpl, const short *x, int pairs);		// best version of the build
+xcorr_acc_t xcorr_i16_dot_c(const short *tpl, const short *x, int pairs);	// portable reference
+
+/* r[k] for lag_lo <= k <= lag_hi < RESPONSE_MONO, mono holds XCORR_MONO_LEN samples (zero tail).
+   Returns the first lag of the maximum (lag_lo if no r[k] > 0), the maximum in *peak if not NULL */
+short xcorr_i16_peak(const xcorr_i16_t *xc, const short *mono, short lag_lo, short lag_hi, xcorr_acc_t *peak);
+
+#endif /*XCORR_I16_H_*/